@@ -1,4 +1,8 @@
 ﻿using Gauntlet;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
 
 namespace DaedalicTestAutomationPlugin.Automation
 {
@@ -12,15 +16,162 @@ namespace DaedalicTestAutomationPlugin.Automation
         {
             DaeTestConfig Config = base.GetConfiguration();
 
-            // Start a single instance of the game.
-            UnrealTestRole ClientRole = Config.RequireRole(UnrealTargetRole.Client);
-            Config.MaxDuration = 3 * 60 * 60; // Timeout calculation: Hours * Minutes * Seconds
-            ClientRole.Controllers.Add("DaeGauntletTestController");
+            // Start a single instance of the game, one instance per shard, or a coordinator with its workers.
+            int NumClients = Config.RunsAllShards() ? Config.ShardCount : 1;
+
+            if (Config.UsesWorkers())
+            {
+                NumClients = Config.Workers + 1;
+            }
+
+            IEnumerable<UnrealTestRole> ClientRoles = Config.RequireRoles(UnrealTargetRole.Client, NumClients);
+
+            // Shards keep writing the duration history while running, so all of them have to read the same snapshot to agree on their test maps.
+            string HistorySnapshotPath = Config.RunsAllShards() ? SnapshotDurationHistory(Config) : null;
+
+            int Shard = 0;
+
+            foreach (UnrealTestRole ClientRole in ClientRoles)
+            {
+                ClientRole.Controllers.Add("DaeGauntletTestController");
+
+                if (Config.UsesWorkers())
+                {
+                    if (Shard == 0)
+                    {
+                        // Coordinator only hands out test maps and writes reports, without rendering anything.
+                        ClientRole.CommandLine += $" -TestCoordinator -TestCoordinatorPort={Config.CoordinatorPort} -nullrhi -nosound";
+                    }
+                    else
+                    {
+                        ClientRole.CommandLine += $" -TestWorker -TestCoordinatorPort={Config.CoordinatorPort}";
+                    }
+                }
+                else if (Config.RunsAllShards())
+                {
+                    // Each shard writes its own set of reports.
+                    ClientRole.CommandLine += $" -ShardIndex={Shard} -ShardCount={Config.ShardCount}";
+
+                    if (!string.IsNullOrEmpty(HistorySnapshotPath))
+                    {
+                        ClientRole.CommandLine += $" -TestDurationHistorySnapshotPath=\"{HistorySnapshotPath}\"";
+                    }
+
+                    if (!string.IsNullOrEmpty(Config.JUnitReportPath))
+                    {
+                        ClientRole.CommandLine += $" -JUnitReportPath=\"{Config.GetShardJUnitReportPath(Shard)}\"";
+                    }
+
+                    if (!string.IsNullOrEmpty(Config.ReportPath))
+                    {
+                        ClientRole.CommandLine += $" -ReportPath=\"{Config.GetShardReportPath(Shard)}\"";
+                    }
+                }
+
+                ++Shard;
+            }
+
+            Config.MaxDuration = EstimateMaxDuration(Config);
 
             // Ignore user account management.
             Config.NoMCP = true;
 
             return Config;
         }
+
+        /// <summary>
+        /// Estimates how long the test run is allowed to take, in seconds, based on the durations of previous runs.
+        /// The history might only cover some of the maps (e.g. if it has been written by a filtered run), and maps without
+        /// history aren't known here, so it's only used for raising the default limit, never for lowering it.
+        /// </summary>
+        private int EstimateMaxDuration(DaeTestConfig Config)
+        {
+            const int DefaultMaxDuration = 3 * 60 * 60; // Timeout calculation: Hours * Minutes * Seconds
+            const int StartupDuration = 10 * 60;
+            const float SafetyFactor = 2.0f;
+
+            string HistoryPath = GetDurationHistoryPath(Config);
+
+            if (string.IsNullOrEmpty(HistoryPath) || !File.Exists(HistoryPath))
+            {
+                return DefaultMaxDuration;
+            }
+
+            float TotalDuration = 0.0f;
+            float LongestDuration = 0.0f;
+
+            foreach (string Line in File.ReadAllLines(HistoryPath))
+            {
+                string[] Tokens = Line.Split('=');
+
+                if (Tokens.Length == 2 && float.TryParse(Tokens[1], NumberStyles.Float, CultureInfo.InvariantCulture, out float Duration))
+                {
+                    TotalDuration += Duration;
+                    LongestDuration = Math.Max(LongestDuration, Duration);
+                }
+            }
+
+            if (TotalDuration <= 0.0f)
+            {
+                return DefaultMaxDuration;
+            }
+
+            // Assigning longest maps first, no shard takes longer than the average shard plus the longest map.
+            int NumParallelRuns = Config.UsesWorkers() ? Config.Workers : Config.ShardCount;
+            float ShardDuration = TotalDuration / Math.Max(NumParallelRuns, 1) + LongestDuration;
+            int MaxDuration = Math.Max((int)(ShardDuration * SafetyFactor) + StartupDuration, DefaultMaxDuration);
+
+            Log.Info("Estimated max duration of {0} seconds based on {1}", MaxDuration, HistoryPath);
+
+            return MaxDuration;
+        }
+
+        /// <summary>
+        /// Gets the path of the duration history the clients read from and write to, or null if unknown.
+        /// </summary>
+        private string GetDurationHistoryPath(DaeTestConfig Config)
+        {
+            if (!string.IsNullOrEmpty(Config.TestDurationHistoryPath))
+            {
+                return Config.TestDurationHistoryPath;
+            }
+
+            if (Context.Options.ProjectPath != null)
+            {
+                return Path.Combine(Context.Options.ProjectPath.Directory.FullName, "Saved",
+                    "DaedalicTestAutomationPlugin", "TestDurationHistory.txt");
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        /// Copies the current duration history for all shards of this run to read from, and returns the path of the copy, or null if there's no history.
+        /// </summary>
+        private string SnapshotDurationHistory(DaeTestConfig Config)
+        {
+            string HistoryPath = GetDurationHistoryPath(Config);
+
+            if (string.IsNullOrEmpty(HistoryPath) || !File.Exists(HistoryPath))
+            {
+                return null;
+            }
+
+            string SnapshotPath = Path.ChangeExtension(HistoryPath, ".Snapshot.txt");
+
+            try
+            {
+                File.Copy(HistoryPath, SnapshotPath, true);
+            }
+            catch (IOException Exception)
+            {
+                Log.Warning("Unable to snapshot duration history {0}: {1}", HistoryPath, Exception.Message);
+                return null;
+            }
+
+            Log.Info("Shards read duration history from snapshot {0}", SnapshotPath);
+
+            return SnapshotPath;
+        }
     }
 }
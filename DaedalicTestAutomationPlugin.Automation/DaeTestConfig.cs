@@ -1,5 +1,6 @@
 ﻿using Gauntlet;
 using System.Collections.Generic;
+using System.IO;
 
 namespace DaedalicTestAutomationPlugin.Automation
 {
@@ -37,16 +38,151 @@ namespace DaedalicTestAutomationPlugin.Automation
         [AutoParam]
         public string TestPriority;
 
+        /// <summary>
+        /// Expression for selecting the tests to run, e.g. tag:Smoke&amp;&amp;!name:*Slow*
+        /// Combined with TestName, TestTags and TestPriority, if specified.
+        /// </summary>
+        [AutoParam]
+        public string TestFilter;
+
+        /// <summary>
+        /// File with one changed package or file per line (e.g. output of git diff --name-only), or list of them separated by semicolons.
+        /// Runs only tests that depend on any of them. Changes to anything but assets select all tests.
+        /// </summary>
+        [AutoParam]
+        public string ChangedPackages;
+
+        /// <summary>
+        /// Logs which tests would be run, without running them.
+        /// </summary>
+        [AutoParam(false)]
+        public bool TestDryRun;
+
+        /// <summary>
+        /// Long package name of an otherwise empty map to stream test maps into as sublevels, instead of traveling to each of them.
+        /// Test maps that require full travel are still loaded as their own world.
+        /// </summary>
+        [AutoParam]
+        public string StreamingPersistentMap;
+
+        /// <summary>
+        /// Runs the game without rendering and audio (e.g. on machines without GPU).
+        /// Performance budget tests only check their game thread budget then, without taking screenshots.
+        /// </summary>
+        [AutoParam(false)]
+        public bool Headless;
+
+        /// <summary>
+        /// Continues a previous run that has crashed, skipping all test maps that have finished before,
+        /// and failing the test map the previous run crashed in.
+        /// </summary>
+        [AutoParam(false)]
+        public bool Resume;
+
+        /// <summary>
+        /// Splits the discovered test maps into this many shards, running one game client per shard.
+        /// </summary>
+        [AutoParam(1)]
+        public int ShardCount;
+
+        /// <summary>
+        /// Which single shard to run (0-based), instead of running all shards at once.
+        /// Useful for distributing shards across multiple machines.
+        /// </summary>
+        [AutoParam(-1)]
+        public int ShardIndex;
+
+        /// <summary>
+        /// Where to read and write durations of previous test map runs from and to.
+        /// Defaults to Saved/DaedalicTestAutomationPlugin/TestDurationHistory.txt in the project folder.
+        /// Shards are only balanced by duration if this is specified, as all shards need to share the same history.
+        /// </summary>
+        [AutoParam]
+        public string TestDurationHistoryPath;
+
+        /// <summary>
+        /// Reports passing results of previous runs again, instead of running test maps that haven't changed since.
+        /// </summary>
+        [AutoParam(false)]
+        public bool ResultCache;
+
+        /// <summary>
+        /// Folder to read and write cached test map results from and to. Implies ResultCache.
+        /// Defaults to Saved/DaedalicTestAutomationPlugin/TestResultCache in the project folder.
+        /// </summary>
+        [AutoParam]
+        public string ResultCachePath;
+
+        /// <summary>
+        /// Stores frame times of all performance tests as new baselines, instead of comparing them with the previous ones.
+        /// </summary>
+        [AutoParam(false)]
+        public bool UpdatePerformanceBaseline;
+
+        /// <summary>
+        /// Folder to read and write performance test baselines from and to.
+        /// Defaults to Saved/DaedalicTestAutomationPlugin/PerformanceBaselines in the project folder.
+        /// </summary>
+        [AutoParam]
+        public string PerformanceBaselinePath;
+
+        /// <summary>
+        /// Number of local worker processes that pull test maps from a coordinator process as soon as they're idle.
+        /// Takes precedence over ShardCount and ShardIndex.
+        /// </summary>
+        [AutoParam(0)]
+        public int Workers;
+
+        /// <summary>
+        /// Local port the coordinator listens for workers on.
+        /// </summary>
+        [AutoParam(17890)]
+        public int CoordinatorPort;
+
+        /// <summary>
+        /// Whether to start a coordinator and multiple workers on this machine.
+        /// </summary>
+        public bool UsesWorkers()
+        {
+            return Workers > 0;
+        }
+
+        /// <summary>
+        /// Whether to start one game client for each shard on this machine.
+        /// </summary>
+        public bool RunsAllShards()
+        {
+            return !UsesWorkers() && ShardCount > 1 && ShardIndex < 0;
+        }
+
+        /// <summary>
+        /// Gets the file path to write the JUnit XML report of the specified shard to.
+        /// </summary>
+        public string GetShardJUnitReportPath(int Shard)
+        {
+            string FileName = $"{Path.GetFileNameWithoutExtension(JUnitReportPath)}.Shard{Shard}{Path.GetExtension(JUnitReportPath)}";
+            return Path.Combine(Path.GetDirectoryName(JUnitReportPath), FileName);
+        }
+
+        /// <summary>
+        /// Gets the folder to write test reports of the specified shard to.
+        /// </summary>
+        public string GetShardReportPath(int Shard)
+        {
+            return Path.Combine(ReportPath, $"Shard{Shard}");
+        }
+
         public override void ApplyToConfig(UnrealAppConfig AppConfig, UnrealSessionRole ConfigRole, IEnumerable<UnrealSessionRole> OtherRoles)
         {
             base.ApplyToConfig(AppConfig, ConfigRole, OtherRoles);
 
-            if (!string.IsNullOrEmpty(JUnitReportPath))
+            // Report paths of local shards are added per client role, see DaeGauntletTest.
+            if (!string.IsNullOrEmpty(JUnitReportPath) && !RunsAllShards())
             {
                 AppConfig.CommandLine += $" -JUnitReportPath=\"{JUnitReportPath}\"";
             }
 
-            if (!string.IsNullOrEmpty(ReportPath))
+            if (!string.IsNullOrEmpty(ReportPath) && !RunsAllShards())
             {
                 AppConfig.CommandLine += $" -ReportPath=\"{ReportPath}\"";
             }
@@ -65,6 +201,65 @@ namespace DaedalicTestAutomationPlugin.Automation
             {
                 AppConfig.CommandLine += $" -TestPriority=\"{TestPriority}\"";
             }
+
+            if (!string.IsNullOrEmpty(TestFilter))
+            {
+                AppConfig.CommandLine += $" -TestFilter=\"{TestFilter}\"";
+            }
+
+            if (!string.IsNullOrEmpty(ChangedPackages))
+            {
+                AppConfig.CommandLine += $" -ChangedPackages=\"{ChangedPackages}\"";
+            }
+
+            if (TestDryRun)
+            {
+                AppConfig.CommandLine += " -TestDryRun";
+            }
+
+            if (!string.IsNullOrEmpty(StreamingPersistentMap))
+            {
+                AppConfig.CommandLine += $" -TestStreamingPersistentMap=\"{StreamingPersistentMap}\"";
+            }
+
+            if (Headless)
+            {
+                AppConfig.CommandLine += " -nullrhi -nosound";
+            }
+
+            if (Resume)
+            {
+                AppConfig.CommandLine += " -Resume";
+            }
+
+            if (!string.IsNullOrEmpty(TestDurationHistoryPath))
+            {
+                AppConfig.CommandLine += $" -TestDurationHistoryPath=\"{TestDurationHistoryPath}\"";
+            }
+
+            if (!string.IsNullOrEmpty(ResultCachePath))
+            {
+                AppConfig.CommandLine += $" -TestResultCachePath=\"{ResultCachePath}\"";
+            }
+            else if (ResultCache)
+            {
+                AppConfig.CommandLine += " -TestResultCache";
+            }
+
+            if (UpdatePerformanceBaseline)
+            {
+                AppConfig.CommandLine += " -UpdatePerformanceBaseline";
+            }
+
+            if (!string.IsNullOrEmpty(PerformanceBaselinePath))
+            {
+                AppConfig.CommandLine += $" -PerformanceBaselinePath=\"{PerformanceBaselinePath}\"";
+            }
+
+            if (!UsesWorkers() && ShardCount > 1 && ShardIndex >= 0)
+            {
+                AppConfig.CommandLine += $" -ShardIndex={ShardIndex} -ShardCount={ShardCount}";
+            }
         }
     }
 }
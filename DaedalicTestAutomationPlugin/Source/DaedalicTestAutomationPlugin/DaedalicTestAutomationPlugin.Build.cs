@@ -32,7 +32,11 @@ namespace UnrealBuildTool.Rules
                     "SlateCore",
                     "Slate",
                     "RenderCore",
-                    "Projects"
+                    "RHI",
+                    "Projects",
+                    "Json",
+                    "Sockets",
+                    "Networking"
                 }
 				);
 
@@ -1,6 +1,9 @@
 #include "DaeGauntletStates.h"
 
 FName FDaeGauntletStates::LoadingNextMap = TEXT("Gauntlet_LoadingNextMap");
+FName FDaeGauntletStates::StreamingNextMap = TEXT("Gauntlet_StreamingNextMap");
 FName FDaeGauntletStates::DiscoveringTests = TEXT("Gauntlet_DiscoveringTests");
 FName FDaeGauntletStates::Running = TEXT("Gauntlet_Running");
 FName FDaeGauntletStates::Finished = TEXT("Gauntlet_Finished");
+FName FDaeGauntletStates::WaitingForRequest = TEXT("Gauntlet_WaitingForRequest");
+FName FDaeGauntletStates::WaitingForTestMap = TEXT("Gauntlet_WaitingForTestMap");
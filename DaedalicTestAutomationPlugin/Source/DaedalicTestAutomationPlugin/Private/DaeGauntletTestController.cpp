@@ -1,14 +1,38 @@
 #include "DaeGauntletTestController.h"
 #include "DaeGauntletStates.h"
+#include "DaeTestCoordinator.h"
 #include "DaeTestLogCategory.h"
+#include "DaeTestMapDiscovery.h"
+#include "DaeTestMessageChannel.h"
+#include "DaeTestPackageDependencies.h"
+#include "DaeTestPerformanceBudgetActor.h"
 #include "DaeTestReportWriter.h"
+#include "DaeTestReportWriterJUnit.h"
+#include "DaeTestReportWriterQueue.h"
 #include "DaeTestReportWriterSet.h"
+#include "DaeTestResultCache.h"
+#include "DaeTestSelection.h"
+#include "DaeTestServer.h"
 #include "DaeTestSuiteActor.h"
+#include "DaeTestTransientWorld.h"
+#include "DaeTestWatchdog.h"
+#include "DaeUEFeatures.h"
 #include "Settings/DaeTestAutomationPluginSettings.h"
 #include <AssetRegistryModule.h>
 #include <EngineUtils.h>
 #include <Engine/AssetManager.h>
+#include <Engine/Engine.h>
+#include <Engine/LevelStreamingDynamic.h>
+#include <HAL/PlatformMemory.h>
+#include <Misc/App.h>
+#include <Misc/FileHelper.h>
+#include <Misc/PackageName.h>
+#include <Misc/Paths.h>
+#include <RHI.h>
 #include <Kismet/GameplayStatics.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+#include <UObject/UObjectHash.h>
 
 void UDaeGauntletTestController::OnInit()
 {
@@ -21,41 +45,168 @@ void UDaeGauntletTestController::OnInit()
     // Execute console commands.
     for (auto& ConsoleCommand : TestAutomationPluginSettings->ConsoleCommands)
     {
+        // Stats are drawn to the viewport, which doesn't exist when running headless.
+        if (GUsingNullRHI && ConsoleCommand.StartsWith(TEXT("stat ")))
+        {
+            UE_LOG(LogDaeTest, Log,
+                   TEXT("UDaeGauntletTestController: Skipped console command %s, as rendering is "
+                        "disabled"),
+                   *ConsoleCommand);
+            continue;
+        }
+
         GEngine->Exec(GetWorld(), *ConsoleCommand);
         UE_LOG(LogDaeTest, Log, TEXT("UDaeGauntletTestController: Executed console command %s"),
                *ConsoleCommand);
     }
 
-    for (const FString& TestMapFolder : TestAutomationPluginSettings->TestMapFolders)
+    // Gather command line options.
+    FString TestFilter;
+    FParse::Value(FCommandLine::Get(), TEXT("TestFilter="), TestFilter);
+
+    const bool bDryRun = FParse::Param(FCommandLine::Get(), TEXT("TestDryRun"));
+    ReportPath = ParseCommandLineOption(TEXT("ReportPath"));
+    StreamingPersistentMap = ParseCommandLineOption(TEXT("TestStreamingPersistentMap"));
+
+    const bool bIsSelectionValid =
+        CompileSelection(TestFilter, ParseCommandLineOption(TEXT("TestName")),
+                         ParseCommandLineOption(TEXT("TestTags")),
+                         ParseCommandLineOption(TEXT("TestPriority")));
+
+    ParseChangedPackages(ParseCommandLineOption(TEXT("ChangedPackages")));
+
+    // Resolve persistent world once, for telling whether we are already there by its package name.
+    if (!StreamingPersistentMap.IsEmpty())
     {
-        UE_LOG(LogDaeTest, Display, TEXT("Discovering tests from: %s"), *TestMapFolder);
+        FString StreamingPersistentPackageName;
+
+        if (!FPackageName::SearchForPackageOnDisk(StreamingPersistentMap,
+                                                  &StreamingPersistentPackageName))
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("UDaeGauntletTestController::OnInit - Persistent map %s for streaming test "
+                        "maps not found."),
+                   *StreamingPersistentMap);
+
+            GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+            EndTest(1);
+            return;
+        }
+
+        StreamingPersistentMap = StreamingPersistentPackageName;
     }
 
-    // Build list of tests (based on FAutomationEditorCommonUtils::CollectTestsByClass).
-    FAssetRegistryModule& AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-    TArray<FAssetData> AssetDataArray;
+    // Check if this is part of a distributed run.
+    bIsWorker = FParse::Param(FCommandLine::Get(), TEXT("TestWorker"));
+    const bool bIsCoordinator = FParse::Param(FCommandLine::Get(), TEXT("TestCoordinator"));
+
+    CoordinatorPort = FDaeTestCoordinator::DefaultPort;
+    FParse::Value(FCommandLine::Get(), TEXT("TestCoordinatorPort="), CoordinatorPort);
+
+    // Load durations of previous runs. Other shards keep writing the history while running, so shards
+    // started at different times might see different durations. Thus, all shards read from the same
+    // snapshot taken when starting the run, if any.
+    DurationHistoryPath = ParseCommandLineOption(TEXT("TestDurationHistoryPath"));
+    const FString DurationHistorySnapshotPath =
+        ParseCommandLineOption(TEXT("TestDurationHistorySnapshotPath"));
+    bHasSharedDurationHistory =
+        !DurationHistoryPath.IsEmpty() || !DurationHistorySnapshotPath.IsEmpty();
+
+    if (DurationHistoryPath.IsEmpty())
+    {
+        DurationHistoryPath = FDaeTestDurationHistory::GetDefaultFilePath();
+    }
 
-    AssetRegistryModule.Get().SearchAllAssets(true);
-    AssetRegistryModule.Get().GetAssetsByClass(UWorld::StaticClass()->GetFName(), AssetDataArray);
+    DurationHistory.Load(DurationHistorySnapshotPath.IsEmpty() ? DurationHistoryPath
+                                                               : DurationHistorySnapshotPath);
 
-    for (auto ObjIter = AssetDataArray.CreateConstIterator(); ObjIter; ++ObjIter)
+    if (bIsWorker)
+    {
+        // Workers receive their test maps from the coordinator, one at a time. Connect while
+        // ticking, as the coordinator might still be starting up.
+        CoordinatorConnectStartTime = FPlatformTime::Seconds();
+        LastCoordinatorConnectTime = 0.0;
+    }
+    else
     {
-        const FAssetData& AssetData = *ObjIter;
+        // Find test maps, without scanning the whole project.
+        FString DiscoveryManifestPath = ParseCommandLineOption(TEXT("TestDiscoveryManifestPath"));
+
+        if (DiscoveryManifestPath.IsEmpty())
+        {
+            DiscoveryManifestPath = FDaeTestMapDiscovery::GetDefaultManifestPath();
+        }
 
-        FString FileName = FPackageName::LongPackageNameToFilename(AssetData.ObjectPath.ToString());
-        FName MapName = AssetData.AssetName;
+        FDaeTestMapDiscovery Discovery;
+        Discovery.Discover(DiscoveryManifestPath);
+
+        MapNames = Discovery.GetMapNames();
+        MapInfos = Discovery.GetMapInfos();
+
+        // Tests without map are selected and run just like another test map.
+        if (FDaeTestTransientWorld::HasTests())
+        {
+            MapNames.Add(FDaeTestTransientWorld::MapName);
+            MapInfos.Add(FDaeTestTransientWorld::MapName, FDaeTestTransientWorld::GetMapInfo());
+        }
 
-        const bool bIsTestMap = TestAutomationPluginSettings->IsTestMap(FileName, MapName);
+        BuildPlan();
+        ApplyShard();
 
-        if (bIsTestMap)
+        // Record progress for resuming after crashes. Test servers handle many short runs instead.
+        if (bIsSelectionValid && !bDryRun && !FParse::Param(FCommandLine::Get(), TEXT("TestServer")))
         {
-            MapNames.Add(MapName);
+            FString CheckpointPath = ParseCommandLineOption(TEXT("TestCheckpointPath"));
 
-            UE_LOG(LogDaeTest, Display, TEXT("Discovered test: %s"), *MapName.ToString());
+            if (CheckpointPath.IsEmpty())
+            {
+                int32 ShardIndex = -1;
+                FParse::Value(FCommandLine::Get(), TEXT("ShardIndex="), ShardIndex);
+
+                CheckpointPath = FDaeTestCheckpoint::GetDefaultFilePath(ShardIndex);
+            }
+
+            const bool bResume = FParse::Param(FCommandLine::Get(), TEXT("Resume"));
+
+            if (Checkpoint.Open(CheckpointPath, bResume) && bResume)
+            {
+                ResumeFromCheckpoint();
+            }
+
+            // Report passing results of unchanged test maps again, instead of running them.
+            FString ResultCachePath = ParseCommandLineOption(TEXT("TestResultCachePath"));
+
+            if (!ResultCachePath.IsEmpty()
+                || FParse::Param(FCommandLine::Get(), TEXT("TestResultCache")))
+            {
+                if (ResultCachePath.IsEmpty())
+                {
+                    ResultCachePath = FDaeTestResultCache::GetDefaultDirectory();
+                }
+
+                ResultCache.Open(ResultCachePath);
+                ApplyResultCache();
+            }
         }
     }
 
+    if (!bIsSelectionValid)
+    {
+        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+        EndTest(1);
+        return;
+    }
+
+    if (bDryRun)
+    {
+        // Just show what would be run.
+        LogPlan();
+
+        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+        EndTest(0);
+        return;
+    }
+
     // Set console variables.
     for (auto& ConsoleVariable : TestAutomationPluginSettings->ConsoleVariables)
     {
@@ -72,6 +223,33 @@ void UDaeGauntletTestController::OnInit()
     }
 
     GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Initialized);
+
+    // Watch for hangs of the game thread. Coordinators don't run any tests themselves.
+    if (!bIsCoordinator && TestAutomationPluginSettings->WatchdogGraceSeconds > 0.0f)
+    {
+        Watchdog = MakeShareable(
+            new FDaeTestWatchdog(TestAutomationPluginSettings->WatchdogGraceSeconds));
+    }
+
+    if (bIsCoordinator)
+    {
+        StartCoordinator(CoordinatorPort);
+    }
+    else if (FParse::Param(FCommandLine::Get(), TEXT("TestServer")))
+    {
+        // Stay resident and wait for test run requests, instead of running all tests once.
+        int32 TestServerPort = FDaeTestServer::DefaultPort;
+        FParse::Value(FCommandLine::Get(), TEXT("TestServerPort="), TestServerPort);
+
+        TestServer = MakeShareable(new FDaeTestServer());
+
+        if (!TestServer->Start(TestServerPort))
+        {
+            TestServer = nullptr;
+            GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+            EndTest(1);
+        }
+    }
 }
 
 void UDaeGauntletTestController::OnPostMapChange(UWorld* World)
@@ -81,31 +259,69 @@ void UDaeGauntletTestController::OnPostMapChange(UWorld* World)
     UE_LOG(LogDaeTest, Log, TEXT("UDaeGauntletTestController::OnPostMapChange - World: %s"),
            *World->GetName());
 
+    // New world references whatever it needs of the prefetched assets now.
+    ReleasePrefetchedAssets();
+
+    // Streaming sublevels have been removed along with the previous world.
+    CurrentStreamingLevel = nullptr;
+    UnloadingStreamingLevel = nullptr;
+    bTravelingToStreamingPersistentMap = false;
+
     if (GetCurrentState() != FDaeGauntletStates::LoadingNextMap)
     {
         return;
     }
 
+    MapLoadTimeSeconds = FPlatformTime::Seconds() - MapLoadStartTime;
+
     GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::DiscoveringTests);
 }
 
 void UDaeGauntletTestController::OnTick(float TimeDelta)
 {
+    if (Coordinator.IsValid())
+    {
+        // Coordinator doesn't run any tests itself.
+        if (GetCurrentState() == FDaeGauntletStates::Finished)
+        {
+            return;
+        }
+
+        Coordinator->Tick();
+
+        if (Coordinator->IsFinished())
+        {
+            FinishAllTests();
+        }
+
+        return;
+    }
+
     if (GetCurrentState() == FDaeGauntletStates::Initialized)
     {
-        // If this isn't a test map (e.g. immediately after startup), load first test map now.
-        if (!MapNames.Contains(FName(*GetCurrentMap())))
+        if (TestServer.IsValid())
+        {
+            GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::WaitingForRequest);
+            return;
+        }
+
+        // If this isn't the first test map (e.g. immediately after startup), load first test map now.
+        if (bIsWorker || Plan.Num() <= 0 || MapNames[Plan[0]] != FName(*GetCurrentMap()))
         {
             UE_LOG(LogDaeTest, Log,
-                   TEXT("FDaeGauntletStates::Initialized - World is not a test world, "
+                   TEXT("FDaeGauntletStates::Initialized - World is not the first test world, "
                         "loading first test world."));
 
-            MapIndex = -1;
+            PlanIndex = -1;
             LoadNextTestMap();
             return;
         }
         else
         {
+            PlanIndex = 0;
+            MapIndex = Plan[PlanIndex];
+            MapLoadTimeSeconds = 0.0;
+            Checkpoint.AppendTestMapStarted(MapNames[MapIndex]);
             GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::DiscoveringTests);
         }
     }
@@ -113,18 +329,68 @@ void UDaeGauntletTestController::OnTick(float TimeDelta)
     {
         UE_LOG(LogGauntlet, Display,
                TEXT("FDaeGauntletStates::LoadingNextMap - Loading map: %s (%d/%d)"),
-               *MapNames[MapIndex].ToString(), (MapIndex + 1), MapNames.Num());
+               *MapNames[MapIndex].ToString(), (PlanIndex + 1), Plan.Num());
+
+        // Prefer long package names, saving the engine from looking up short map names.
+        const FDaeTestMapInfo* MapInfo = MapInfos.Find(MapNames[MapIndex]);
+
+        if (Watchdog.IsValid())
+        {
+            WatchdogDescription =
+                FString::Printf(TEXT("Loading %s"), *MapNames[MapIndex].ToString());
+            UpdateWatchdogFailureRecord(FDaeTestSuiteResult(), FDaeTestReportWriterSet());
+            Watchdog->Arm(WatchdogDescription,
+                          GetDefault<UDaeTestAutomationPluginSettings>()->MinMapTimeoutSeconds);
+        }
+
+        if (MapNames[MapIndex] == FDaeTestTransientWorld::MapName)
+        {
+            // Run all tests without map right away, without traveling.
+            MapLoadTimeSeconds = 0.0;
+            MapStartTime = FPlatformTime::Seconds();
+
+            FDaeTestTransientWorld TransientWorld;
+            TransientWorld.Run();
+
+            FinishTestMap(TransientWorld.GetResult(), TransientWorld.GetReportWriters());
+            return;
+        }
 
-        UGameplayStatics::OpenLevel(this, MapNames[MapIndex]);
+        MapLoadStartTime = FPlatformTime::Seconds();
+        UGameplayStatics::OpenLevel(this, MapInfo != nullptr && !MapInfo->PackageName.IsNone()
+                                              ? MapInfo->PackageName
+                                              : MapNames[MapIndex]);
+    }
+    else if (GetCurrentState() == FDaeGauntletStates::StreamingNextMap)
+    {
+        StreamTestMap();
     }
     else if (GetCurrentState() == FDaeGauntletStates::DiscoveringTests)
     {
-        // Find test suite.
+        // Find test suite. Streamed test maps share their world with the persistent one.
         ADaeTestSuiteActor* TestSuite = nullptr;
 
-        for (TActorIterator<ADaeTestSuiteActor> ActorIt(GetWorld()); ActorIt; ++ActorIt)
+        if (CurrentStreamingLevel.IsValid())
+        {
+            ULevel* Level = CurrentStreamingLevel->GetLoadedLevel();
+
+            if (IsValid(Level))
+            {
+                for (AActor* Actor : Level->Actors)
+                {
+                    if (ADaeTestSuiteActor* TestSuiteActor = Cast<ADaeTestSuiteActor>(Actor))
+                    {
+                        TestSuite = TestSuiteActor;
+                    }
+                }
+            }
+        }
+        else
         {
-            TestSuite = *ActorIt;
+            for (TActorIterator<ADaeTestSuiteActor> ActorIt(GetWorld()); ActorIt; ++ActorIt)
+            {
+                TestSuite = *ActorIt;
+            }
         }
 
         if (!IsValid(TestSuite))
@@ -137,195 +403,1289 @@ void UDaeGauntletTestController::OnTick(float TimeDelta)
             return;
         }
 
+        // Limit test map duration based on previous runs.
+        const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+            GetDefault<UDaeTestAutomationPluginSettings>();
+        const FName MapName = MapNames[MapIndex];
+
+        // Simulate as fast as possible, if the test map allows it.
+        const FDaeTestMapInfo* MapInfo = MapInfos.Find(MapName);
+
+        if (MapInfo != nullptr && MapInfo->MetaData.bAcceleratedSimulation)
+        {
+            BeginAcceleratedSimulation(MapInfo->MetaData.SimulationTimeDilation);
+        }
+
+        MapStartTime = FPlatformTime::Seconds();
+        MapStartGameTime = GetWorld()->GetUnpausedTimeSeconds();
+        MapTimeoutSeconds = 0.0f;
+
+        if (TestAutomationPluginSettings->MapTimeoutFactor > 0.0f
+            && DurationHistory.Contains(MapName))
+        {
+            MapTimeoutSeconds = FMath::Max(DurationHistory.GetDurationSeconds(MapName, 0.0f)
+                                               * TestAutomationPluginSettings->MapTimeoutFactor,
+                                           TestAutomationPluginSettings->MinMapTimeoutSeconds);
+
+            UE_LOG(LogDaeTest, Log,
+                   TEXT("FDaeGauntletStates::DiscoveringTests - %s is allowed to run for %f "
+                        "seconds."),
+                   *MapName.ToString(), MapTimeoutSeconds);
+        }
+
         // Start first test.
+        CurrentTestSuite = TestSuite;
         GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Running);
 
         TestSuite->OnTestSuiteSuccessful.AddDynamic(
             this, &UDaeGauntletTestController::OnTestSuiteFinished);
         TestSuite->OnTestSuiteFailed.AddDynamic(this,
                                                 &UDaeGauntletTestController::OnTestSuiteFinished);
+        TestSuite->OnTestStarted.AddDynamic(this, &UDaeGauntletTestController::OnTestStarted);
+
+        // Load next test map in the background while this one is running.
+        PrefetchNextTestMap();
 
         TestSuite->RunAllTests();
     }
+    else if (GetCurrentState() == FDaeGauntletStates::Running)
+    {
+        if (MapTimeoutSeconds > 0.0f && GetMapTimeSeconds() > MapTimeoutSeconds)
+        {
+            OnTestMapTimedOut();
+            return;
+        }
+
+        // Accelerated tests time out in game time, so the watchdog just has to check whether frames are still ticking.
+        if (bAcceleratedSimulation && Watchdog.IsValid())
+        {
+            Watchdog->Heartbeat();
+        }
+    }
+    else if (GetCurrentState() == FDaeGauntletStates::WaitingForRequest)
+    {
+        TSharedPtr<FJsonObject> Request = TestServer->ReceiveRequest();
+
+        if (Request.IsValid())
+        {
+            HandleTestServerRequest(Request.ToSharedRef());
+        }
+    }
+    else if (GetCurrentState() == FDaeGauntletStates::WaitingForTestMap)
+    {
+        RequestNextTestMap();
+    }
 }
 
-void UDaeGauntletTestController::LoadNextTestMap()
+void UDaeGauntletTestController::ApplyShard()
 {
-    ++MapIndex;
+    int32 ShardIndex = -1;
+    int32 ShardCount = 1;
 
-	// Gather command line options.
-	const FString SingleTestName = ParseCommandLineOption(TEXT("TestName"));
-	const FString TestTagsString = ParseCommandLineOption(TEXT("TestTags"));
-	const FString TestPriorityString = ParseCommandLineOption(TEXT("TestPriority"));
+    FParse::Value(FCommandLine::Get(), TEXT("ShardIndex="), ShardIndex);
+    FParse::Value(FCommandLine::Get(), TEXT("ShardCount="), ShardCount);
 
-    // Check if we just want to run a single test.
-    if (!SingleTestName.IsEmpty())
+    if (ShardCount <= 1)
     {
-        // Increment MapIndex until we found the map.
-        while (MapNames.IsValidIndex(MapIndex) && MapNames[MapIndex].ToString() != SingleTestName)
-        {
-            ++MapIndex;
-        }
+        return;
     }
-	else if (!TestTagsString.IsEmpty())
-	{
-		// Check if we just want to run tests with a given tag.
-		TArray<FString> RequiredTestTags;
-		const TCHAR* TagSeparator = TEXT(";");
-		TestTagsString.ParseIntoArray(RequiredTestTags, TagSeparator);
-		if (RequiredTestTags.Num() > 0)
-		{
-			bool bHasFoundTagInTest = false;
-            while (!bHasFoundTagInTest)
-            {
-                // Found no test map with the required tag.
-				if (!MapNames.IsValidIndex(MapIndex))
-				{
-					break;
-				}
-
-                const FString TestName = FPaths::GetBaseFilename(MapNames[MapIndex].ToString());
-                bHasFoundTagInTest = DoesMapHasTag(TestName, RequiredTestTags);
-
-				if (!bHasFoundTagInTest)
-				{
-					++MapIndex;
-				}
-            }
-		}
-	}
-	if (!TestPriorityString.IsEmpty())
+
+    if (ShardIndex < 0 || ShardIndex >= ShardCount)
     {
-        const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
-            GetDefault<UDaeTestAutomationPluginSettings>();
-        const TMap<FString, FDaeTestMapMetaData>& TestMapsMetaData =
-            TestAutomationPluginSettings->TestMapsMetaData;
-
-        const EDaeTestPriority RequiredPriority = ConvertStringToPriority(TestPriorityString);
-		bool bHasTestRequiredPriority = false;
-		while (!bHasTestRequiredPriority)
-		{
-			// Found no test map with the required tag.
-			if (!MapNames.IsValidIndex(MapIndex))
-			{
-				break;
-			}
-
-			EDaeTestPriority TestPriority = EDaeTestPriority::DTP_Default;
-			// Check if the test has a non default priority.
-            const FString TestName = FPaths::GetBaseFilename(MapNames[MapIndex].ToString());
-			if (TestMapsMetaData.Contains(TestName))
-			{
-				// Check if the test has one of the required tags.
-				TestPriority = TestMapsMetaData[TestName].Priority;
-			}
-			if (TestPriority >= RequiredPriority)
-			{
-				bHasTestRequiredPriority = true;
-			}
-
-			if (!bHasTestRequiredPriority)
-			{
-				++MapIndex;
-			}
-		}
-	}
-
-    if (MapNames.IsValidIndex(MapIndex))
+        UE_LOG(LogDaeTest, Error,
+               TEXT("UDaeGauntletTestController::ApplyShard - Invalid shard index %d for %d "
+                    "shards, running all tests instead."),
+               ShardIndex, ShardCount);
+        return;
+    }
+
+    // Assign longest test maps first, always to the shard with the least total duration so far.
+    // All clients need to end up with the same assignment, so this requires them to share the same
+    // history, which is only guaranteed if it has been passed explicitly. Otherwise, the local
+    // histories may differ between machines, so just distribute the test maps by plan order, counting
+    // all of them equally.
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    TArray<int32> MapIndices = Plan;
+
+    auto GetMapDuration = [this, TestAutomationPluginSettings](int32 Index) {
+        return bHasSharedDurationHistory
+                   ? DurationHistory.GetDurationSeconds(
+                         MapNames[Index], TestAutomationPluginSettings->DefaultMapDurationSeconds)
+                   : 1.0f;
+    };
+
+    if (bHasSharedDurationHistory)
     {
-        // Load next test map in next tick. This is to avoid invocation list changes during OnPostMapChange.
-        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::LoadingNextMap);
+        MapIndices.StableSort([&GetMapDuration](int32 A, int32 B) {
+            return GetMapDuration(A) > GetMapDuration(B);
+        });
     }
     else
     {
-        // All tests finished.
-        UE_LOG(LogDaeTest, Display,
-               TEXT("UDaeGauntletTestController::LoadNextTestMap - All tests finished."));
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("UDaeGauntletTestController::ApplyShard - No TestDurationHistoryPath "
+                    "specified, distributing test maps without balancing their durations."));
+    }
 
-        // Finish Gauntlet.
-        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+    TArray<float> ShardDurations;
+    ShardDurations.SetNumZeroed(ShardCount);
+
+    TArray<bool> IsInShard;
+    IsInShard.SetNumZeroed(MapNames.Num());
+
+    for (int32 Index : MapIndices)
+    {
+        int32 Shard = 0;
 
-        for (const FDaeTestSuiteResult& Result : Results)
+        for (int32 OtherShard = 1; OtherShard < ShardCount; ++OtherShard)
         {
-            if (Result.NumFailedTests() > 0)
+            if (ShardDurations[OtherShard] < ShardDurations[Shard])
             {
-                EndTest(1);
-                return;
+                Shard = OtherShard;
             }
         }
 
-        EndTest(0);
+        ShardDurations[Shard] += GetMapDuration(Index);
+        IsInShard[Index] = Shard == ShardIndex;
+    }
+
+    // Keep planned order within shard.
+    TArray<int32> ShardPlan;
+
+    for (int32 Index : Plan)
+    {
+        if (IsInShard[Index])
+        {
+            ShardPlan.Add(Index);
+        }
     }
+
+    UE_LOG(LogDaeTest, Display,
+           TEXT("Running shard %d/%d with %d of %d test maps (estimated duration: %f seconds)."),
+           ShardIndex + 1, ShardCount, ShardPlan.Num(), Plan.Num(),
+           ShardDurations[ShardIndex]);
+
+    Plan = ShardPlan;
 }
 
-bool UDaeGauntletTestController::DoesMapHasTag(const FString& TestName,
-                                               const TArray<FString>& RequiredTags) const
+void UDaeGauntletTestController::ResumeFromCheckpoint()
 {
-    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
-        GetDefault<UDaeTestAutomationPluginSettings>();
-    const TMap<FString, FDaeTestMapMetaData>& TestMapsMetaData =
-        TestAutomationPluginSettings->TestMapsMetaData;
-    // Check if the test has tags.
-    if (TestMapsMetaData.Contains(TestName))
+    TSet<FName> FinishedMapNames;
+
+    for (const FDaeTestCheckpointResult& CheckpointResult : Checkpoint.GetRestoredResults())
     {
-        // Check if the test has one of the required tags.
-        const TArray<FString> Tags = TestMapsMetaData[TestName].Tags;
-        for (auto& Tag : Tags)
+        const FName MapName = FName(*CheckpointResult.Result.MapName);
+
+        if (FinishedMapNames.Contains(MapName))
         {
-            if (RequiredTags.Contains(Tag))
-            {
-                return true;
-            }
+            continue;
+        }
+
+        FinishedMapNames.Add(MapName);
+        StoreResult(CheckpointResult.Result, CheckpointResult.ReportWriters,
+                    CheckpointResult.LoadTimeSeconds);
+    }
+
+    // Fail the test map the previous run crashed in, instead of running it again.
+    const FName InterruptedMapName = Checkpoint.GetInterruptedMapName();
+
+    if (!InterruptedMapName.IsNone() && !FinishedMapNames.Contains(InterruptedMapName))
+    {
+        const int32 NumLogLines = 50;
+        const TArray<FString> LogLines = FDaeTestCheckpoint::GetPreviousLogTail(NumLogLines);
+
+        FDaeTestSuiteResult Result;
+        Result.MapName = InterruptedMapName.ToString();
+        Result.Timestamp = FDateTime::UtcNow();
+
+        FDaeTestResult CrashResult(TEXT("MapCrashed"), 0.0f);
+        CrashResult.FailureMessage = FString::Printf(
+            TEXT("Test map crashed or hung in a previous run. Last log lines:%s%s"),
+            LINE_TERMINATOR, *FString::Join(LogLines, LINE_TERMINATOR));
+        Result.TestResults.Add(CrashResult);
+
+        UE_LOG(LogDaeTest, Error,
+               TEXT("UDaeGauntletTestController::ResumeFromCheckpoint - %s crashed in a previous "
+                    "run, skipping."),
+               *InterruptedMapName.ToString());
+
+        FDaeTestReportWriterSet ReportWriters;
+        ReportWriters.Add(MakeShareable(new FDaeTestReportWriterJUnit()));
+
+        FinishedMapNames.Add(InterruptedMapName);
+        StoreResult(Result, ReportWriters, 0.0f);
+    }
+
+    // Skip all of these test maps.
+    const int32 NumPlannedMaps = Plan.Num();
+
+    Plan.RemoveAll([this, &FinishedMapNames](int32 Index) {
+        return FinishedMapNames.Contains(MapNames[Index]);
+    });
+
+    UE_LOG(LogDaeTest, Display, TEXT("Resuming with %d of %d test maps left."), Plan.Num(),
+           NumPlannedMaps);
+}
+
+void UDaeGauntletTestController::ApplyResultCache()
+{
+    ResultCacheKeys.Empty();
+
+    const int32 NumPlannedMaps = Plan.Num();
+    TArray<int32> ChangedPlan;
+
+    for (int32 Index : Plan)
+    {
+        const FName& MapName = MapNames[Index];
+        const FString Key = ResultCache.GetKey(MapName, MapInfos.FindRef(MapName).PackageName);
+
+        ResultCacheKeys.Add(MapName, Key);
+
+        FDaeTestCheckpointResult CachedResult;
+
+        if (!ResultCache.Find(Key, CachedResult))
+        {
+            ChangedPlan.Add(Index);
+            continue;
         }
+
+        UE_LOG(LogDaeTest, Display,
+               TEXT("%s hasn't changed since passing before, reporting cached result."),
+               *MapName.ToString());
+
+        CachedResult.Result.MapName = MapName.ToString();
+        StoreResult(CachedResult.Result, CachedResult.ReportWriters, CachedResult.LoadTimeSeconds);
     }
 
-    return false;
+    Plan = ChangedPlan;
+
+    UE_LOG(LogDaeTest, Display, TEXT("Skipping %d of %d test maps with cached results."),
+           NumPlannedMaps - Plan.Num(), NumPlannedMaps);
 }
 
-EDaeTestPriority UDaeGauntletTestController::ConvertStringToPriority(
-    const FString& TestPriorityString)
+void UDaeGauntletTestController::StartCoordinator(int32 Port)
 {
-    if (TestPriorityString.Contains("Critical", ESearchCase::IgnoreCase)
-        || TestPriorityString.Equals("3"))
+    // Hand out longest test maps first, so that workers finish at about the same time.
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    TArray<FName> SelectedMapNames;
+
+    for (int32 Index : Plan)
     {
-        return EDaeTestPriority::DTP_CriticalPriority;
+        SelectedMapNames.Add(MapNames[Index]);
     }
-    if (TestPriorityString.Contains("High", ESearchCase::IgnoreCase)
-        || TestPriorityString.Equals("2"))
+
+    SelectedMapNames.StableSort([this, TestAutomationPluginSettings](const FName& A, const FName& B) {
+        return DurationHistory.GetDurationSeconds(
+                   A, TestAutomationPluginSettings->DefaultMapDurationSeconds)
+               > DurationHistory.GetDurationSeconds(
+                   B, TestAutomationPluginSettings->DefaultMapDurationSeconds);
+    });
+
+    Coordinator = MakeShareable(new FDaeTestCoordinator());
+    Coordinator->OnResultReceived.BindUObject(this, &UDaeGauntletTestController::StoreResult);
+
+    if (!Coordinator->Start(Port, SelectedMapNames, MapInfos))
     {
-        return EDaeTestPriority::DTP_HighPriority;
+        Coordinator = nullptr;
+        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+        EndTest(1);
     }
-    if (TestPriorityString.Contains("Medium", ESearchCase::IgnoreCase)
-        || TestPriorityString.Equals("1"))
+}
+
+bool UDaeGauntletTestController::ConnectToCoordinator()
+{
+    const double Now = FPlatformTime::Seconds();
+
+    if (Now - LastCoordinatorConnectTime < 1.0)
     {
-        return EDaeTestPriority::DTP_MediumPriority;
+        return false;
     }
-    if (TestPriorityString.Contains("Low", ESearchCase::IgnoreCase)
-        || TestPriorityString.Equals("0"))
+
+    LastCoordinatorConnectTime = Now;
+    CoordinatorChannel = FDaeTestMessageChannel::Connect(CoordinatorPort);
+
+    if (!CoordinatorChannel.IsValid())
     {
-        return EDaeTestPriority::DTP_LowPriority;
+        return false;
     }
 
-    return EDaeTestPriority::DTP_Default;
+    UE_LOG(LogDaeTest, Display,
+           TEXT("UDaeGauntletTestController::ConnectToCoordinator - Connected to test coordinator "
+                "on port %d."),
+           CoordinatorPort);
+
+    CoordinatorConnectStartTime = 0.0;
+    return true;
 }
 
-void UDaeGauntletTestController::OnTestSuiteFinished(ADaeTestSuiteActor* TestSuite)
+void UDaeGauntletTestController::LoadNextTestMap()
 {
-    // Store result.
-    Results.Add(TestSuite->GetResult());
+    UnloadStreamedTestMap();
+
+    if (bIsWorker)
+    {
+        // Ask coordinator for the next test map while ticking, instead of blocking the game thread.
+        TestMapRequestTime = 0.0;
+        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::WaitingForTestMap);
+        return;
+    }
 
-    // Update test reports on disk.
-    const FString ReportPath = ParseCommandLineOption(TEXT("ReportPath"));
+    ++PlanIndex;
 
-    const FDaeTestReportWriterSet ReportWriters = TestSuite->GetReportWriters();
+    if (Plan.IsValidIndex(PlanIndex))
+    {
+        MapIndex = Plan[PlanIndex];
+        Checkpoint.AppendTestMapStarted(MapNames[MapIndex]);
 
-    for (const TSharedPtr<FDaeTestReportWriter>& ReportWriter : ReportWriters.GetReportWriters())
+        // Load next test map in next tick. This is to avoid invocation list changes during OnPostMapChange.
+        GetGauntlet()->BroadcastStateChange(ShouldStreamTestMap(MapIndex)
+                                                ? FDaeGauntletStates::StreamingNextMap
+                                                : FDaeGauntletStates::LoadingNextMap);
+    }
+    else
     {
-        ReportWriter->WriteReport(Results, ReportPath);
+        FinishAllTests();
     }
+}
 
-    // Proceed with next test.
-    LoadNextTestMap();
+void UDaeGauntletTestController::RequestNextTestMap()
+{
+    // Coordinator might still be starting up.
+    const double ConnectTimeoutSeconds = 120.0;
+    const double ResponseTimeoutSeconds = 60.0;
+
+    if (!CoordinatorChannel.IsValid())
+    {
+        if (CoordinatorConnectStartTime <= 0.0)
+        {
+            // Lost connection to coordinator before.
+            FinishAllTests();
+            return;
+        }
+
+        if (ConnectToCoordinator())
+        {
+            return;
+        }
+
+        if (FPlatformTime::Seconds() - CoordinatorConnectStartTime > ConnectTimeoutSeconds)
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("UDaeGauntletTestController::RequestNextTestMap - Unable to connect to "
+                        "test coordinator on port %d."),
+                   CoordinatorPort);
+
+            CoordinatorConnectStartTime = 0.0;
+            FinishAllTests();
+        }
+
+        return;
+    }
+
+    if (TestMapRequestTime <= 0.0)
+    {
+        TSharedRef<FJsonObject> Request = MakeShareable(new FJsonObject());
+        Request->SetStringField(TEXT("Type"), FDaeTestCoordinator::MessageTypeRequestTestMap);
+
+        if (!CoordinatorChannel->Send(Request))
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("UDaeGauntletTestController::RequestNextTestMap - Lost connection to test "
+                        "coordinator."));
+            CoordinatorChannel = nullptr;
+            FinishAllTests();
+            return;
+        }
+
+        TestMapRequestTime = FPlatformTime::Seconds();
+        return;
+    }
+
+    TSharedPtr<FJsonObject> Response = CoordinatorChannel->Receive();
+
+    if (!Response.IsValid())
+    {
+        if (!CoordinatorChannel->IsConnected()
+            || FPlatformTime::Seconds() - TestMapRequestTime > ResponseTimeoutSeconds)
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("UDaeGauntletTestController::RequestNextTestMap - Test coordinator didn't "
+                        "respond."));
+            CoordinatorChannel = nullptr;
+            FinishAllTests();
+        }
+
+        return;
+    }
+
+    TestMapRequestTime = 0.0;
+
+    if (Response->GetStringField(TEXT("Type")) != FDaeTestCoordinator::MessageTypeRunTestMap)
+    {
+        // All test maps have been handed out.
+        FinishAllTests();
+        return;
+    }
+
+    const FName MapName = FName(*Response->GetStringField(TEXT("MapName")));
+    const TSharedPtr<FJsonObject>* MapInfoObject;
+
+    if (Response->TryGetObjectField(TEXT("MapInfo"), MapInfoObject))
+    {
+        MapInfos.Add(MapName, FDaeTestMapInfo::FromJson(MapInfoObject->ToSharedRef()));
+    }
+
+    MapIndex = MapNames.AddUnique(MapName);
+    PlanIndex = Plan.Add(MapIndex);
+
+    GetGauntlet()->BroadcastStateChange(ShouldStreamTestMap(MapIndex)
+                                            ? FDaeGauntletStates::StreamingNextMap
+                                            : FDaeGauntletStates::LoadingNextMap);
+}
+
+bool UDaeGauntletTestController::ShouldStreamTestMap(int32 Index) const
+{
+    if (StreamingPersistentMap.IsEmpty())
+    {
+        return false;
+    }
+
+    const FDaeTestMapInfo* MapInfo = MapInfos.Find(MapNames[Index]);
+    return MapInfo != nullptr && !MapInfo->PackageName.IsNone()
+           && !MapInfo->MetaData.bRequiresFullTravel;
+}
+
+void UDaeGauntletTestController::StreamTestMap()
+{
+    // Travel to persistent world first, if necessary (e.g. after a test map that requires full travel).
+    if (GetWorld()->GetOutermost()->GetName() != StreamingPersistentMap)
+    {
+        // Wait for travel to finish, instead of starting it over every tick.
+        if (!bTravelingToStreamingPersistentMap)
+        {
+            bTravelingToStreamingPersistentMap = true;
+            UGameplayStatics::OpenLevel(this, FName(*StreamingPersistentMap));
+        }
+
+        return;
+    }
+
+    // Wait for previous test map to be removed, to prevent both from interfering with each other.
+    if (UnloadingStreamingLevel.IsValid())
+    {
+        if (UnloadingStreamingLevel->GetLoadedLevel() != nullptr)
+        {
+            return;
+        }
+
+        UnloadingStreamingLevel = nullptr;
+    }
+
+    if (!CurrentStreamingLevel.IsValid())
+    {
+        const FName PackageName = MapInfos.FindRef(MapNames[MapIndex]).PackageName;
+
+        UE_LOG(LogGauntlet, Display,
+               TEXT("FDaeGauntletStates::StreamingNextMap - Streaming map: %s (%d/%d)"),
+               *MapNames[MapIndex].ToString(), (PlanIndex + 1), Plan.Num());
+
+        if (Watchdog.IsValid())
+        {
+            WatchdogDescription =
+                FString::Printf(TEXT("Streaming %s"), *MapNames[MapIndex].ToString());
+            UpdateWatchdogFailureRecord(FDaeTestSuiteResult(), FDaeTestReportWriterSet());
+            Watchdog->Arm(WatchdogDescription,
+                          GetDefault<UDaeTestAutomationPluginSettings>()->MinMapTimeoutSeconds);
+        }
+
+        MapLoadStartTime = FPlatformTime::Seconds();
+
+        bool bSuccess = false;
+        CurrentStreamingLevel = ULevelStreamingDynamic::LoadLevelInstance(
+            this, PackageName.ToString(), FVector::ZeroVector, FRotator::ZeroRotator, bSuccess);
+
+        if (!bSuccess)
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("UDaeGauntletTestController::StreamTestMap - Unable to stream %s, loading "
+                        "it as persistent world instead."),
+                   *PackageName.ToString());
+
+            CurrentStreamingLevel = nullptr;
+            GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::LoadingNextMap);
+        }
+
+        return;
+    }
+
+    if (!CurrentStreamingLevel->IsLevelVisible())
+    {
+        return;
+    }
+
+    MapLoadTimeSeconds = FPlatformTime::Seconds() - MapLoadStartTime;
+
+    // Streamed test map references whatever it needs of the prefetched assets now.
+    ReleasePrefetchedAssets();
+
+    GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::DiscoveringTests);
+}
+
+void UDaeGauntletTestController::UnloadStreamedTestMap()
+{
+    if (!CurrentStreamingLevel.IsValid())
+    {
+        return;
+    }
+
+    CurrentStreamingLevel->SetIsRequestingUnloadAndRemoval(true);
+
+    UnloadingStreamingLevel = CurrentStreamingLevel;
+    CurrentStreamingLevel = nullptr;
+}
+
+void UDaeGauntletTestController::PrefetchNextTestMap()
+{
+    ReleasePrefetchedAssets();
+
+    // Workers don't know their next test map in advance.
+    if (bIsWorker || !Plan.IsValidIndex(PlanIndex + 1))
+    {
+        return;
+    }
+
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    if (TestAutomationPluginSettings->PrefetchMemoryBudgetMB <= 0)
+    {
+        return;
+    }
+
+    // Background loading would skew frame times, and prefetched assets would count against the
+    // memory budgets of performance tests.
+    if (CurrentTestSuite.IsValid())
+    {
+        for (const ADaeTestActor* Test : CurrentTestSuite->GetTests())
+        {
+            if (Cast<ADaeTestPerformanceBudgetActor>(Test) != nullptr)
+            {
+                UE_LOG(LogDaeTest, Log,
+                       TEXT("UDaeGauntletTestController::PrefetchNextTestMap - Not prefetching "
+                            "during performance tests."));
+                return;
+            }
+        }
+    }
+
+    const FName NextMapName = MapNames[Plan[PlanIndex + 1]];
+    const FDaeTestMapInfo* NextMapInfo = MapInfos.Find(NextMapName);
+
+    if (NextMapInfo == nullptr || NextMapInfo->PackageName.IsNone())
+    {
+        return;
+    }
+
+    // The map package itself is left to travel, so that its world is initialized as usual.
+    // Loading each hard dependency loads all of its own imports as well.
+    FAssetRegistryModule& AssetRegistryModule =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+    TArray<FName> Dependencies;
+
+#if UE_4_26_OR_LATER
+    AssetRegistryModule.Get().GetDependencies(NextMapInfo->PackageName, Dependencies,
+                                              UE::AssetRegistry::EDependencyCategory::Package,
+                                              UE::AssetRegistry::EDependencyQuery::Hard);
+#else
+    AssetRegistryModule.Get().GetDependencies(NextMapInfo->PackageName, Dependencies,
+                                              EAssetRegistryDependencyType::Hard);
+#endif
+
+    for (const FName& Dependency : Dependencies)
+    {
+        const FString DependencyString = Dependency.ToString();
+
+        if (DependencyString.StartsWith(TEXT("/Script/"))
+            || FindPackage(nullptr, *DependencyString) != nullptr)
+        {
+            continue;
+        }
+
+        PrefetchQueue.Add(Dependency);
+    }
+
+    if (PrefetchQueue.Num() <= 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogDaeTest, Log,
+           TEXT("UDaeGauntletTestController::PrefetchNextTestMap - Prefetching %d packages of %s."),
+           PrefetchQueue.Num(), *NextMapName.ToString());
+
+    PrefetchStartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    PrefetchNextPackage();
+}
+
+void UDaeGauntletTestController::PrefetchNextPackage()
+{
+    PendingPrefetchPackageName = NAME_None;
+
+    if (PrefetchQueue.Num() <= 0)
+    {
+        return;
+    }
+
+    // Load one package at a time, to be able to stop as soon as the budget is exhausted.
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    const int64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    const int64 PrefetchUsedPhysical = UsedPhysical - static_cast<int64>(PrefetchStartUsedPhysical);
+    const int64 PrefetchBudget =
+        static_cast<int64>(TestAutomationPluginSettings->PrefetchMemoryBudgetMB) * 1024 * 1024;
+
+    if (PrefetchUsedPhysical > PrefetchBudget)
+    {
+        UE_LOG(LogDaeTest, Log,
+               TEXT("UDaeGauntletTestController::PrefetchNextPackage - Prefetch memory budget of "
+                    "%d MB exhausted, skipping %d packages."),
+               TestAutomationPluginSettings->PrefetchMemoryBudgetMB, PrefetchQueue.Num());
+
+        PrefetchQueue.Empty();
+        return;
+    }
+
+    PendingPrefetchPackageName = PrefetchQueue.Pop(false);
+
+    LoadPackageAsync(
+        PendingPrefetchPackageName.ToString(),
+        FLoadPackageAsyncDelegate::CreateUObject(
+            this, &UDaeGauntletTestController::OnPrefetchPackageLoaded));
+}
+
+void UDaeGauntletTestController::OnPrefetchPackageLoaded(const FName& PackageName,
+                                                         UPackage* LoadedPackage,
+                                                         EAsyncLoadingResult::Type Result)
+{
+    if (PackageName != PendingPrefetchPackageName)
+    {
+        // Prefetch has been released in the meantime.
+        return;
+    }
+
+    if (Result == EAsyncLoadingResult::Succeeded && IsValid(LoadedPackage))
+    {
+        // Packages don't keep their contents from being garbage collected.
+        ForEachObjectWithOuter(
+            LoadedPackage,
+            [this](UObject* Object) {
+                if (Object->IsAsset())
+                {
+                    PrefetchedAssets.Add(Object);
+                }
+            },
+            false);
+    }
+
+    PrefetchNextPackage();
+}
+
+void UDaeGauntletTestController::ReleasePrefetchedAssets()
+{
+    PendingPrefetchPackageName = NAME_None;
+    PrefetchQueue.Empty();
+    PrefetchedAssets.Empty();
+}
+
+void UDaeGauntletTestController::BeginAcceleratedSimulation(float TimeDilation)
+{
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    if (!bAcceleratedSimulation)
+    {
+        bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+        PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+        PreviousMaxFPS = GEngine->GetMaxFPS();
+        PreviousTimeDilation = UGameplayStatics::GetGlobalTimeDilation(this);
+    }
+
+    bAcceleratedSimulation = true;
+
+    // With a fixed timestep, the engine doesn't wait for real time to pass between frames.
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(TestAutomationPluginSettings->AcceleratedSimulationDeltaSeconds);
+    GEngine->SetMaxFPS(0.0f);
+
+    UGameplayStatics::SetGlobalTimeDilation(this, TimeDilation);
+
+    UE_LOG(LogDaeTest, Log,
+           TEXT("UDaeGauntletTestController::BeginAcceleratedSimulation - Simulating %s with a "
+                "fixed timestep of %f seconds and a time dilation of %f."),
+           *MapNames[MapIndex].ToString(),
+           TestAutomationPluginSettings->AcceleratedSimulationDeltaSeconds, TimeDilation);
+}
+
+void UDaeGauntletTestController::EndAcceleratedSimulation()
+{
+    if (!bAcceleratedSimulation)
+    {
+        return;
+    }
+
+    bAcceleratedSimulation = false;
+
+    FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+    FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+    GEngine->SetMaxFPS(PreviousMaxFPS);
+
+    // Streamed test maps share the world settings of the persistent world.
+    if (IsValid(GetWorld()))
+    {
+        UGameplayStatics::SetGlobalTimeDilation(this, PreviousTimeDilation);
+    }
+}
+
+double UDaeGauntletTestController::GetMapTimeSeconds() const
+{
+    // Tests of accelerated test maps measure game time, so their test map does as well.
+    if (bAcceleratedSimulation && IsValid(GetWorld()))
+    {
+        return GetWorld()->GetUnpausedTimeSeconds() - MapStartGameTime;
+    }
+
+    return FPlatformTime::Seconds() - MapStartTime;
+}
+
+bool UDaeGauntletTestController::CompileSelection(const FString& TestFilter,
+                                                  const FString& TestName,
+                                                  const FString& TestTags,
+                                                  const FString& TestPriority)
+{
+    // Legacy options are combined with the filter expression.
+    const FString Expression = FDaeTestSelection::CombineAnd(
+        TestFilter, FDaeTestSelection::FromLegacyOptions(TestName, TestTags, TestPriority));
+
+    FString Error;
+
+    if (!Selection.Compile(Expression, Error))
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("UDaeGauntletTestController::CompileSelection - Invalid test filter %s: %s"),
+               *Expression, *Error);
+        return false;
+    }
+
+    if (!Expression.IsEmpty())
+    {
+        UE_LOG(LogDaeTest, Display, TEXT("Selecting tests: %s"), *Expression);
+    }
+
+    return true;
+}
+
+void UDaeGauntletTestController::ParseChangedPackages(const FString& ChangedPackagesOption)
+{
+    bSelectChangedPackagesOnly = false;
+    ChangedPackages.Empty();
+
+    if (ChangedPackagesOption.IsEmpty())
+    {
+        return;
+    }
+
+    // Accept both a file with one entry per line (e.g. output of git diff) and a list of entries.
+    TArray<FString> Entries;
+
+    if (FPaths::FileExists(ChangedPackagesOption))
+    {
+        FFileHelper::LoadFileToStringArray(Entries, *ChangedPackagesOption);
+    }
+    else
+    {
+        ChangedPackagesOption.ParseIntoArray(Entries, TEXT(";"));
+    }
+
+    for (FString Entry : Entries)
+    {
+        Entry.TrimStartAndEndInline();
+
+        if (Entry.IsEmpty())
+        {
+            continue;
+        }
+
+        const FString Extension = FPaths::GetExtension(Entry);
+
+        if (Extension == TEXT("uasset") || Extension == TEXT("umap"))
+        {
+            // Relative file paths are relative to the project, just like the output of version control.
+            const FString Filename =
+                FPaths::IsRelative(Entry) ? FPaths::Combine(FPaths::ProjectDir(), Entry) : Entry;
+            FString PackageName;
+
+            if (FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName))
+            {
+                ChangedPackages.Add(FName(*PackageName));
+                continue;
+            }
+        }
+        else if (FPackageName::IsValidLongPackageName(Entry))
+        {
+            ChangedPackages.Add(FName(*Entry));
+            continue;
+        }
+
+        // Changes to anything but assets (e.g. code or config) may affect any test.
+        UE_LOG(LogDaeTest, Display,
+               TEXT("%s is not an asset and may affect any test map, selecting all test maps."),
+               *Entry);
+
+        ChangedPackages.Empty();
+        return;
+    }
+
+    bSelectChangedPackagesOnly = true;
+
+    UE_LOG(LogDaeTest, Display, TEXT("Selecting test maps affected by %d changed packages."),
+           ChangedPackages.Num());
+}
+
+void UDaeGauntletTestController::BuildPlan()
+{
+    Plan.Empty();
+    PlanIndex = -1;
+
+    // Walking the dependency graph requires the asset registry to be fully loaded, so only do it if necessary.
+    TUniquePtr<FDaeTestPackageDependencies> PackageDependencies;
+
+    if (bSelectChangedPackagesOnly)
+    {
+        PackageDependencies = MakeUnique<FDaeTestPackageDependencies>();
+    }
+
+    int32 UnaffectedMapCount = 0;
+
+    for (int32 Index = 0; Index < MapNames.Num(); ++Index)
+    {
+        const FName& MapName = MapNames[Index];
+        const FDaeTestMapInfo MapInfo = MapInfos.FindRef(MapName);
+
+        if (!Selection.Matches(MapName, MapInfo))
+        {
+            continue;
+        }
+
+        if (PackageDependencies.IsValid())
+        {
+            const TSet<FName> Closure = PackageDependencies->GetClosure(
+                FDaeTestPackageDependencies::GetTestMapPackages(MapName, MapInfo.PackageName));
+
+            if (Closure.Intersect(ChangedPackages).Num() <= 0)
+            {
+                ++UnaffectedMapCount;
+                continue;
+            }
+        }
+
+        Plan.Add(Index);
+    }
+
+    if (bSelectChangedPackagesOnly)
+    {
+        UE_LOG(LogDaeTest, Display,
+               TEXT("Skipping %d test maps not affected by any changed package."),
+               UnaffectedMapCount);
+    }
+}
+
+void UDaeGauntletTestController::LogPlan() const
+{
+    UE_LOG(LogDaeTest, Display, TEXT("Dry run - Would run %d of %d test maps:"), Plan.Num(),
+           MapNames.Num());
+
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    for (int32 Index = 0; Index < Plan.Num(); ++Index)
+    {
+        const FName& MapName = MapNames[Plan[Index]];
+        const FDaeTestMapInfo MapInfo = MapInfos.FindRef(MapName);
+
+        UE_LOG(LogDaeTest, Display,
+               TEXT("%d. %s (%s) - Tags: %s, Priority: %d, Tests: %d, Estimated duration: %f "
+                    "seconds"),
+               Index + 1, *MapName.ToString(), *MapInfo.PackageName.ToString(),
+               *FString::Join(MapInfo.MetaData.Tags, TEXT(";")),
+               static_cast<int32>(MapInfo.MetaData.Priority), MapInfo.TestCount,
+               DurationHistory.GetDurationSeconds(
+                   MapName, TestAutomationPluginSettings->DefaultMapDurationSeconds));
+    }
+}
+
+void UDaeGauntletTestController::FinishAllTests()
+{
+    // All tests finished.
+    UE_LOG(LogDaeTest, Display,
+           TEXT("UDaeGauntletTestController::FinishAllTests - All tests finished."));
+
+    // Remember durations for future runs. Workers leave that to their coordinator.
+    if (!bIsWorker)
+    {
+        DurationHistory.Save(DurationHistoryPath);
+    }
+
+    if (Watchdog.IsValid())
+    {
+        Watchdog->Disarm();
+    }
+
+    // Finish test reports.
+    if (ReportWriterQueue.IsValid())
+    {
+        ReportWriterQueue->FinishReports();
+        ReportWriterQueue = nullptr;
+    }
+
+    if (TestServer.IsValid())
+    {
+        // Keep running and wait for the next request.
+        SendTestServerResponse();
+        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::WaitingForRequest);
+        return;
+    }
+
+    // Finish Gauntlet.
+    GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+
+    if (bIsWorker && !CoordinatorChannel.IsValid())
+    {
+        // Lost connection to coordinator, results of this worker might be missing.
+        EndTest(1);
+        return;
+    }
+
+    for (const FDaeTestSuiteResult& Result : Results)
+    {
+        if (Result.NumFailedTests() > 0)
+        {
+            EndTest(1);
+            return;
+        }
+    }
+
+    EndTest(0);
+}
+
+void UDaeGauntletTestController::HandleTestServerRequest(const TSharedRef<FJsonObject>& Request)
+{
+    const FString RequestType = Request->GetStringField(TEXT("Type"));
+
+    if (RequestType == FDaeTestServer::MessageTypeShutdown)
+    {
+        UE_LOG(LogDaeTest, Display,
+               TEXT("UDaeGauntletTestController::HandleTestServerRequest - Shutting down."));
+
+        TestServer = nullptr;
+        GetGauntlet()->BroadcastStateChange(FDaeGauntletStates::Finished);
+        EndTest(0);
+        return;
+    }
+
+    if (RequestType != FDaeTestServer::MessageTypeRunTests)
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("UDaeGauntletTestController::HandleTestServerRequest - Unknown request type: "
+                    "%s"),
+               *RequestType);
+        return;
+    }
+
+    // Replace test selection of the previous request. Missing fields select all tests.
+    FString TestFilter;
+    FString TestName;
+    FString TestTags;
+    FString TestPriority;
+
+    Request->TryGetStringField(TEXT("TestFilter"), TestFilter);
+    Request->TryGetStringField(TEXT("TestName"), TestName);
+    Request->TryGetStringField(TEXT("TestTags"), TestTags);
+    Request->TryGetStringField(TEXT("TestPriority"), TestPriority);
+
+    Results.Empty();
+
+    if (!CompileSelection(TestFilter, TestName, TestTags, TestPriority))
+    {
+        Plan.Empty();
+        SendTestServerResponse();
+        return;
+    }
+
+    BuildPlan();
+
+    bool bDryRun = false;
+    Request->TryGetBoolField(TEXT("DryRun"), bDryRun);
+
+    if (bDryRun)
+    {
+        LogPlan();
+        SendTestServerResponse();
+        return;
+    }
+
+    if (!Request->TryGetStringField(TEXT("ReportPath"), ReportPath))
+    {
+        ReportPath = ParseCommandLineOption(TEXT("ReportPath"));
+    }
+
+    UE_LOG(LogDaeTest, Display,
+           TEXT("UDaeGauntletTestController::HandleTestServerRequest - Running %d test maps "
+                "(ReportPath: %s)."),
+           Plan.Num(), *ReportPath);
+
+    LoadNextTestMap();
+}
+
+void UDaeGauntletTestController::SendTestServerResponse()
+{
+    TArray<TSharedPtr<FJsonValue>> TestSuiteValues;
+    int32 NumTests = 0;
+    int32 NumFailedTests = 0;
+
+    for (const FDaeTestSuiteResult& Result : Results)
+    {
+        TestSuiteValues.Add(MakeShareable(new FJsonValueObject(Result.ToJson())));
+        NumTests += Result.NumTotalTests();
+        NumFailedTests += Result.NumFailedTests();
+    }
+
+    TSharedRef<FJsonObject> Response = MakeShareable(new FJsonObject());
+    Response->SetStringField(TEXT("Type"), FDaeTestServer::MessageTypeTestsFinished);
+    Response->SetNumberField(TEXT("NumTests"), NumTests);
+    Response->SetNumberField(TEXT("NumFailedTests"), NumFailedTests);
+    Response->SetBoolField(TEXT("Successful"), NumFailedTests == 0);
+    Response->SetArrayField(TEXT("TestSuites"), TestSuiteValues);
+
+    TArray<TSharedPtr<FJsonValue>> PlanValues;
+
+    for (int32 Index : Plan)
+    {
+        PlanValues.Add(MakeShareable(new FJsonValueString(MapNames[Index].ToString())));
+    }
+
+    Response->SetArrayField(TEXT("Plan"), PlanValues);
+
+    TestServer->SendResponse(Response);
+}
+
+void UDaeGauntletTestController::OnTestSuiteFinished(ADaeTestSuiteActor* TestSuite)
+{
+    if (GetCurrentState() != FDaeGauntletStates::Running)
+    {
+        // Test map has already timed out.
+        return;
+    }
+
+    FinishTestMap(TestSuite->GetResult(), TestSuite->GetReportWriters());
+}
+
+void UDaeGauntletTestController::OnTestStarted(ADaeTestSuiteActor* TestSuite, ADaeTestActor* Test)
+{
+    if (!Watchdog.IsValid())
+    {
+        return;
+    }
+
+    WatchdogDescription = FString::Printf(TEXT("%s - %s"), *MapNames[MapIndex].ToString(),
+                                          *TestSuite->GetCurrentTestName());
+
+    // Remember results so far, as the watchdog can't safely access the test suite.
+    UpdateWatchdogFailureRecord(TestSuite->GetResult(), TestSuite->GetReportWriters());
+
+    if (bAcceleratedSimulation)
+    {
+        // Tests time out in game time, so just check whether frames are still ticking.
+        Watchdog->ArmHeartbeat(WatchdogDescription);
+        return;
+    }
+
+    // Independent tests may run at the same time, so wait for the one that's allowed to run longest.
+    Watchdog->Arm(WatchdogDescription, TestSuite->GetRemainingTimeoutSeconds());
+}
+
+void UDaeGauntletTestController::UpdateWatchdogFailureRecord(
+    const FDaeTestSuiteResult& Result, const FDaeTestReportWriterSet& ReportWriters)
+{
+    // Serialize everything now, as the watchdog thread must not access any state of the game thread.
+    FDaeTestSuiteResult FailedResult = Result;
+
+    if (FailedResult.MapName.IsEmpty() && MapNames.IsValidIndex(MapIndex))
+    {
+        FailedResult.MapName = MapNames[MapIndex].ToString();
+        FailedResult.Timestamp = FDateTime::UtcNow();
+    }
+
+    FDaeTestResult HangResult(TEXT("WatchdogTimeout"), 0.0f);
+    HangResult.FailureMessage = FString::Printf(
+        TEXT("%s didn't finish in time, game thread seems to be hung. See log for callstacks."),
+        *WatchdogDescription);
+    FailedResult.TestResults.Add(HangResult);
+
+    FDaeTestReportWriterSet FailedReportWriters = ReportWriters;
+    FailedReportWriters.Add(MakeShareable(new FDaeTestReportWriterJUnit()));
+
+    TSharedRef<FJsonObject> FailureRecord = MakeShareable(new FJsonObject());
+    FailureRecord->SetStringField(TEXT("Description"), WatchdogDescription);
+    FailureRecord->SetObjectField(TEXT("Result"), FailedResult.ToJson());
+    FailureRecord->SetArrayField(TEXT("ReportWriters"), FailedReportWriters.ToJson());
+    FailureRecord->SetNumberField(TEXT("LoadTimeSeconds"), MapLoadTimeSeconds);
+
+    FString FailureRecordString;
+    TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&FailureRecordString);
+    FJsonSerializer::Serialize(FailureRecord, JsonWriter);
+
+    // Reports of all previous test maps have already been written, so record this one next to them.
+    const FString FailureRecordDirectory =
+        ReportPath.IsEmpty()
+            ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"))
+            : ReportPath;
+
+    const FString FailureRecordPath =
+        FPaths::Combine(FailureRecordDirectory, TEXT("WatchdogFailure.json"));
+
+    Watchdog->SetFailureRecord(FailureRecordPath, FailureRecordString);
+}
+
+void UDaeGauntletTestController::OnTestMapTimedOut()
+{
+    const double MapTimeSeconds = GetMapTimeSeconds();
+
+    UE_LOG(LogDaeTest, Error,
+           TEXT("UDaeGauntletTestController::OnTestMapTimedOut - %s timed out after %f seconds."),
+           *MapNames[MapIndex].ToString(), MapTimeSeconds);
+
+    // Keep results of all tests that have finished so far, if possible.
+    FDaeTestSuiteResult Result;
+    FDaeTestReportWriterSet ReportWriters;
+
+    if (CurrentTestSuite.IsValid())
+    {
+        Result = CurrentTestSuite->GetResult();
+        ReportWriters = CurrentTestSuite->GetReportWriters();
+    }
+    else
+    {
+        Result.MapName = MapNames[MapIndex].ToString();
+        Result.Timestamp = FDateTime::UtcNow();
+    }
+
+    FDaeTestResult TimeoutResult(
+        TEXT("MapTimeout"),
+        FMath::Max(static_cast<float>(MapTimeSeconds) - Result.GetTotalTimeSeconds(), 0.0f));
+    TimeoutResult.FailureMessage =
+        FString::Printf(TEXT("Test map timed out after %f seconds."), MapTimeSeconds);
+    Result.TestResults.Add(TimeoutResult);
+
+    FinishTestMap(Result, ReportWriters);
+}
+
+void UDaeGauntletTestController::FinishTestMap(const FDaeTestSuiteResult& TestSuiteResult,
+                                               const FDaeTestReportWriterSet& ReportWriters)
+{
+    CurrentTestSuite = nullptr;
+
+    EndAcceleratedSimulation();
+
+    // Test suites of streamed test maps report the name of the persistent world.
+    FDaeTestSuiteResult Result = TestSuiteResult;
+
+    if (CurrentStreamingLevel.IsValid())
+    {
+        Result.MapName = MapNames[MapIndex].ToString();
+    }
+
+    if (Watchdog.IsValid())
+    {
+        Watchdog->Disarm();
+    }
+
+    if (bIsWorker)
+    {
+        // Let coordinator store result and write reports.
+        SendResultToCoordinator(Result, ReportWriters);
+
+        // Keep own results for the exit code of this worker.
+        Results.Add(Result);
+    }
+    else
+    {
+        StoreResult(Result, ReportWriters, static_cast<float>(MapLoadTimeSeconds));
+    }
+
+    // Proceed with next test.
+    LoadNextTestMap();
+}
+
+void UDaeGauntletTestController::SendResultToCoordinator(
+    const FDaeTestSuiteResult& Result, const FDaeTestReportWriterSet& ReportWriters)
+{
+    if (!CoordinatorChannel.IsValid())
+    {
+        return;
+    }
+
+    TSharedRef<FJsonObject> Message = MakeShareable(new FJsonObject());
+    Message->SetStringField(TEXT("Type"), FDaeTestCoordinator::MessageTypeTestMapFinished);
+    Message->SetObjectField(TEXT("Result"), Result.ToJson());
+    Message->SetArrayField(TEXT("ReportWriters"), ReportWriters.ToJson());
+    Message->SetNumberField(TEXT("LoadTimeSeconds"), MapLoadTimeSeconds);
+
+    if (!CoordinatorChannel->Send(Message))
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("UDaeGauntletTestController::SendResultToCoordinator - Unable to send result "
+                    "to test coordinator."));
+        CoordinatorChannel = nullptr;
+    }
+}
+
+void UDaeGauntletTestController::StoreResult(const FDaeTestSuiteResult& Result,
+                                             const FDaeTestReportWriterSet& ReportWriters,
+                                             float LoadTimeSeconds)
+{
+    // Store result.
+    Results.Add(Result);
+    Checkpoint.AppendTestMapFinished(Result, ReportWriters, LoadTimeSeconds);
+    ResultCache.Store(ResultCacheKeys.FindRef(FName(*Result.MapName)), Result, ReportWriters,
+                      LoadTimeSeconds);
+
+    // Remember duration for balancing shards and deriving timeouts in future runs.
+    // Results without any duration (e.g. crashed test maps) don't tell how long the map takes.
+    const float DurationSeconds = LoadTimeSeconds + Result.GetTotalTimeSeconds();
+
+    if (DurationSeconds > 0.0f)
+    {
+        DurationHistory.SetDurationSeconds(FName(*Result.MapName), DurationSeconds);
+    }
+
+    // Append to test reports in the background, to avoid hitches between test maps.
+    if (!ReportWriterQueue.IsValid())
+    {
+        ReportWriterQueue = MakeShareable(new FDaeTestReportWriterQueue(ReportPath));
+    }
+
+    for (const TSharedPtr<FDaeTestReportWriter>& ReportWriter : ReportWriters.GetReportWriters())
+    {
+        ReportWriterQueue->AddReportWriter(ReportWriter);
+    }
+
+    ReportWriterQueue->AppendTestSuite(Result);
 }
 
 FString UDaeGauntletTestController::ParseCommandLineOption(const FString& Key) const
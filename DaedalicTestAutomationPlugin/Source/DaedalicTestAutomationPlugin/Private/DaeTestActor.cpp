@@ -4,7 +4,6 @@
 #include "DaeTestParameterProviderActor.h"
 #include "DaeTestReportWriterJUnit.h"
 #include "DaeTestResult.h"
-#include "Settings/DaeTestAutomationPluginSettings.h"
 
 ADaeTestActor::ADaeTestActor(
     const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
@@ -89,6 +88,11 @@ float ADaeTestActor::GetTimeoutInSeconds() const
     return TimeoutInSeconds;
 }
 
+bool ADaeTestActor::IsIndependent() const
+{
+    return bIndependent;
+}
+
 void ADaeTestActor::Timeout()
 {
     // Enough waiting. Let's see the results.
@@ -104,6 +108,11 @@ TArray<TSoftObjectPtr<UObject>> ADaeTestActor::GetParameters() const
     return Parameters;
 }
 
+const FDaeTestMapMetaData& ADaeTestActor::GetTestMetaData() const
+{
+    return TestMetaData;
+}
+
 UObject* ADaeTestActor::GetCurrentParameter() const
 {
     return CurrentParameter;
@@ -182,21 +191,6 @@ void ADaeTestActor::NotifyOnAssert(UObject* Parameter)
     ReceiveOnAssert(Parameter);
 }
 
-#if WITH_EDITOR
-void ADaeTestActor::PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent)
-{
-	Super::PostEditChangeChainProperty(PropertyChangedEvent);
-    
-	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
-	const FName PropertyHead = PropertyChangedEvent.PropertyChain.GetHead()->GetValue()->GetFName();
-	const FName PropertyTail = PropertyChangedEvent.PropertyChain.GetTail()->GetValue()->GetFName();
-	if (PropertyHead == GET_MEMBER_NAME_CHECKED(ADaeTestActor, TestMetaData))
-	{
-		UDaeTestAutomationPluginSettings::SetTestMetaData(this, TestMetaData);
-	}
-}
-#endif
-
 void ADaeTestActor::ReceiveOnAct_Implementation(UObject* Parameter)
 {
     FinishAct();
@@ -0,0 +1,220 @@
+#include "DaeTestCheckpoint.h"
+#include "DaeTestLogCategory.h"
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <HAL/PlatformOutputDevices.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+
+const FString FDaeTestCheckpoint::EventTypeTestMapStarted = TEXT("TestMapStarted");
+const FString FDaeTestCheckpoint::EventTypeTestMapFinished = TEXT("TestMapFinished");
+
+FDaeTestCheckpoint::FDaeTestCheckpoint()
+{
+}
+
+FDaeTestCheckpoint::~FDaeTestCheckpoint()
+{
+}
+
+FString FDaeTestCheckpoint::GetDefaultFilePath(int32 ShardIndex)
+{
+    const FString FileName = ShardIndex >= 0
+                                 ? FString::Printf(TEXT("TestCheckpoint.Shard%d.jsonl"), ShardIndex)
+                                 : TEXT("TestCheckpoint.jsonl");
+
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"),
+                           FileName);
+}
+
+bool FDaeTestCheckpoint::Open(const FString& FilePath, bool bResume)
+{
+    RestoredResults.Empty();
+    InterruptedMapName = NAME_None;
+
+    if (bResume)
+    {
+        ReadFile(FilePath);
+    }
+
+    // Ensure path exists.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FString Directory = FPaths::GetPath(FilePath);
+
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    // Start over. Restored results are recorded again as soon as they've been processed.
+    File.Reset(PlatformFile.OpenWrite(*FilePath));
+
+    if (!File.IsValid())
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestCheckpoint::Open - Unable to open %s for writing."), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogDaeTest, Log, TEXT("Writing test checkpoints to: %s"), *FilePath);
+    return true;
+}
+
+bool FDaeTestCheckpoint::IsOpen() const
+{
+    return File.IsValid();
+}
+
+void FDaeTestCheckpoint::AppendTestMapStarted(const FName& MapName)
+{
+    TSharedRef<FJsonObject> Event = MakeShareable(new FJsonObject());
+    Event->SetStringField(TEXT("Type"), EventTypeTestMapStarted);
+    Event->SetStringField(TEXT("MapName"), MapName.ToString());
+
+    AppendEvent(Event);
+}
+
+void FDaeTestCheckpoint::AppendTestMapFinished(const FDaeTestSuiteResult& Result,
+                                               const FDaeTestReportWriterSet& ReportWriters,
+                                               float LoadTimeSeconds)
+{
+    TSharedRef<FJsonObject> Event = MakeShareable(new FJsonObject());
+    Event->SetStringField(TEXT("Type"), EventTypeTestMapFinished);
+    Event->SetObjectField(TEXT("Result"), Result.ToJson());
+    Event->SetArrayField(TEXT("ReportWriters"), ReportWriters.ToJson());
+    Event->SetNumberField(TEXT("LoadTimeSeconds"), LoadTimeSeconds);
+
+    AppendEvent(Event);
+}
+
+const TArray<FDaeTestCheckpointResult>& FDaeTestCheckpoint::GetRestoredResults() const
+{
+    return RestoredResults;
+}
+
+FName FDaeTestCheckpoint::GetInterruptedMapName() const
+{
+    return InterruptedMapName;
+}
+
+TArray<FString> FDaeTestCheckpoint::GetPreviousLogTail(int32 NumLines)
+{
+    // The engine keeps the log of the previous run as backup when starting (e.g. MyGame-backup-2021.01.01-12.00.00.log).
+    const FString LogFilePath = FPlatformOutputDevices::GetAbsoluteLogFilename();
+    const FString LogDirectory = FPaths::GetPath(LogFilePath);
+    const FString BackupPattern = FPaths::Combine(
+        LogDirectory, FPaths::GetBaseFilename(LogFilePath) + TEXT("-backup-*.log"));
+
+    TArray<FString> BackupFileNames;
+    IFileManager::Get().FindFiles(BackupFileNames, *BackupPattern, true, false);
+
+    FString PreviousLogFilePath;
+    FDateTime PreviousLogTimeStamp = FDateTime::MinValue();
+
+    for (const FString& BackupFileName : BackupFileNames)
+    {
+        const FString BackupFilePath = FPaths::Combine(LogDirectory, BackupFileName);
+        const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*BackupFilePath);
+
+        if (TimeStamp > PreviousLogTimeStamp)
+        {
+            PreviousLogFilePath = BackupFilePath;
+            PreviousLogTimeStamp = TimeStamp;
+        }
+    }
+
+    TArray<FString> Lines;
+
+    if (PreviousLogFilePath.IsEmpty()
+        || !FFileHelper::LoadFileToStringArray(Lines, *PreviousLogFilePath))
+    {
+        return Lines;
+    }
+
+    if (Lines.Num() > NumLines)
+    {
+        Lines.RemoveAt(0, Lines.Num() - NumLines);
+    }
+
+    return Lines;
+}
+
+void FDaeTestCheckpoint::ReadFile(const FString& FilePath)
+{
+    TArray<FString> Lines;
+
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("FDaeTestCheckpoint::ReadFile - No checkpoint found at %s, starting over."),
+               *FilePath);
+        return;
+    }
+
+    for (const FString& Line : Lines)
+    {
+        // Last line might be incomplete after a crash.
+        TSharedPtr<FJsonObject> Event;
+        TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Line);
+
+        if (Line.IsEmpty() || !FJsonSerializer::Deserialize(JsonReader, Event) || !Event.IsValid())
+        {
+            continue;
+        }
+
+        const FString EventType = Event->GetStringField(TEXT("Type"));
+
+        if (EventType == EventTypeTestMapStarted)
+        {
+            InterruptedMapName = FName(*Event->GetStringField(TEXT("MapName")));
+        }
+        else if (EventType == EventTypeTestMapFinished)
+        {
+            const TSharedPtr<FJsonObject>* ResultObject;
+
+            if (!Event->TryGetObjectField(TEXT("Result"), ResultObject) || !ResultObject->IsValid())
+            {
+                continue;
+            }
+
+            FDaeTestCheckpointResult CheckpointResult;
+            CheckpointResult.Result = FDaeTestSuiteResult::FromJson(ResultObject->ToSharedRef());
+            CheckpointResult.LoadTimeSeconds = Event->GetNumberField(TEXT("LoadTimeSeconds"));
+
+            const TArray<TSharedPtr<FJsonValue>>* ReportTypeValues;
+
+            if (Event->TryGetArrayField(TEXT("ReportWriters"), ReportTypeValues))
+            {
+                CheckpointResult.ReportWriters = FDaeTestReportWriterSet::FromJson(*ReportTypeValues);
+            }
+
+            RestoredResults.Add(CheckpointResult);
+            InterruptedMapName = NAME_None;
+        }
+    }
+
+    UE_LOG(LogDaeTest, Display, TEXT("Restored results of %d test maps from %s"),
+           RestoredResults.Num(), *FilePath);
+}
+
+void FDaeTestCheckpoint::AppendEvent(const TSharedRef<FJsonObject>& Event)
+{
+    if (!File.IsValid())
+    {
+        return;
+    }
+
+    FString EventString;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&EventString);
+    FJsonSerializer::Serialize(Event, JsonWriter);
+
+    EventString += LINE_TERMINATOR;
+
+    FTCHARToUTF8 Utf8String(*EventString);
+    File->Write(reinterpret_cast<const uint8*>(Utf8String.Get()), Utf8String.Length());
+    File->Flush();
+}
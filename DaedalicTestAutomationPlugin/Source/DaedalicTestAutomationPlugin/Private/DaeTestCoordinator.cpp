@@ -0,0 +1,235 @@
+#include "DaeTestCoordinator.h"
+#include "DaeTestLogCategory.h"
+#include "DaeTestMessageChannel.h"
+#include "DaeTestReportWriterJUnit.h"
+#include <Sockets.h>
+
+const int32 FDaeTestCoordinator::DefaultPort = 17890;
+
+const FString FDaeTestCoordinator::MessageTypeRequestTestMap = TEXT("RequestTestMap");
+const FString FDaeTestCoordinator::MessageTypeRunTestMap = TEXT("RunTestMap");
+const FString FDaeTestCoordinator::MessageTypeAllTestMapsFinished = TEXT("AllTestMapsFinished");
+const FString FDaeTestCoordinator::MessageTypeTestMapFinished = TEXT("TestMapFinished");
+
+/** How long to wait for workers to (re-)connect after all workers have disconnected, in seconds. */
+static const double WorkerReconnectTimeoutSeconds = 60.0;
+
+/** How long to wait for the first worker to connect, in seconds. Workers need to boot up first. */
+static const double FirstWorkerTimeoutSeconds = 300.0;
+
+FDaeTestCoordinator::FDaeTestCoordinator()
+    : ListenSocket(nullptr)
+    , LastWorkerTime(0.0)
+    , bHadWorkers(false)
+{
+}
+
+FDaeTestCoordinator::~FDaeTestCoordinator()
+{
+    Workers.Empty();
+    FDaeTestMessageChannel::DestroySocket(ListenSocket);
+}
+
+bool FDaeTestCoordinator::Start(int32 Port, const TArray<FName>& InMapNames,
+                                const TMap<FName, FDaeTestMapInfo>& InMapInfos)
+{
+    ListenSocket = FDaeTestMessageChannel::Listen(Port, TEXT("DaeTestCoordinator"));
+
+    if (ListenSocket == nullptr)
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestCoordinator::Start - Unable to listen for workers on port %d."), Port);
+        return false;
+    }
+
+    PendingMapNames = InMapNames;
+    MapInfos = InMapInfos;
+    LastWorkerTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogDaeTest, Display,
+           TEXT("FDaeTestCoordinator::Start - Listening for workers on port %d, %d test maps to "
+                "run."),
+           Port, PendingMapNames.Num());
+
+    return true;
+}
+
+void FDaeTestCoordinator::Tick()
+{
+    // Accept new workers.
+    bool bHasPendingConnection = false;
+
+    while (ListenSocket != nullptr && ListenSocket->HasPendingConnection(bHasPendingConnection)
+           && bHasPendingConnection)
+    {
+        FSocket* WorkerSocket = ListenSocket->Accept(TEXT("DaeTestWorker"));
+
+        if (WorkerSocket == nullptr)
+        {
+            break;
+        }
+
+        FWorker Worker;
+        Worker.Channel = MakeShareable(new FDaeTestMessageChannel(WorkerSocket));
+        Workers.Add(Worker);
+
+        bHadWorkers = true;
+
+        UE_LOG(LogDaeTest, Display, TEXT("FDaeTestCoordinator::Tick - Worker %d connected."),
+               Workers.Num());
+    }
+
+    // Process worker messages.
+    for (int32 Index = Workers.Num() - 1; Index >= 0; --Index)
+    {
+        FWorker& Worker = Workers[Index];
+
+        for (TSharedPtr<FJsonObject> Message = Worker.Channel->Receive(); Message.IsValid();
+             Message = Worker.Channel->Receive())
+        {
+            HandleMessage(Worker, Message.ToSharedRef());
+        }
+
+        if (!Worker.Channel->IsConnected())
+        {
+            if (!Worker.MapName.IsNone())
+            {
+                // Don't hand out that map again, as it's likely to crash the next worker as well.
+                UE_LOG(LogDaeTest, Error,
+                       TEXT("FDaeTestCoordinator::Tick - Worker disconnected while running %s."),
+                       *Worker.MapName.ToString());
+
+                FailTestMap(Worker.MapName,
+                            TEXT("Worker disconnected while running test map, probably crashed."));
+            }
+
+            Workers.RemoveAt(Index);
+        }
+    }
+
+    if (Workers.Num() > 0)
+    {
+        LastWorkerTime = FPlatformTime::Seconds();
+    }
+    else if (PendingMapNames.Num() > 0
+             && FPlatformTime::Seconds() - LastWorkerTime
+                    > (bHadWorkers ? WorkerReconnectTimeoutSeconds : FirstWorkerTimeoutSeconds))
+    {
+        // All workers are gone for good, or never showed up at all.
+        const FString FailureMessage =
+            bHadWorkers ? TEXT("Test map not run, because all workers have disconnected.")
+                        : TEXT("Test map not run, because no worker has ever connected.");
+
+        UE_LOG(LogDaeTest, Error, TEXT("FDaeTestCoordinator::Tick - %s"), *FailureMessage);
+
+        for (const FName& MapName : PendingMapNames)
+        {
+            FailTestMap(MapName, FailureMessage);
+        }
+
+        PendingMapNames.Empty();
+    }
+}
+
+bool FDaeTestCoordinator::IsFinished() const
+{
+    if (PendingMapNames.Num() > 0)
+    {
+        return false;
+    }
+
+    for (const FWorker& Worker : Workers)
+    {
+        if (!Worker.MapName.IsNone())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FDaeTestCoordinator::HandleMessage(FWorker& Worker, const TSharedRef<FJsonObject>& Message)
+{
+    const FString MessageType = Message->GetStringField(TEXT("Type"));
+
+    if (MessageType == MessageTypeRequestTestMap)
+    {
+        TSharedRef<FJsonObject> Response = MakeShareable(new FJsonObject());
+
+        if (PendingMapNames.Num() > 0)
+        {
+            Worker.MapName = PendingMapNames[0];
+            PendingMapNames.RemoveAt(0);
+
+            Response->SetStringField(TEXT("Type"), MessageTypeRunTestMap);
+            Response->SetStringField(TEXT("MapName"), Worker.MapName.ToString());
+
+            if (const FDaeTestMapInfo* MapInfo = MapInfos.Find(Worker.MapName))
+            {
+                Response->SetObjectField(TEXT("MapInfo"), MapInfo->ToJson());
+            }
+
+            UE_LOG(LogDaeTest, Display,
+                   TEXT("FDaeTestCoordinator::HandleMessage - Handing out %s, %d test maps "
+                        "left."),
+                   *Worker.MapName.ToString(), PendingMapNames.Num());
+        }
+        else
+        {
+            Response->SetStringField(TEXT("Type"), MessageTypeAllTestMapsFinished);
+        }
+
+        Worker.Channel->Send(Response);
+    }
+    else if (MessageType == MessageTypeTestMapFinished)
+    {
+        const TSharedPtr<FJsonObject>* ResultObject;
+
+        if (!Message->TryGetObjectField(TEXT("Result"), ResultObject) || !ResultObject->IsValid())
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("FDaeTestCoordinator::HandleMessage - Received result without data."));
+            return;
+        }
+
+        const FDaeTestSuiteResult Result = FDaeTestSuiteResult::FromJson(ResultObject->ToSharedRef());
+
+        // Restore report writers for the result.
+        FDaeTestReportWriterSet ReportWriters;
+
+        const TArray<TSharedPtr<FJsonValue>>* ReportTypeValues;
+
+        if (Message->TryGetArrayField(TEXT("ReportWriters"), ReportTypeValues))
+        {
+            ReportWriters = FDaeTestReportWriterSet::FromJson(*ReportTypeValues);
+        }
+
+        Worker.MapName = NAME_None;
+
+        OnResultReceived.ExecuteIfBound(Result, ReportWriters,
+                                        Message->GetNumberField(TEXT("LoadTimeSeconds")));
+    }
+    else
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestCoordinator::HandleMessage - Unknown message type: %s"),
+               *MessageType);
+    }
+}
+
+void FDaeTestCoordinator::FailTestMap(const FName& MapName, const FString& FailureMessage)
+{
+    FDaeTestSuiteResult Result;
+    Result.MapName = MapName.ToString();
+    Result.Timestamp = FDateTime::UtcNow();
+
+    FDaeTestResult TestResult(MapName.ToString(), 0.0f);
+    TestResult.FailureMessage = FailureMessage;
+    Result.TestResults.Add(TestResult);
+
+    FDaeTestReportWriterSet ReportWriters;
+    ReportWriters.Add(MakeShareable(new FDaeTestReportWriterJUnit()));
+
+    OnResultReceived.ExecuteIfBound(Result, ReportWriters, 0.0f);
+}
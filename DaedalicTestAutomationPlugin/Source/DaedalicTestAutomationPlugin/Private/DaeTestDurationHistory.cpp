@@ -0,0 +1,111 @@
+#include "DaeTestDurationHistory.h"
+#include "DaeTestLogCategory.h"
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <HAL/PlatformProcess.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+FString FDaeTestDurationHistory::GetDefaultFilePath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"),
+                           TEXT("TestDurationHistory.txt"));
+}
+
+void FDaeTestDurationHistory::Load(const FString& FilePath)
+{
+    ReadFile(FilePath, DurationsSeconds);
+    RecordedDurationsSeconds.Empty();
+
+    UE_LOG(LogDaeTest, Log, TEXT("Loaded durations of %d test maps from %s"),
+           DurationsSeconds.Num(), *FilePath);
+}
+
+void FDaeTestDurationHistory::Save(const FString& FilePath) const
+{
+    if (RecordedDurationsSeconds.Num() <= 0)
+    {
+        return;
+    }
+
+    // Re-read file to keep durations recorded by other clients (e.g. other shards) in the meantime.
+    TMap<FName, float> MergedDurationsSeconds;
+    ReadFile(FilePath, MergedDurationsSeconds);
+    MergedDurationsSeconds.Append(RecordedDurationsSeconds);
+    MergedDurationsSeconds.KeySort(FNameLexicalLess());
+
+    // Ensure path exists.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FString Directory = FPaths::GetPath(FilePath);
+
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    // Write one line per map.
+    FString HistoryString;
+
+    for (const auto& Duration : MergedDurationsSeconds)
+    {
+        HistoryString += FString::Printf(TEXT("%s=%f"), *Duration.Key.ToString(), Duration.Value)
+                         + LINE_TERMINATOR;
+    }
+
+    UE_LOG(LogDaeTest, Display, TEXT("Writing test duration history to: %s"), *FilePath);
+
+    // Write to a temporary file first, so that other clients never read a partially written history.
+    const FString TempFilePath = FString::Printf(TEXT("%s.%u.tmp"), *FilePath,
+                                                 FPlatformProcess::GetCurrentProcessId());
+
+    if (!FFileHelper::SaveStringToFile(HistoryString, *TempFilePath)
+        || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestDurationHistory::Save - Unable to write test duration history to: %s"),
+               *FilePath);
+
+        IFileManager::Get().Delete(*TempFilePath);
+    }
+}
+
+bool FDaeTestDurationHistory::Contains(const FName& MapName) const
+{
+    return DurationsSeconds.Contains(MapName);
+}
+
+float FDaeTestDurationHistory::GetDurationSeconds(const FName& MapName,
+                                                  float DefaultDurationSeconds) const
+{
+    const float* DurationSeconds = DurationsSeconds.Find(MapName);
+    return DurationSeconds != nullptr ? *DurationSeconds : DefaultDurationSeconds;
+}
+
+void FDaeTestDurationHistory::SetDurationSeconds(const FName& MapName, float DurationSeconds)
+{
+    DurationsSeconds.Add(MapName, DurationSeconds);
+    RecordedDurationsSeconds.Add(MapName, DurationSeconds);
+}
+
+void FDaeTestDurationHistory::ReadFile(const FString& FilePath,
+                                       TMap<FName, float>& OutDurationsSeconds)
+{
+    TArray<FString> Lines;
+
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+    {
+        return;
+    }
+
+    for (const FString& Line : Lines)
+    {
+        FString MapName;
+        FString DurationString;
+
+        if (Line.Split(TEXT("="), &MapName, &DurationString))
+        {
+            OutDurationsSeconds.Add(FName(*MapName.TrimStartAndEnd()),
+                                    FCString::Atof(*DurationString));
+        }
+    }
+}
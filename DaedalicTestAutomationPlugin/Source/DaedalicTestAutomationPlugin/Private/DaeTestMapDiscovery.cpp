@@ -0,0 +1,372 @@
+#include "DaeTestMapDiscovery.h"
+#include "DaeTestLogCategory.h"
+#include "Settings/DaeTestAutomationPluginSettings.h"
+#include <AssetRegistryModule.h>
+#include <Engine/World.h>
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/PackageName.h>
+#include <Misc/Paths.h>
+#include <Misc/SecureHash.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+
+FString FDaeTestMapDiscovery::GetDefaultManifestPath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"),
+                           TEXT("TestDiscoveryManifest.json"));
+}
+
+void FDaeTestMapDiscovery::Discover(const FString& ManifestPath)
+{
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    for (const FString& TestMapFolder : TestAutomationPluginSettings->TestMapFolders)
+    {
+        UE_LOG(LogDaeTest, Display, TEXT("Discovering tests from: %s"), *TestMapFolder);
+    }
+
+    MapNames.Empty();
+    MapInfos.Empty();
+
+    // Check whether the results of the previous discovery are still valid.
+    FString ManifestFingerprint;
+    TMap<FName, FDaeTestMapInfo> ManifestMapInfos;
+    const bool bHasManifest = !ManifestPath.IsEmpty()
+                              && ReadManifest(ManifestPath, ManifestFingerprint, ManifestMapInfos);
+
+    const TArray<FName> AdditionalPackageNames =
+        ResolveAdditionalTestMaps(TestAutomationPluginSettings, ManifestMapInfos);
+
+    if (ManifestPath.IsEmpty())
+    {
+        ScanAssetRegistry(TestAutomationPluginSettings, AdditionalPackageNames);
+    }
+    else
+    {
+        const FString Fingerprint =
+            ComputeFingerprint(TestAutomationPluginSettings, AdditionalPackageNames);
+
+        if (bHasManifest && Fingerprint == ManifestFingerprint)
+        {
+            UE_LOG(LogDaeTest, Display, TEXT("Reusing test discovery manifest: %s"),
+                   *ManifestPath);
+
+            MapInfos = ManifestMapInfos;
+        }
+        else
+        {
+            ScanAssetRegistry(TestAutomationPluginSettings, AdditionalPackageNames);
+            WriteManifest(ManifestPath, Fingerprint);
+        }
+    }
+
+    MapInfos.GetKeys(MapNames);
+    MapNames.Sort(FNameLexicalLess());
+
+    for (const FName& MapName : MapNames)
+    {
+        UE_LOG(LogDaeTest, Display, TEXT("Discovered test: %s"), *MapName.ToString());
+    }
+}
+
+const TArray<FName>& FDaeTestMapDiscovery::GetMapNames() const
+{
+    return MapNames;
+}
+
+const TMap<FName, FDaeTestMapInfo>& FDaeTestMapDiscovery::GetMapInfos() const
+{
+    return MapInfos;
+}
+
+TArray<FString> FDaeTestMapDiscovery::GetTestMapPackagePaths(
+    const UDaeTestAutomationPluginSettings* Settings)
+{
+    TArray<FString> PackagePaths;
+
+    for (const FString& TestMapFolder : Settings->TestMapFolders)
+    {
+        const FString RelativePath =
+            TestMapFolder.Replace(TEXT("\\"), TEXT("/")).TrimChar(TEXT('/'));
+
+        if (!RelativePath.IsEmpty())
+        {
+            PackagePaths.Add(TEXT("/Game/") + RelativePath);
+        }
+    }
+
+    return PackagePaths;
+}
+
+TArray<FName> FDaeTestMapDiscovery::ResolveAdditionalTestMaps(
+    const UDaeTestAutomationPluginSettings* Settings,
+    const TMap<FName, FDaeTestMapInfo>& PreviousMapInfos)
+{
+    TArray<FName> PackageNames;
+
+    for (const FName& AdditionalTestMap : Settings->AdditionalTestMaps)
+    {
+        const FString MapString = AdditionalTestMap.ToString();
+
+        // Long package names (e.g. /Game/Maps/MyMap) can be scanned directly.
+        if (FPackageName::IsValidLongPackageName(MapString))
+        {
+            PackageNames.Add(AdditionalTestMap);
+            continue;
+        }
+
+        // Short names have to be looked up, but only if they've moved since the last discovery.
+        const FDaeTestMapInfo* PreviousMapInfo = PreviousMapInfos.Find(AdditionalTestMap);
+
+        if (PreviousMapInfo != nullptr
+            && FPackageName::DoesPackageExist(PreviousMapInfo->PackageName.ToString()))
+        {
+            PackageNames.Add(PreviousMapInfo->PackageName);
+            continue;
+        }
+
+        TArray<FString> FoundFiles;
+        IFileManager::Get().FindFilesRecursive(
+            FoundFiles, *FPaths::ProjectContentDir(),
+            *(MapString + FPackageName::GetMapPackageExtension()), true, false);
+
+        FString PackageName;
+
+        if (FoundFiles.Num() > 0
+            && FPackageName::TryConvertFilenameToLongPackageName(FoundFiles[0], PackageName))
+        {
+            PackageNames.Add(FName(*PackageName));
+        }
+        else
+        {
+            UE_LOG(LogDaeTest, Warning,
+                   TEXT("FDaeTestMapDiscovery::ResolveAdditionalTestMaps - Additional test map "
+                        "not found: %s"),
+                   *MapString);
+        }
+    }
+
+    return PackageNames;
+}
+
+FString FDaeTestMapDiscovery::ComputeFingerprint(const UDaeTestAutomationPluginSettings* Settings,
+                                                 const TArray<FName>& AdditionalPackageNames)
+{
+    TArray<FString> Entries;
+
+    // Settings.
+    for (const FString& TestMapFolder : Settings->TestMapFolders)
+    {
+        Entries.Add(TEXT("TestMapFolder=") + TestMapFolder);
+    }
+
+    for (const FName& AdditionalTestMap : Settings->AdditionalTestMaps)
+    {
+        Entries.Add(TEXT("AdditionalTestMap=") + AdditionalTestMap.ToString());
+    }
+
+    for (const FName& IgnoredMap : Settings->IgnoredMaps)
+    {
+        Entries.Add(TEXT("IgnoredMap=") + IgnoredMap.ToString());
+    }
+
+    // Tag data. Maps without tags fall back to the meta data from the settings.
+    Entries.Add(FString::Printf(TEXT("TagsVersion=%d"), FDaeTestMapInfo::TagsVersion));
+
+    for (const auto& TestMapMetaData : Settings->TestMapsMetaData)
+    {
+        FDaeTestMapInfo MapInfo;
+        MapInfo.MetaData = TestMapMetaData.Value;
+
+        FString MetaDataString;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&MetaDataString);
+        FJsonSerializer::Serialize(MapInfo.ToJson(), JsonWriter);
+
+        Entries.Add(TEXT("MetaData=") + TestMapMetaData.Key + TEXT("|") + MetaDataString);
+    }
+
+    // Map files.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    auto AddFileEntry = [&Entries](const FString& FileName, const FFileStatData& StatData) {
+        Entries.Add(FString::Printf(TEXT("File=%s|%s|%lld"), *FileName,
+                                    *StatData.ModificationTime.ToIso8601(), StatData.FileSize));
+    };
+
+    for (const FString& PackagePath : GetTestMapPackagePaths(Settings))
+    {
+        const FString Directory = FPackageName::LongPackageNameToFilename(PackagePath);
+
+        PlatformFile.IterateDirectoryStatRecursively(
+            *Directory, [&AddFileEntry](const TCHAR* FilenameOrDirectory,
+                                        const FFileStatData& StatData) {
+                const FString FileName = FilenameOrDirectory;
+
+                if (!StatData.bIsDirectory
+                    && FileName.EndsWith(FPackageName::GetMapPackageExtension()))
+                {
+                    AddFileEntry(FileName, StatData);
+                }
+
+                return true;
+            });
+    }
+
+    for (const FName& PackageName : AdditionalPackageNames)
+    {
+        const FString FileName = FPackageName::LongPackageNameToFilename(
+            PackageName.ToString(), FPackageName::GetMapPackageExtension());
+        AddFileEntry(FileName, PlatformFile.GetStatData(*FileName));
+    }
+
+    // Ensure a stable order, independent of the file system.
+    Entries.Sort();
+
+    return FMD5::HashAnsiString(*FString::Join(Entries, TEXT("\n")));
+}
+
+void FDaeTestMapDiscovery::ScanAssetRegistry(const UDaeTestAutomationPluginSettings* Settings,
+                                             const TArray<FName>& AdditionalPackageNames)
+{
+    FAssetRegistryModule& AssetRegistryModule =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+    // Scan test map folders and additional test maps, only.
+    const TArray<FString> PackagePaths = GetTestMapPackagePaths(Settings);
+
+    TArray<FString> AdditionalFileNames;
+
+    for (const FName& PackageName : AdditionalPackageNames)
+    {
+        AdditionalFileNames.Add(FPackageName::LongPackageNameToFilename(
+            PackageName.ToString(), FPackageName::GetMapPackageExtension()));
+    }
+
+    AssetRegistry.ScanPathsSynchronous(PackagePaths, false);
+    AssetRegistry.ScanFilesSynchronous(AdditionalFileNames, false);
+
+    // Find test maps among scanned assets.
+    TArray<FAssetData> AssetDataArray;
+
+    if (PackagePaths.Num() > 0)
+    {
+        FARFilter Filter;
+        Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+        Filter.bRecursivePaths = true;
+
+        for (const FString& PackagePath : PackagePaths)
+        {
+            Filter.PackagePaths.Add(FName(*PackagePath));
+        }
+
+        AssetRegistry.GetAssets(Filter, AssetDataArray);
+    }
+
+    if (AdditionalPackageNames.Num() > 0)
+    {
+        FARFilter Filter;
+        Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+        Filter.PackageNames = AdditionalPackageNames;
+
+        AssetRegistry.GetAssets(Filter, AssetDataArray);
+    }
+
+    for (const FAssetData& AssetData : AssetDataArray)
+    {
+        const FString FileName =
+            FPackageName::LongPackageNameToFilename(AssetData.PackageName.ToString());
+        const FName MapName = AssetData.AssetName;
+
+        const bool bIsTestMap = Settings->IsTestMap(FileName, MapName)
+                                || (AdditionalPackageNames.Contains(AssetData.PackageName)
+                                    && !Settings->IgnoredMaps.Contains(MapName));
+
+        if (bIsTestMap)
+        {
+            // Read meta data from asset registry tags, without loading the map.
+            MapInfos.Add(MapName, FDaeTestMapInfo::FromAssetData(AssetData));
+        }
+    }
+}
+
+bool FDaeTestMapDiscovery::ReadManifest(const FString& ManifestPath, FString& OutFingerprint,
+                                        TMap<FName, FDaeTestMapInfo>& OutMapInfos)
+{
+    FString ManifestString;
+
+    if (!FFileHelper::LoadFileToString(ManifestString, *ManifestPath))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> ManifestObject;
+    TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ManifestString);
+
+    if (!FJsonSerializer::Deserialize(JsonReader, ManifestObject) || !ManifestObject.IsValid())
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("FDaeTestMapDiscovery::ReadManifest - Unable to read test discovery manifest: "
+                    "%s"),
+               *ManifestPath);
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* MapsObject;
+
+    if (!ManifestObject->TryGetStringField(TEXT("Fingerprint"), OutFingerprint)
+        || !ManifestObject->TryGetObjectField(TEXT("Maps"), MapsObject))
+    {
+        return false;
+    }
+
+    for (const auto& MapValue : (*MapsObject)->Values)
+    {
+        const TSharedPtr<FJsonObject>& MapObject = MapValue.Value->AsObject();
+
+        if (MapObject.IsValid())
+        {
+            OutMapInfos.Add(FName(*MapValue.Key), FDaeTestMapInfo::FromJson(MapObject.ToSharedRef()));
+        }
+    }
+
+    return true;
+}
+
+void FDaeTestMapDiscovery::WriteManifest(const FString& ManifestPath,
+                                         const FString& Fingerprint) const
+{
+    // Ensure path exists.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FString Directory = FPaths::GetPath(ManifestPath);
+
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    // Write fingerprint, along with all maps.
+    TSharedRef<FJsonObject> MapsObject = MakeShareable(new FJsonObject());
+
+    for (const auto& MapInfo : MapInfos)
+    {
+        MapsObject->SetObjectField(MapInfo.Key.ToString(), MapInfo.Value.ToJson());
+    }
+
+    TSharedRef<FJsonObject> ManifestObject = MakeShareable(new FJsonObject());
+    ManifestObject->SetStringField(TEXT("Fingerprint"), Fingerprint);
+    ManifestObject->SetObjectField(TEXT("Maps"), MapsObject);
+
+    FString ManifestString;
+    TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ManifestString);
+    FJsonSerializer::Serialize(ManifestObject, JsonWriter);
+
+    UE_LOG(LogDaeTest, Log, TEXT("Writing test discovery manifest to: %s"), *ManifestPath);
+
+    FFileHelper::SaveStringToFile(ManifestString, *ManifestPath);
+}
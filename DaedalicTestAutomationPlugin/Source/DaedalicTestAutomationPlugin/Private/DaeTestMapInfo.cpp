@@ -0,0 +1,302 @@
+#include "DaeTestMapInfo.h"
+#include "DaeTestActor.h"
+#include "DaeTestSuiteActor.h"
+#include "Settings/DaeTestAutomationPluginSettings.h"
+#include <AssetData.h>
+#include <Engine/Level.h>
+#include <Engine/World.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+
+const int32 FDaeTestMapInfo::TagsVersion = 2;
+
+const FName FDaeTestMapInfo::TestTagsTag = TEXT("DaeTestTags");
+const FName FDaeTestMapInfo::TestPriorityTag = TEXT("DaeTestPriority");
+const FName FDaeTestMapInfo::TestExpectedErrorsTag = TEXT("DaeTestExpectedErrors");
+const FName FDaeTestMapInfo::TestCountTag = TEXT("DaeTestCount");
+const FName FDaeTestMapInfo::TestParameterCountTag = TEXT("DaeTestParameterCount");
+const FName FDaeTestMapInfo::TestRequiresFullTravelTag = TEXT("DaeTestRequiresFullTravel");
+const FName FDaeTestMapInfo::TestAcceleratedSimulationTag = TEXT("DaeTestAcceleratedSimulation");
+const FName FDaeTestMapInfo::TestSimulationTimeDilationTag = TEXT("DaeTestSimulationTimeDilation");
+
+FDaeTestMapInfo::FDaeTestMapInfo()
+    : TestCount(0)
+    , ParameterCount(0)
+{
+}
+
+FDaeTestMapInfo FDaeTestMapInfo::FromAssetData(const FAssetData& AssetData)
+{
+    FDaeTestMapInfo Info;
+    Info.PackageName = AssetData.PackageName;
+
+    FString TestCountString;
+
+    if (!AssetData.GetTagValue(TestCountTag, TestCountString))
+    {
+        // Map hasn't been saved with tags yet.
+        const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+            GetDefault<UDaeTestAutomationPluginSettings>();
+        Info.MetaData =
+            TestAutomationPluginSettings->TestMapsMetaData.FindRef(AssetData.AssetName.ToString());
+        return Info;
+    }
+
+    Info.TestCount = FCString::Atoi(*TestCountString);
+
+    FString TagsString;
+
+    if (AssetData.GetTagValue(TestTagsTag, TagsString))
+    {
+        TagsString.ParseIntoArray(Info.MetaData.Tags, TEXT(";"));
+    }
+
+    FString PriorityString;
+
+    if (AssetData.GetTagValue(TestPriorityTag, PriorityString))
+    {
+        Info.MetaData.Priority = static_cast<EDaeTestPriority>(FCString::Atoi(*PriorityString));
+    }
+
+    FString ExpectedErrorsString;
+
+    if (AssetData.GetTagValue(TestExpectedErrorsTag, ExpectedErrorsString))
+    {
+        TArray<TSharedPtr<FJsonValue>> ExpectedErrorValues;
+        TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ExpectedErrorsString);
+
+        if (FJsonSerializer::Deserialize(JsonReader, ExpectedErrorValues))
+        {
+            Info.MetaData.ExpectedErrors = ExpectedErrorsFromJson(ExpectedErrorValues);
+        }
+    }
+
+    FString RequiresFullTravelString;
+
+    if (AssetData.GetTagValue(TestRequiresFullTravelTag, RequiresFullTravelString))
+    {
+        Info.MetaData.bRequiresFullTravel = FCString::ToBool(*RequiresFullTravelString);
+    }
+
+    FString AcceleratedSimulationString;
+
+    if (AssetData.GetTagValue(TestAcceleratedSimulationTag, AcceleratedSimulationString))
+    {
+        Info.MetaData.bAcceleratedSimulation = FCString::ToBool(*AcceleratedSimulationString);
+    }
+
+    FString SimulationTimeDilationString;
+
+    if (AssetData.GetTagValue(TestSimulationTimeDilationTag, SimulationTimeDilationString))
+    {
+        Info.MetaData.SimulationTimeDilation = FCString::Atof(*SimulationTimeDilationString);
+    }
+
+    FString ParameterCountString;
+
+    if (AssetData.GetTagValue(TestParameterCountTag, ParameterCountString))
+    {
+        Info.ParameterCount = FCString::Atoi(*ParameterCountString);
+    }
+
+    return Info;
+}
+
+void FDaeTestMapInfo::GetWorldAssetRegistryTags(const UObject* Object,
+                                                TArray<UObject::FAssetRegistryTag>& OutTags)
+{
+    const UWorld* World = Cast<UWorld>(Object);
+
+    if (!IsValid(World) || !IsValid(World->PersistentLevel))
+    {
+        return;
+    }
+
+    // Find test suite.
+    const ADaeTestSuiteActor* TestSuite = nullptr;
+
+    for (const AActor* Actor : World->PersistentLevel->Actors)
+    {
+        if (const ADaeTestSuiteActor* TestSuiteActor = Cast<ADaeTestSuiteActor>(Actor))
+        {
+            TestSuite = TestSuiteActor;
+        }
+    }
+
+    if (TestSuite == nullptr)
+    {
+        return;
+    }
+
+    // Combine meta data of all tests.
+    FDaeTestMapMetaData MetaData;
+    MetaData.Priority = EDaeTestPriority::DTP_LowPriority;
+
+    int32 TestCount = 0;
+    int32 ParameterCount = 0;
+
+    for (const ADaeTestActor* Test : TestSuite->GetTests())
+    {
+        if (!IsValid(Test))
+        {
+            continue;
+        }
+
+        const FDaeTestMapMetaData& TestMetaData = Test->GetTestMetaData();
+
+        for (const FString& Tag : TestMetaData.Tags)
+        {
+            MetaData.Tags.AddUnique(Tag);
+        }
+
+        MetaData.Priority = FMath::Max(MetaData.Priority, TestMetaData.Priority);
+        MetaData.ExpectedErrors.Append(TestMetaData.ExpectedErrors);
+        MetaData.bRequiresFullTravel |= TestMetaData.bRequiresFullTravel;
+
+        // Whole map is simulated at the highest speed any of its tests asks for.
+        if (TestMetaData.bAcceleratedSimulation)
+        {
+            MetaData.SimulationTimeDilation =
+                MetaData.bAcceleratedSimulation
+                    ? FMath::Max(MetaData.SimulationTimeDilation, TestMetaData.SimulationTimeDilation)
+                    : TestMetaData.SimulationTimeDilation;
+            MetaData.bAcceleratedSimulation = true;
+        }
+
+        ++TestCount;
+        ParameterCount += Test->GetParameters().Num();
+    }
+
+    if (TestCount == 0)
+    {
+        MetaData.Priority = EDaeTestPriority::DTP_Default;
+    }
+
+    FString ExpectedErrorsString;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ExpectedErrorsString);
+    FJsonSerializer::Serialize(ExpectedErrorsToJson(MetaData.ExpectedErrors), JsonWriter);
+
+    OutTags.Add(UObject::FAssetRegistryTag(TestTagsTag, FString::Join(MetaData.Tags, TEXT(";")),
+                                           UObject::FAssetRegistryTag::TT_Alphabetical));
+    OutTags.Add(UObject::FAssetRegistryTag(
+        TestPriorityTag, FString::FromInt(static_cast<int32>(MetaData.Priority)),
+        UObject::FAssetRegistryTag::TT_Numerical));
+    OutTags.Add(UObject::FAssetRegistryTag(TestExpectedErrorsTag, ExpectedErrorsString,
+                                           UObject::FAssetRegistryTag::TT_Hidden));
+    OutTags.Add(UObject::FAssetRegistryTag(TestRequiresFullTravelTag,
+                                           LexToString(MetaData.bRequiresFullTravel),
+                                           UObject::FAssetRegistryTag::TT_Alphabetical));
+    OutTags.Add(UObject::FAssetRegistryTag(TestAcceleratedSimulationTag,
+                                           LexToString(MetaData.bAcceleratedSimulation),
+                                           UObject::FAssetRegistryTag::TT_Alphabetical));
+    OutTags.Add(UObject::FAssetRegistryTag(TestSimulationTimeDilationTag,
+                                           FString::SanitizeFloat(MetaData.SimulationTimeDilation),
+                                           UObject::FAssetRegistryTag::TT_Numerical));
+    OutTags.Add(UObject::FAssetRegistryTag(TestCountTag, FString::FromInt(TestCount),
+                                           UObject::FAssetRegistryTag::TT_Numerical));
+    OutTags.Add(UObject::FAssetRegistryTag(TestParameterCountTag,
+                                           FString::FromInt(ParameterCount),
+                                           UObject::FAssetRegistryTag::TT_Numerical));
+}
+
+TSharedRef<FJsonObject> FDaeTestMapInfo::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+    TArray<TSharedPtr<FJsonValue>> TagValues;
+
+    for (const FString& Tag : MetaData.Tags)
+    {
+        TagValues.Add(MakeShareable(new FJsonValueString(Tag)));
+    }
+
+    JsonObject->SetStringField(TEXT("PackageName"), PackageName.ToString());
+    JsonObject->SetArrayField(TEXT("Tags"), TagValues);
+    JsonObject->SetNumberField(TEXT("Priority"), static_cast<int32>(MetaData.Priority));
+    JsonObject->SetArrayField(TEXT("ExpectedErrors"), ExpectedErrorsToJson(MetaData.ExpectedErrors));
+    JsonObject->SetBoolField(TEXT("RequiresFullTravel"), MetaData.bRequiresFullTravel);
+    JsonObject->SetBoolField(TEXT("AcceleratedSimulation"), MetaData.bAcceleratedSimulation);
+    JsonObject->SetNumberField(TEXT("SimulationTimeDilation"), MetaData.SimulationTimeDilation);
+    JsonObject->SetNumberField(TEXT("TestCount"), TestCount);
+    JsonObject->SetNumberField(TEXT("ParameterCount"), ParameterCount);
+
+    return JsonObject;
+}
+
+FDaeTestMapInfo FDaeTestMapInfo::FromJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestMapInfo Info;
+
+    Info.PackageName = FName(*JsonObject->GetStringField(TEXT("PackageName")));
+    JsonObject->TryGetStringArrayField(TEXT("Tags"), Info.MetaData.Tags);
+    Info.MetaData.Priority =
+        static_cast<EDaeTestPriority>(JsonObject->GetIntegerField(TEXT("Priority")));
+
+    const TArray<TSharedPtr<FJsonValue>>* ExpectedErrorValues;
+
+    if (JsonObject->TryGetArrayField(TEXT("ExpectedErrors"), ExpectedErrorValues))
+    {
+        Info.MetaData.ExpectedErrors = ExpectedErrorsFromJson(*ExpectedErrorValues);
+    }
+
+    JsonObject->TryGetBoolField(TEXT("RequiresFullTravel"), Info.MetaData.bRequiresFullTravel);
+    JsonObject->TryGetBoolField(TEXT("AcceleratedSimulation"),
+                                Info.MetaData.bAcceleratedSimulation);
+
+    double SimulationTimeDilation;
+
+    if (JsonObject->TryGetNumberField(TEXT("SimulationTimeDilation"), SimulationTimeDilation))
+    {
+        Info.MetaData.SimulationTimeDilation = static_cast<float>(SimulationTimeDilation);
+    }
+
+    Info.TestCount = JsonObject->GetIntegerField(TEXT("TestCount"));
+    Info.ParameterCount = JsonObject->GetIntegerField(TEXT("ParameterCount"));
+
+    return Info;
+}
+
+TArray<TSharedPtr<FJsonValue>> FDaeTestMapInfo::ExpectedErrorsToJson(
+    const TArray<FDaeTestExpectedError>& ExpectedErrors)
+{
+    TArray<TSharedPtr<FJsonValue>> ExpectedErrorValues;
+
+    for (const FDaeTestExpectedError& ExpectedError : ExpectedErrors)
+    {
+        TSharedRef<FJsonObject> ExpectedErrorObject = MakeShareable(new FJsonObject());
+        ExpectedErrorObject->SetStringField(TEXT("ExpectedErrorPattern"),
+                                            ExpectedError.ExpectedErrorPattern);
+        ExpectedErrorObject->SetNumberField(TEXT("Occurrences"), ExpectedError.Occurrences);
+
+        ExpectedErrorValues.Add(MakeShareable(new FJsonValueObject(ExpectedErrorObject)));
+    }
+
+    return ExpectedErrorValues;
+}
+
+TArray<FDaeTestExpectedError> FDaeTestMapInfo::ExpectedErrorsFromJson(
+    const TArray<TSharedPtr<FJsonValue>>& JsonValues)
+{
+    TArray<FDaeTestExpectedError> ExpectedErrors;
+
+    for (const TSharedPtr<FJsonValue>& JsonValue : JsonValues)
+    {
+        const TSharedPtr<FJsonObject>& ExpectedErrorObject = JsonValue->AsObject();
+
+        if (!ExpectedErrorObject.IsValid())
+        {
+            continue;
+        }
+
+        FDaeTestExpectedError ExpectedError;
+        ExpectedError.ExpectedErrorPattern =
+            ExpectedErrorObject->GetStringField(TEXT("ExpectedErrorPattern"));
+        ExpectedError.Occurrences = ExpectedErrorObject->GetIntegerField(TEXT("Occurrences"));
+
+        ExpectedErrors.Add(ExpectedError);
+    }
+
+    return ExpectedErrors;
+}
@@ -0,0 +1,168 @@
+#include "DaeTestMessageChannel.h"
+#include "DaeTestLogCategory.h"
+#include <Common/TcpSocketBuilder.h>
+#include <Interfaces/IPv4/IPv4Address.h>
+#include <Interfaces/IPv4/IPv4Endpoint.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+#include <Sockets.h>
+#include <SocketSubsystem.h>
+
+FDaeTestMessageChannel::FDaeTestMessageChannel(FSocket* InSocket)
+    : Socket(InSocket)
+    , bDisconnected(false)
+{
+    Socket->SetNonBlocking(true);
+}
+
+FDaeTestMessageChannel::~FDaeTestMessageChannel()
+{
+    DestroySocket(Socket);
+}
+
+TSharedPtr<FDaeTestMessageChannel> FDaeTestMessageChannel::Connect(int32 Port)
+{
+    FSocket* Socket = FTcpSocketBuilder(TEXT("DaeTestMessageChannel")).Build();
+
+    if (Socket == nullptr)
+    {
+        return nullptr;
+    }
+
+    const FIPv4Endpoint Endpoint(FIPv4Address(127, 0, 0, 1), Port);
+
+    if (!Socket->Connect(*Endpoint.ToInternetAddr()))
+    {
+        DestroySocket(Socket);
+        return nullptr;
+    }
+
+    return MakeShareable(new FDaeTestMessageChannel(Socket));
+}
+
+FSocket* FDaeTestMessageChannel::Listen(int32 Port, const FString& Description)
+{
+    return FTcpSocketBuilder(*Description)
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToEndpoint(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port))
+        .Listening(16)
+        .Build();
+}
+
+void FDaeTestMessageChannel::DestroySocket(FSocket* Socket)
+{
+    if (Socket == nullptr)
+    {
+        return;
+    }
+
+    Socket->Close();
+    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+}
+
+bool FDaeTestMessageChannel::IsConnected() const
+{
+    // GetConnectionState isn't reliable for detecting closed connections on all platforms, so we
+    // rely on Receive and Send noticing them instead.
+    return !bDisconnected;
+}
+
+bool FDaeTestMessageChannel::Send(const TSharedRef<FJsonObject>& Message)
+{
+    FString MessageString;
+
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&MessageString);
+    FJsonSerializer::Serialize(Message, Writer);
+
+    // Condensed JSON never contains line breaks, so we can use them for separating messages.
+    MessageString += TEXT("\n");
+
+    FTCHARToUTF8 MessageUTF8(*MessageString);
+    const uint8* Data = reinterpret_cast<const uint8*>(MessageUTF8.Get());
+    int32 BytesRemaining = MessageUTF8.Length();
+
+    while (BytesRemaining > 0)
+    {
+        int32 BytesSent = 0;
+
+        if (!Socket->Send(Data, BytesRemaining, BytesSent))
+        {
+            const ESocketErrors Error =
+                ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+
+            if (Error != SE_EWOULDBLOCK)
+            {
+                bDisconnected = true;
+                return false;
+            }
+
+            // Socket buffer is full, try again.
+            FPlatformProcess::Sleep(0.001f);
+            continue;
+        }
+
+        Data += BytesSent;
+        BytesRemaining -= BytesSent;
+    }
+
+    return true;
+}
+
+TSharedPtr<FJsonObject> FDaeTestMessageChannel::Receive()
+{
+    // Read all pending data. Always try to read, even if there's no pending data: Non-blocking
+    // stream sockets succeed without reading anything if there's just nothing to read yet, but fail
+    // on a zero-byte read, which is how closed connections show up.
+    static const int32 ReadSize = 4096;
+
+    while (!bDisconnected)
+    {
+        const int32 Offset = ReceiveBuffer.Num();
+        ReceiveBuffer.AddUninitialized(ReadSize);
+
+        int32 BytesRead = 0;
+
+        if (!Socket->Recv(ReceiveBuffer.GetData() + Offset, ReadSize, BytesRead))
+        {
+            ReceiveBuffer.SetNum(Offset);
+            bDisconnected = true;
+            break;
+        }
+
+        ReceiveBuffer.SetNum(Offset + FMath::Max(BytesRead, 0));
+
+        if (BytesRead <= 0)
+        {
+            break;
+        }
+    }
+
+    // Check for complete message.
+    const int32 MessageLength = ReceiveBuffer.Find('\n');
+
+    if (MessageLength == INDEX_NONE)
+    {
+        return nullptr;
+    }
+
+    FUTF8ToTCHAR MessageTCHAR(reinterpret_cast<const ANSICHAR*>(ReceiveBuffer.GetData()),
+                              MessageLength);
+    const FString MessageString(MessageTCHAR.Length(), MessageTCHAR.Get());
+
+    ReceiveBuffer.RemoveAt(0, MessageLength + 1);
+
+    TSharedPtr<FJsonObject> Message;
+    TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(MessageString);
+
+    if (!FJsonSerializer::Deserialize(Reader, Message))
+    {
+        UE_LOG(LogDaeTest, Error, TEXT("FDaeTestMessageChannel::Receive - Invalid message: %s"),
+               *MessageString);
+        return nullptr;
+    }
+
+    return Message;
+}
@@ -0,0 +1,113 @@
+#include "DaeTestPackageDependencies.h"
+#include "DaeTestActor.h"
+#include "DaeTestTransientWorld.h"
+#include "DaeUEFeatures.h"
+#include "Settings/DaeTestAutomationPluginSettings.h"
+#include <AssetRegistryModule.h>
+#include <Misc/PackageName.h>
+#include <Misc/SecureHash.h>
+
+FDaeTestPackageDependencies::FDaeTestPackageDependencies()
+{
+    // Make sure dependencies of all assets are known.
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        AssetRegistry.SearchAllAssets(true);
+    }
+}
+
+TSet<FName> FDaeTestPackageDependencies::GetClosure(const TArray<FName>& PackageNames)
+{
+    TSet<FName> Closure;
+    TArray<FName> PackagesToVisit = PackageNames;
+
+    while (PackagesToVisit.Num() > 0)
+    {
+        const FName PackageName = PackagesToVisit.Pop(false);
+
+        bool bIsAlreadyInClosure = false;
+        Closure.Add(PackageName, &bIsAlreadyInClosure);
+
+        if (bIsAlreadyInClosure || PackageName.ToString().StartsWith(TEXT("/Script/")))
+        {
+            continue;
+        }
+
+        PackagesToVisit.Append(GetDirectDependencies(PackageName));
+    }
+
+    return Closure;
+}
+
+FString FDaeTestPackageDependencies::GetPackageHash(const FName& PackageName)
+{
+    if (const FString* CachedHash = PackageHashes.Find(PackageName))
+    {
+        return *CachedHash;
+    }
+
+    FString& Hash = PackageHashes.Add(PackageName);
+    FString Filename;
+
+#if UE_5_0_OR_LATER
+    const bool bPackageExists = FPackageName::DoesPackageExist(PackageName.ToString(), &Filename);
+#else
+    const bool bPackageExists =
+        FPackageName::DoesPackageExist(PackageName.ToString(), nullptr, &Filename);
+#endif
+
+    if (bPackageExists)
+    {
+        Hash = LexToString(FMD5Hash::HashFile(*Filename));
+    }
+
+    return Hash;
+}
+
+TArray<FName> FDaeTestPackageDependencies::GetTestMapPackages(const FName& MapName,
+                                                              const FName& PackageName)
+{
+    TArray<FName> Packages;
+
+    if (!PackageName.IsNone())
+    {
+        Packages.Add(PackageName);
+    }
+
+    if (MapName == FDaeTestTransientWorld::MapName)
+    {
+        for (const TSoftClassPtr<ADaeTestActor>& TestClass :
+             GetDefault<UDaeTestAutomationPluginSettings>()->TransientWorldTests)
+        {
+            Packages.AddUnique(FName(*TestClass.ToSoftObjectPath().GetLongPackageName()));
+        }
+    }
+
+    return Packages;
+}
+
+const TArray<FName>& FDaeTestPackageDependencies::GetDirectDependencies(const FName& PackageName)
+{
+    if (const TArray<FName>* CachedDependencies = DirectDependencies.Find(PackageName))
+    {
+        return *CachedDependencies;
+    }
+
+    TArray<FName>& Dependencies = DirectDependencies.Add(PackageName);
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+#if UE_4_26_OR_LATER
+    AssetRegistry.GetDependencies(PackageName, Dependencies,
+                                  UE::AssetRegistry::EDependencyCategory::Package);
+#else
+    AssetRegistry.GetDependencies(PackageName, Dependencies,
+                                  EAssetRegistryDependencyType::Packages);
+#endif
+
+    return Dependencies;
+}
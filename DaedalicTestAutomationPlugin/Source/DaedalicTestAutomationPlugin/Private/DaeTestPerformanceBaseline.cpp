@@ -0,0 +1,211 @@
+#include "DaeTestPerformanceBaseline.h"
+#include "DaeTestLogCategory.h"
+#include <DynamicRHI.h>
+#include <RHI.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/App.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Misc/SecureHash.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+#include <cmath>
+
+FString FDaeTestPerformanceBaseline::GetDefaultDirectory()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"),
+                           TEXT("PerformanceBaselines"));
+}
+
+FString FDaeTestPerformanceBaseline::GetMachineFingerprint()
+{
+    TArray<FString> Entries;
+
+    Entries.Add(FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Entries.Add(
+        FString::Printf(TEXT("%i cores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads()));
+    Entries.Add(FString::Printf(TEXT("%u GB"), FPlatformMemory::GetConstants().TotalPhysicalGB));
+    Entries.Add(FPlatformMisc::GetPrimaryGPUBrand().TrimStartAndEnd());
+    Entries.Add(GDynamicRHI != nullptr ? FString(GDynamicRHI->GetName()) : TEXT("NullRHI"));
+    Entries.Add(FPlatformMisc::GetOSVersion());
+    Entries.Add(LexToString(FApp::GetBuildConfiguration()));
+
+    return FString::Join(Entries, TEXT(", "));
+}
+
+FString FDaeTestPerformanceBaseline::GetFilePath(const FString& Directory, const FString& MapName,
+                                                 const FString& TestName)
+{
+    // Keep map and test readable, but machines apart.
+    const FString FingerprintHash = FMD5::HashAnsiString(*GetMachineFingerprint()).Left(8);
+    const FString FileName = FPaths::MakeValidFileName(
+        FString::Printf(TEXT("%s-%s-%s.json"), *MapName, *TestName, *FingerprintHash));
+
+    return FPaths::Combine(Directory, FileName);
+}
+
+bool FDaeTestPerformanceBaseline::Load(const FString& FilePath)
+{
+    FString BaselineString;
+
+    if (!FFileHelper::LoadFileToString(BaselineString, *FilePath))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> BaselineObject;
+    TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(BaselineString);
+
+    const TSharedPtr<FJsonObject>* FrameTimeObject;
+
+    if (!FJsonSerializer::Deserialize(JsonReader, BaselineObject) || !BaselineObject.IsValid()
+        || !BaselineObject->TryGetObjectField(TEXT("FrameTime"), FrameTimeObject))
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("FDaeTestPerformanceBaseline::Load - Unable to read baseline %s, ignoring."),
+               *FilePath);
+        return false;
+    }
+
+    MapName = BaselineObject->GetStringField(TEXT("MapName"));
+    TestName = BaselineObject->GetStringField(TEXT("TestName"));
+    MachineFingerprint = BaselineObject->GetStringField(TEXT("MachineFingerprint"));
+    BuildVersion = BaselineObject->GetStringField(TEXT("BuildVersion"));
+    FDateTime::ParseIso8601(*BaselineObject->GetStringField(TEXT("Timestamp")), Timestamp);
+    FrameTime = FDaeTestPerformanceHistogram::FromJson(FrameTimeObject->ToSharedRef());
+
+    return true;
+}
+
+bool FDaeTestPerformanceBaseline::Save(const FString& FilePath) const
+{
+    TSharedRef<FJsonObject> BaselineObject = MakeShareable(new FJsonObject());
+
+    BaselineObject->SetStringField(TEXT("MapName"), MapName);
+    BaselineObject->SetStringField(TEXT("TestName"), TestName);
+    BaselineObject->SetStringField(TEXT("MachineFingerprint"), MachineFingerprint);
+    BaselineObject->SetStringField(TEXT("BuildVersion"), BuildVersion);
+    BaselineObject->SetStringField(TEXT("Timestamp"), Timestamp.ToIso8601());
+    BaselineObject->SetObjectField(TEXT("FrameTime"), FrameTime.ToJson());
+
+    FString BaselineString;
+    TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&BaselineString);
+    FJsonSerializer::Serialize(BaselineObject, JsonWriter);
+
+    // Ensure path exists.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const FString Directory = FPaths::GetPath(FilePath);
+
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    if (!FFileHelper::SaveStringToFile(BaselineString, *FilePath))
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestPerformanceBaseline::Save - Unable to write baseline %s."), *FilePath);
+        return false;
+    }
+
+    return true;
+}
+
+FDaeTestPerformanceBaselineComparison FDaeTestPerformanceBaselineComparison::Compare(
+    const FDaeTestPerformanceBaseline& Baseline, const FDaeTestPerformanceHistogram& Current,
+    float SignificanceLevel, float RegressionThresholdPercentage)
+{
+    FDaeTestPerformanceBaselineComparison Comparison;
+
+    Comparison.bHasBaseline = true;
+    Comparison.BaselineTimestamp = Baseline.Timestamp.ToString();
+    Comparison.BaselineSampleCount = Baseline.FrameTime.Num();
+    Comparison.BaselineP50 = Baseline.FrameTime.GetPercentile(50.0f);
+    Comparison.CurrentP50 = Current.GetPercentile(50.0f);
+
+    const double N1 = Baseline.FrameTime.Num();
+    const double N2 = Current.Num();
+
+    if (N1 <= 1.0 || N2 <= 1.0)
+    {
+        return Comparison;
+    }
+
+    // Frames within the same bucket are considered ties, sharing their average rank.
+    const TArray<uint32>& BaselineCounts = Baseline.FrameTime.GetBucketCounts();
+    const TArray<uint32>& CurrentCounts = Current.GetBucketCounts();
+
+    double NumBelow = 0.0;
+    double CurrentRankSum = 0.0;
+    double TieCorrection = 0.0;
+
+    for (int32 BucketIndex = 0; BucketIndex < BaselineCounts.Num(); ++BucketIndex)
+    {
+        const double NumTies =
+            static_cast<double>(BaselineCounts[BucketIndex]) + CurrentCounts[BucketIndex];
+
+        if (NumTies <= 0.0)
+        {
+            continue;
+        }
+
+        CurrentRankSum += CurrentCounts[BucketIndex] * (NumBelow + (NumTies + 1.0) / 2.0);
+        TieCorrection += NumTies * NumTies * NumTies - NumTies;
+        NumBelow += NumTies;
+    }
+
+    const double N = N1 + N2;
+    const double U = CurrentRankSum - N2 * (N2 + 1.0) / 2.0;
+    const double Mean = N1 * N2 / 2.0;
+    const double Variance = N1 * N2 / 12.0 * ((N + 1.0) - TieCorrection / (N * (N - 1.0)));
+
+    // Normal approximation, one-sided, as we're only interested in frames getting slower.
+    const double Z = Variance > 0.0 ? (U - Mean) / FMath::Sqrt(Variance) : 0.0;
+
+    Comparison.PValue = static_cast<float>(0.5 * std::erfc(Z / FMath::Sqrt(2.0)));
+    Comparison.ProbabilityOfSlowerFrame = static_cast<float>(U / (N1 * N2));
+    Comparison.bRegression = Comparison.PValue < SignificanceLevel
+                             && Comparison.GetP50ChangePercentage() > RegressionThresholdPercentage;
+
+    return Comparison;
+}
+
+float FDaeTestPerformanceBaselineComparison::GetP50ChangePercentage() const
+{
+    return BaselineP50 > 0.0f ? (CurrentP50 / BaselineP50 - 1.0f) * 100.0f : 0.0f;
+}
+
+TSharedRef<FJsonObject> FDaeTestPerformanceBaselineComparison::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+    JsonObject->SetBoolField(TEXT("HasBaseline"), bHasBaseline);
+    JsonObject->SetStringField(TEXT("BaselineTimestamp"), BaselineTimestamp);
+    JsonObject->SetNumberField(TEXT("BaselineSampleCount"), BaselineSampleCount);
+    JsonObject->SetNumberField(TEXT("BaselineP50"), BaselineP50);
+    JsonObject->SetNumberField(TEXT("CurrentP50"), CurrentP50);
+    JsonObject->SetNumberField(TEXT("PValue"), PValue);
+    JsonObject->SetNumberField(TEXT("ProbabilityOfSlowerFrame"), ProbabilityOfSlowerFrame);
+    JsonObject->SetBoolField(TEXT("Regression"), bRegression);
+
+    return JsonObject;
+}
+
+FDaeTestPerformanceBaselineComparison FDaeTestPerformanceBaselineComparison::FromJson(
+    const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestPerformanceBaselineComparison Comparison;
+
+    Comparison.bHasBaseline = JsonObject->GetBoolField(TEXT("HasBaseline"));
+    Comparison.BaselineTimestamp = JsonObject->GetStringField(TEXT("BaselineTimestamp"));
+    Comparison.BaselineSampleCount = JsonObject->GetIntegerField(TEXT("BaselineSampleCount"));
+    Comparison.BaselineP50 = JsonObject->GetNumberField(TEXT("BaselineP50"));
+    Comparison.CurrentP50 = JsonObject->GetNumberField(TEXT("CurrentP50"));
+    Comparison.PValue = JsonObject->GetNumberField(TEXT("PValue"));
+    Comparison.ProbabilityOfSlowerFrame =
+        JsonObject->GetNumberField(TEXT("ProbabilityOfSlowerFrame"));
+    Comparison.bRegression = JsonObject->GetBoolField(TEXT("Regression"));
+
+    return Comparison;
+}
@@ -2,20 +2,28 @@
 #include "DaeTestAssertBlueprintFunctionLibrary.h"
 #include "DaeTestLogCategory.h"
 #include "DaeTestPerformanceBudgetResultData.h"
+#include "DaeTestPerformanceCounterSummary.h"
 #include "DaeTestReportWriterPerformance.h"
 #include "DaeUEFeatures.h"
+#include "Settings/DaeTestAutomationPluginSettings.h"
 #include <EngineGlobals.h>
 #include <RenderCore.h>
+#include <RHI.h>
 #include <UnrealClient.h>
 #include <Engine/Engine.h>
 #include <Engine/GameViewportClient.h>
+#include <Engine/LevelStreaming.h>
 #include <Engine/TargetPoint.h>
 #include <Engine/World.h>
 #include <GameFramework/DefaultPawn.h>
 #include <GameFramework/GameModeBase.h>
 #include <GameFramework/PlayerController.h>
+#include <HAL/MemoryMisc.h>
 #include <Kismet/GameplayStatics.h>
 #include <Kismet/KismetMathLibrary.h>
+#include <Misc/App.h>
+#include <Misc/Paths.h>
+#include <UObject/UObjectArray.h>
 
 #if WITH_ENGINE
 // Imported from UnrealClient.cpp.
@@ -44,6 +52,15 @@ ADaeTestPerformanceBudgetActor::ADaeTestPerformanceBudgetActor(
     RenderThreadBudget = 20.0f;
     GPUBudget = 20.0f;
 
+    PhysicalMemoryBudget = 0.0f;
+    VirtualMemoryBudget = 0.0f;
+    UObjectCountBudget = 0;
+    MemorySampleInterval = 0.5f;
+
+    bCompareWithBaseline = true;
+    BaselineSignificanceLevel = 0.01f;
+    BaselineRegressionThreshold = 5.0f;
+
     bIncludeInDefaultTestReport = true;
 }
 
@@ -53,6 +70,9 @@ void ADaeTestPerformanceBudgetActor::BeginPlay()
 
     bIsRunning = false;
     bIsRecording = false;
+
+    // Without rendering (e.g. -nullrhi), there's no viewport to gather stats from or take screenshots of.
+    bIsRendering = !GUsingNullRHI && IsValid(GetWorld()->GetGameViewport());
 }
 
 void ADaeTestPerformanceBudgetActor::NotifyOnArrange(UObject* Parameter)
@@ -63,6 +83,48 @@ void ADaeTestPerformanceBudgetActor::NotifyOnArrange(UObject* Parameter)
 	CurrentTargetPointIndex = 0;
 	LastBudgetViolationTime = 0.0f;
 	BudgetViolations.Empty();
+    NumBudgetViolationsWithoutRules = 0;
+    bIsSampling = false;
+    MemoryViolations.Empty();
+    ReportedMemoryViolations.Empty();
+    LastMemorySampleTime = -1.0f;
+    UsedPhysicalMemory = 0.0f;
+    UsedVirtualMemory = 0.0f;
+    UObjectCount = 0;
+    FrameTimeHistogram = FDaeTestPerformanceHistogram();
+    BaselineComparison = FDaeTestPerformanceBaselineComparison();
+
+    // Write a new capture file for each test run, keeping some previous ones for comparison.
+    const FString CaptureDirectory = FDaeTestPerformanceCapture::GetDefaultDirectory();
+    const int32 MaxPerformanceCaptures =
+        GetDefault<UDaeTestAutomationPluginSettings>()->MaxPerformanceCaptures;
+
+    if (MaxPerformanceCaptures > 0)
+    {
+        FDaeTestPerformanceCapture::DeleteOldCaptures(CaptureDirectory, MaxPerformanceCaptures - 1);
+    }
+
+    const FString CaptureFileName = FString::Printf(
+        TEXT("%s-%s%s"), *GetName(), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S-%s")),
+        *FDaeTestPerformanceCapture::FileExtension);
+    Capture.Open(FPaths::Combine(CaptureDirectory, CaptureFileName));
+
+    BudgetRuleEvaluators.Empty();
+    LegBudgetRuleEvaluators.Empty();
+
+    AddBudgetRuleEvaluators(BudgetRules, BudgetRuleEvaluators);
+
+    for (int32 TargetPointIndex = 0; TargetPointIndex < FlightPath.Num(); ++TargetPointIndex)
+    {
+        const FDaeTestPerformanceLegBudget* LegBudget = FindLegBudget(TargetPointIndex);
+
+        // Legs without budget rules of their own are checked against the ones of the test.
+        if (LegBudget != nullptr && LegBudget->BudgetRules.Num() > 0)
+        {
+            AddBudgetRuleEvaluators(LegBudget->BudgetRules,
+                                    LegBudgetRuleEvaluators.Add(TargetPointIndex));
+        }
+    }
 
     // Spawn flying pawn.
     APlayerController* Player = UGameplayStatics::GetPlayerController(this, 0);
@@ -109,15 +171,97 @@ void ADaeTestPerformanceBudgetActor::NotifyOnArrange(UObject* Parameter)
 
 void ADaeTestPerformanceBudgetActor::ReceiveOnAct_Implementation(UObject* Parameter)
 {
+    if (!bIsRendering)
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("%s can't measure render thread and GPU times without rendering, only checking "
+                    "game thread budget."),
+               *GetName());
+    }
+
     bIsRunning = true;
 }
 
 void ADaeTestPerformanceBudgetActor::NotifyOnAssert(UObject* Parameter)
 {
+    // Flush remaining samples, e.g. after a timeout, so that results can be collected from the capture file.
+    Capture.Close();
+
     Super::NotifyOnAssert(Parameter);
 
-    UDaeTestAssertBlueprintFunctionLibrary::AssertEqualInt32(BudgetViolations.Num(), 0,
+    // Replace baseline instead of comparing with it, e.g. after an intended change in performance.
+    const bool bUpdateBaseline =
+        bCompareWithBaseline
+        && FParse::Param(FCommandLine::Get(), TEXT("UpdatePerformanceBaseline"));
+
+    if (bCompareWithBaseline && !bUpdateBaseline)
+    {
+        CompareWithBaseline();
+    }
+
+    AssertBudgets();
+
+    // Failed or incomplete runs don't tell how this test is supposed to perform.
+    if (bUpdateBaseline && !bHasResult && !bHadTimeout)
+    {
+        UpdateBaseline();
+    }
+}
+
+void ADaeTestPerformanceBudgetActor::AssertBudgets()
+{
+    // Memory budgets are hard limits, independent of any budget rules.
+    UDaeTestAssertBlueprintFunctionLibrary::AssertEqualInt32(
+        MemoryViolations.Num(), 0, TEXT("Memory Budget Violations"), this);
+
+    // Single frames only fail the test on legs that aren't checked by budget rules instead.
+    UDaeTestAssertBlueprintFunctionLibrary::AssertEqualInt32(NumBudgetViolationsWithoutRules, 0,
                                                              TEXT("Budget Violations"), this);
+
+    // Report all failed rules at once.
+    TArray<FString> RuleViolations;
+
+    for (const FDaeTestPerformanceBudgetRuleEvaluator& BudgetRuleEvaluator : BudgetRuleEvaluators)
+    {
+        FString RuleViolation;
+
+        if (!BudgetRuleEvaluator.Evaluate(RuleViolation))
+        {
+            UE_LOG(LogDaeTest, Warning, TEXT("Performance budget rule violated: %s"),
+                   *RuleViolation);
+
+            RuleViolations.Add(RuleViolation);
+        }
+    }
+
+    for (const auto& LegEvaluators : LegBudgetRuleEvaluators)
+    {
+        for (const FDaeTestPerformanceBudgetRuleEvaluator& BudgetRuleEvaluator :
+             LegEvaluators.Value)
+        {
+            FString RuleViolation;
+
+            if (!BudgetRuleEvaluator.Evaluate(RuleViolation))
+            {
+                RuleViolation = FString::Printf(
+                    TEXT("%s -> %s: %s"), *GetTargetPointName(LegEvaluators.Key - 1),
+                    *GetTargetPointName(LegEvaluators.Key), *RuleViolation);
+
+                UE_LOG(LogDaeTest, Warning, TEXT("Performance budget rule violated: %s"),
+                       *RuleViolation);
+
+                RuleViolations.Add(RuleViolation);
+            }
+        }
+    }
+
+    if (RuleViolations.Num() > 0)
+    {
+        UDaeTestAssertBlueprintFunctionLibrary::AssertFail(
+            FString::Printf(TEXT("Performance budget rules violated: %s"),
+                            *FString::Join(RuleViolations, TEXT("; "))),
+            this);
+    }
 }
 
 void ADaeTestPerformanceBudgetActor::Tick(float DeltaSeconds)
@@ -213,26 +357,80 @@ void ADaeTestPerformanceBudgetActor::Tick(float DeltaSeconds)
             }
         }
 
-        // Check performance.
-        if (bIsRecording && !bJustBeganRecording)
+        // Record performance counters of every frame, starting with the frame after recording began first.
+        const FStatUnitData* StatUnitData = nullptr;
+        float GameThreadTime = 0.0f;
+        float RenderThreadTime = 0.0f;
+        float GPUTime = 0.0f;
+
+        if (bIsSampling)
         {
-            const FStatUnitData* StatUnitData = World->GetGameViewport()->GetStatUnitData();
+            StatUnitData = bIsRendering ? World->GetGameViewport()->GetStatUnitData() : nullptr;
 
-            const float GameThreadTime = StatUnitData->GameThreadTime;
-            const float RenderThreadTime = StatUnitData->RenderThreadTime;
+            GameThreadTime = GetGameThreadTime();
+
+            UpdateMemoryCounters(Time, Pawn->GetActorLocation());
+
+            FDaeTestPerformanceSample Sample;
+            Sample.TimeSeconds = Time;
+            Sample.FrameTime = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+            Sample.GameThreadTime = GameThreadTime;
+            Sample.Location = Pawn->GetActorLocation();
+            Sample.TargetPointIndex = CurrentTargetPointIndex;
+            Sample.UsedPhysicalMemory = UsedPhysicalMemory;
+            Sample.UsedVirtualMemory = UsedVirtualMemory;
+            Sample.UObjectCount = UObjectCount;
+
+            if (StatUnitData != nullptr)
+            {
+                RenderThreadTime = StatUnitData->RenderThreadTime;
 
 #if UE_4_26_OR_LATER
-            const float GPUTime = StatUnitData->GPUFrameTime[0];
+                GPUTime = StatUnitData->GPUFrameTime[0];
 #else
-            const float GPUTime = StatUnitData->GPUFrameTime;
+                GPUTime = StatUnitData->GPUFrameTime;
 #endif
 
-            const bool bGameThreadTimeOK =
-                ValidatePerformanceCounter(GameThreadTime, GameThreadBudget, TEXT("Game"));
-            const bool bRenderThreadTimeOK =
-                ValidatePerformanceCounter(RenderThreadTime, RenderThreadBudget, TEXT("Draw"));
-            const bool bGPUThreadTimeOK =
-                ValidatePerformanceCounter(GPUTime, GPUBudget, TEXT("GPU"));
+                Sample.FrameTime = StatUnitData->FrameTime;
+                Sample.RenderThreadTime = RenderThreadTime;
+                Sample.GPUTime = GPUTime;
+            }
+
+            Capture.Add(Sample);
+            FrameTimeHistogram.Add(Sample.FrameTime);
+
+            // Legs with their own budgets are checked separately.
+            TArray<FDaeTestPerformanceBudgetRuleEvaluator>* Evaluators =
+                LegBudgetRuleEvaluators.Find(CurrentTargetPointIndex);
+
+            if (Evaluators == nullptr)
+            {
+                Evaluators = &BudgetRuleEvaluators;
+            }
+
+            for (FDaeTestPerformanceBudgetRuleEvaluator& BudgetRuleEvaluator : *Evaluators)
+            {
+                BudgetRuleEvaluator.Add(Sample);
+            }
+        }
+
+        bIsSampling = bIsSampling || bJustBeganRecording;
+
+        // Check performance.
+        if (bIsRecording && !bJustBeganRecording)
+        {
+            const FDaeTestPerformanceLegBudget* LegBudget = FindLegBudget(CurrentTargetPointIndex);
+
+            const bool bGameThreadTimeOK = ValidatePerformanceCounter(
+                GameThreadTime,
+                LegBudget != nullptr ? LegBudget->GameThreadBudget : GameThreadBudget,
+                TEXT("Game"));
+            const bool bRenderThreadTimeOK = ValidatePerformanceCounter(
+                RenderThreadTime,
+                LegBudget != nullptr ? LegBudget->RenderThreadBudget : RenderThreadBudget,
+                TEXT("Draw"));
+            const bool bGPUThreadTimeOK = ValidatePerformanceCounter(
+                GPUTime, LegBudget != nullptr ? LegBudget->GPUBudget : GPUBudget, TEXT("GPU"));
 
             if (!bGameThreadTimeOK || !bRenderThreadTimeOK || !bGPUThreadTimeOK)
             {
@@ -240,43 +438,38 @@ void ADaeTestPerformanceBudgetActor::Tick(float DeltaSeconds)
 
                 LastBudgetViolationTime = Time;
 
-                FScreenshotRequest::RequestScreenshot(true);
+                if (bIsRendering)
+                {
+                    FScreenshotRequest::RequestScreenshot(true);
 
-                UE_LOG(LogDaeTest, Log, TEXT("Writing screenshot to: %s"),
-                       *FScreenshotRequest::GetFilename());
+                    UE_LOG(LogDaeTest, Log, TEXT("Writing screenshot to: %s"),
+                           *FScreenshotRequest::GetFilename());
+                }
 
                 // Add budget violation.
                 FDaeTestPerformanceBudgetViolation BudgetViolation;
 
-                if (FlightPath.IsValidIndex(CurrentTargetPointIndex - 1))
-                {
-                    BudgetViolation.PreviousTargetPointName =
-                        FlightPath[CurrentTargetPointIndex - 1]->GetName();
-                }
-                else
-                {
-                    BudgetViolation.PreviousTargetPointName = TEXT("n/a");
-                }
-
-                if (FlightPath.IsValidIndex(CurrentTargetPointIndex))
-                {
-                    BudgetViolation.NextTargetPointName =
-                        FlightPath[CurrentTargetPointIndex]->GetName();
-                }
-                else
-                {
-                    BudgetViolation.NextTargetPointName = TEXT("n/a");
-                }
+                BudgetViolation.PreviousTargetPointName =
+                    GetTargetPointName(CurrentTargetPointIndex - 1);
+                BudgetViolation.NextTargetPointName = GetTargetPointName(CurrentTargetPointIndex);
 
                 BudgetViolation.CurrentLocation = Pawn->GetActorLocation();
                 BudgetViolation.FPS =
-                    GAverageFPS > 0.0f ? GAverageFPS : (1.0f / (StatUnitData->FrameTime / 1000.0f));
+                    GAverageFPS > 0.0f || StatUnitData == nullptr
+                        ? GAverageFPS
+                        : (1.0f / (StatUnitData->FrameTime / 1000.0f));
                 BudgetViolation.GameThreadTime = GameThreadTime;
                 BudgetViolation.RenderThreadTime = RenderThreadTime;
                 BudgetViolation.GPUTime = GPUTime;
-                BudgetViolation.ScreenshotPath = FScreenshotRequest::GetFilename();
+                BudgetViolation.ScreenshotPath =
+                    bIsRendering ? FScreenshotRequest::GetFilename() : FString();
 
                 BudgetViolations.Add(BudgetViolation);
+
+                if (!HasBudgetRules(CurrentTargetPointIndex))
+                {
+                    ++NumBudgetViolationsWithoutRules;
+                }
             }
         }
     }
@@ -287,6 +480,7 @@ void ADaeTestPerformanceBudgetActor::Tick(float DeltaSeconds)
         UE_LOG(LogDaeTest, Log, TEXT("%s has finished."), *GetName());
 
         EndRecording();
+        Capture.Close();
 
         FinishAct();
     }
@@ -298,6 +492,118 @@ TSharedPtr<FDaeTestResultData> ADaeTestPerformanceBudgetActor::CollectResults()
         MakeShareable(new FDaeTestPerformanceBudgetResultData());
 
     Results->BudgetViolations = BudgetViolations;
+    Results->MemoryViolations = MemoryViolations;
+    Results->AllocatorStats = GetAllocatorStats();
+
+    Results->CaptureFilePath = Capture.GetFilePath();
+    Results->BaselineComparison = BaselineComparison;
+
+    FDaeTestPerformanceCaptureReader CaptureReader;
+
+    if (!CaptureReader.Open(Capture.GetFilePath()))
+    {
+        return Results;
+    }
+
+    // Stream all samples from disk, summarizing the whole flight and each leg in constant memory.
+    FDaeTestPerformanceCounterSummaryBuilder FrameTime;
+    FDaeTestPerformanceCounterSummaryBuilder GameThreadTime;
+    FDaeTestPerformanceCounterSummaryBuilder RenderThreadTime;
+    FDaeTestPerformanceCounterSummaryBuilder GPUTime;
+
+    TUniquePtr<FDaeTestPerformanceCounterSummaryBuilder> LegFrameTime;
+    TUniquePtr<FDaeTestPerformanceCounterSummaryBuilder> LegGameThreadTime;
+    TUniquePtr<FDaeTestPerformanceCounterSummaryBuilder> LegRenderThreadTime;
+    TUniquePtr<FDaeTestPerformanceCounterSummaryBuilder> LegGPUTime;
+
+    FDaeTestPerformanceLegResult Leg;
+    int32 LegTargetPointIndex = INDEX_NONE;
+    float LegStartTimeSeconds = 0.0f;
+    float LegEndTimeSeconds = 0.0f;
+
+    auto FinishLeg = [&]() {
+        if (Leg.SampleCount <= 0)
+        {
+            return;
+        }
+
+        Leg.DurationSeconds = LegEndTimeSeconds - LegStartTimeSeconds;
+        Leg.FrameTime = LegFrameTime->ToSummary();
+        Leg.GameThreadTime = LegGameThreadTime->ToSummary();
+
+        // Without rendering, render thread and GPU times are unknown, rather than zero.
+        if (bIsRendering)
+        {
+            Leg.RenderThreadTime = LegRenderThreadTime->ToSummary();
+            Leg.GPUTime = LegGPUTime->ToSummary();
+        }
+
+        Results->Legs.Add(Leg);
+    };
+
+    CaptureReader.ForEachSample([&](const FDaeTestPerformanceSample& Sample) {
+        // Samples of each leg are contiguous, as the pawn flies from one target point to the next.
+        if (Sample.TargetPointIndex != LegTargetPointIndex)
+        {
+            FinishLeg();
+
+            Leg = FDaeTestPerformanceLegResult();
+            Leg.PreviousTargetPointName = GetTargetPointName(Sample.TargetPointIndex - 1);
+            Leg.NextTargetPointName = GetTargetPointName(Sample.TargetPointIndex);
+
+            LegTargetPointIndex = Sample.TargetPointIndex;
+            LegStartTimeSeconds = Sample.TimeSeconds;
+
+            LegFrameTime = MakeUnique<FDaeTestPerformanceCounterSummaryBuilder>();
+            LegGameThreadTime = MakeUnique<FDaeTestPerformanceCounterSummaryBuilder>();
+            LegRenderThreadTime = MakeUnique<FDaeTestPerformanceCounterSummaryBuilder>();
+            LegGPUTime = MakeUnique<FDaeTestPerformanceCounterSummaryBuilder>();
+        }
+
+        ++Results->SampleCount;
+        FrameTime.Add(Sample.FrameTime);
+        GameThreadTime.Add(Sample.GameThreadTime);
+        RenderThreadTime.Add(Sample.RenderThreadTime);
+        GPUTime.Add(Sample.GPUTime);
+
+        if (Sample.UsedPhysicalMemory > Results->PeakUsedPhysicalMemory)
+        {
+            Results->PeakUsedPhysicalMemory = Sample.UsedPhysicalMemory;
+            Results->PeakUsedPhysicalMemoryLocation = Sample.Location;
+        }
+
+        Results->PeakUsedVirtualMemory =
+            FMath::Max(Results->PeakUsedVirtualMemory, Sample.UsedVirtualMemory);
+        Results->PeakUObjectCount = FMath::Max(Results->PeakUObjectCount, Sample.UObjectCount);
+
+        ++Leg.SampleCount;
+        Leg.PeakUsedPhysicalMemory =
+            FMath::Max(Leg.PeakUsedPhysicalMemory, Sample.UsedPhysicalMemory);
+        Leg.PeakUsedVirtualMemory = FMath::Max(Leg.PeakUsedVirtualMemory, Sample.UsedVirtualMemory);
+        Leg.PeakUObjectCount = FMath::Max(Leg.PeakUObjectCount, Sample.UObjectCount);
+        LegEndTimeSeconds = Sample.TimeSeconds;
+        LegFrameTime->Add(Sample.FrameTime);
+        LegGameThreadTime->Add(Sample.GameThreadTime);
+        LegRenderThreadTime->Add(Sample.RenderThreadTime);
+        LegGPUTime->Add(Sample.GPUTime);
+    });
+
+    FinishLeg();
+
+    Results->FrameTime = FrameTime.ToSummary();
+    Results->GameThreadTime = GameThreadTime.ToSummary();
+
+    if (bIsRendering)
+    {
+        Results->RenderThreadTime = RenderThreadTime.ToSummary();
+        Results->GPUTime = GPUTime.ToSummary();
+    }
+
+    // Show where to optimize first.
+    Results->Legs.StableSort([](const FDaeTestPerformanceLegResult& A,
+                                const FDaeTestPerformanceLegResult& B) {
+        return A.GetCost() > B.GetCost();
+    });
 
     return Results;
 }
@@ -318,11 +624,14 @@ FDaeTestReportWriterSet ADaeTestPerformanceBudgetActor::GetReportWriters() const
 
 void ADaeTestPerformanceBudgetActor::BeginRecording()
 {
-    UWorld* World = GetWorld();
-
     // Ensure we're recording engine stats.
-    GEngine->SetEngineStat(World, World->GetGameViewport(), TEXT("FPS"), true);
-    GEngine->SetEngineStat(World, World->GetGameViewport(), TEXT("Unit"), true);
+    if (bIsRendering)
+    {
+        UWorld* World = GetWorld();
+
+        GEngine->SetEngineStat(World, World->GetGameViewport(), TEXT("FPS"), true);
+        GEngine->SetEngineStat(World, World->GetGameViewport(), TEXT("Unit"), true);
+    }
 
     bIsRecording = true;
 }
@@ -332,6 +641,251 @@ void ADaeTestPerformanceBudgetActor::EndRecording()
     bIsRecording = false;
 }
 
+FString ADaeTestPerformanceBudgetActor::GetTargetPointName(int32 TargetPointIndex) const
+{
+    return FlightPath.IsValidIndex(TargetPointIndex) && IsValid(FlightPath[TargetPointIndex])
+               ? FlightPath[TargetPointIndex]->GetName()
+               : TEXT("n/a");
+}
+
+const FDaeTestPerformanceLegBudget* ADaeTestPerformanceBudgetActor::FindLegBudget(
+    int32 TargetPointIndex) const
+{
+    if (!FlightPath.IsValidIndex(TargetPointIndex) || FlightPath[TargetPointIndex] == nullptr)
+    {
+        return nullptr;
+    }
+
+    const ATargetPoint* TargetPoint = FlightPath[TargetPointIndex];
+
+    return LegBudgets.FindByPredicate([TargetPoint](const FDaeTestPerformanceLegBudget& LegBudget) {
+        return LegBudget.TargetPoint == TargetPoint;
+    });
+}
+
+bool ADaeTestPerformanceBudgetActor::HasBudgetRules(int32 TargetPointIndex) const
+{
+    const TArray<FDaeTestPerformanceBudgetRuleEvaluator>* Evaluators =
+        LegBudgetRuleEvaluators.Find(TargetPointIndex);
+
+    if (Evaluators == nullptr)
+    {
+        Evaluators = &BudgetRuleEvaluators;
+    }
+
+    return Evaluators->Num() > 0;
+}
+
+void ADaeTestPerformanceBudgetActor::AddBudgetRuleEvaluators(
+    const TArray<FDaeTestPerformanceBudgetRule>& Rules,
+    TArray<FDaeTestPerformanceBudgetRuleEvaluator>& OutEvaluators) const
+{
+    for (const FDaeTestPerformanceBudgetRule& BudgetRule : Rules)
+    {
+        if (!bIsRendering && (BudgetRule.Counter == EDaeTestPerformanceCounter::RenderThreadTime
+                              || BudgetRule.Counter == EDaeTestPerformanceCounter::GPUTime))
+        {
+            UE_LOG(LogDaeTest, Warning,
+                   TEXT("%s can't measure %s times without rendering, skipping budget rule."),
+                   *GetName(), *FDaeTestPerformanceBudgetRule::GetCounterName(BudgetRule.Counter));
+            continue;
+        }
+
+        OutEvaluators.Add(FDaeTestPerformanceBudgetRuleEvaluator(BudgetRule));
+    }
+}
+
+FString ADaeTestPerformanceBudgetActor::GetBaselinePath(FString& OutMapName,
+                                                        FString& OutTestName) const
+{
+    FString BaselineDirectory;
+
+    if (!FParse::Value(FCommandLine::Get(), TEXT("PerformanceBaselinePath="), BaselineDirectory))
+    {
+        BaselineDirectory = FDaeTestPerformanceBaseline::GetDefaultDirectory();
+    }
+
+    // Key by the package of the test map, which stays the same when it's streamed into another world.
+    OutMapName = GetLevel()->GetOutermost()->GetName();
+
+    for (const ULevelStreaming* StreamingLevel : GetWorld()->GetStreamingLevels())
+    {
+        // Level instances are loaded into packages with unique names.
+        if (IsValid(StreamingLevel) && StreamingLevel->GetLoadedLevel() == GetLevel()
+            && !StreamingLevel->PackageNameToLoad.IsNone())
+        {
+            OutMapName = StreamingLevel->PackageNameToLoad.ToString();
+        }
+    }
+
+    OutMapName = UWorld::RemovePIEPrefix(OutMapName);
+
+    const UObject* Parameter = GetCurrentParameter();
+    OutTestName = IsValid(Parameter)
+                      ? FString::Printf(TEXT("%s-%s"), *GetName(), *Parameter->GetName())
+                      : GetName();
+
+    return FDaeTestPerformanceBaseline::GetFilePath(BaselineDirectory, OutMapName, OutTestName);
+}
+
+void ADaeTestPerformanceBudgetActor::UpdateBaseline()
+{
+    FString MapName;
+    FString TestName;
+    const FString BaselinePath = GetBaselinePath(MapName, TestName);
+
+    FDaeTestPerformanceBaseline Baseline;
+    Baseline.MapName = MapName;
+    Baseline.TestName = TestName;
+    Baseline.MachineFingerprint = FDaeTestPerformanceBaseline::GetMachineFingerprint();
+    Baseline.BuildVersion = FApp::GetBuildVersion();
+    Baseline.Timestamp = FDateTime::UtcNow();
+    Baseline.FrameTime = FrameTimeHistogram;
+
+    if (Baseline.Save(BaselinePath))
+    {
+        UE_LOG(LogDaeTest, Display, TEXT("Updated performance baseline: %s"), *BaselinePath);
+    }
+}
+
+void ADaeTestPerformanceBudgetActor::CompareWithBaseline()
+{
+    FString MapName;
+    FString TestName;
+    const FString BaselinePath = GetBaselinePath(MapName, TestName);
+
+    FDaeTestPerformanceBaseline Baseline;
+
+    if (!Baseline.Load(BaselinePath))
+    {
+        UE_LOG(LogDaeTest, Log,
+               TEXT("No performance baseline for %s on this machine (%s), skipping comparison."),
+               *TestName, *FDaeTestPerformanceBaseline::GetMachineFingerprint());
+        return;
+    }
+
+    BaselineComparison = FDaeTestPerformanceBaselineComparison::Compare(
+        Baseline, FrameTimeHistogram, BaselineSignificanceLevel, BaselineRegressionThreshold);
+
+    const FString ComparisonString = FString::Printf(
+        TEXT("Median frame time %.2f ms vs. %.2f ms of baseline from %s (%+.1f%%, p = %g)"),
+        BaselineComparison.CurrentP50, BaselineComparison.BaselineP50,
+        *BaselineComparison.BaselineTimestamp, BaselineComparison.GetP50ChangePercentage(),
+        BaselineComparison.PValue);
+
+    UE_LOG(LogDaeTest, Display, TEXT("%s: %s"), *TestName, *ComparisonString);
+
+    if (BaselineComparison.bRegression)
+    {
+        UDaeTestAssertBlueprintFunctionLibrary::AssertFail(
+            FString::Printf(TEXT("Performance regressed: %s"), *ComparisonString), this);
+    }
+}
+
+void ADaeTestPerformanceBudgetActor::UpdateMemoryCounters(float Time, const FVector& Location)
+{
+    if (LastMemorySampleTime >= 0.0f && Time < LastMemorySampleTime + MemorySampleInterval)
+    {
+        return;
+    }
+
+    LastMemorySampleTime = Time;
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    UsedPhysicalMemory = MemoryStats.UsedPhysical / (1024.0f * 1024.0f);
+    UsedVirtualMemory = MemoryStats.UsedVirtual / (1024.0f * 1024.0f);
+    UObjectCount = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+    // Legs with their own budgets override the ones of the test.
+    const FDaeTestPerformanceLegBudget* LegBudget = FindLegBudget(CurrentTargetPointIndex);
+
+    const float PhysicalBudget = LegBudget != nullptr && LegBudget->PhysicalMemoryBudget > 0.0f
+                                     ? LegBudget->PhysicalMemoryBudget
+                                     : PhysicalMemoryBudget;
+    const float VirtualBudget = LegBudget != nullptr && LegBudget->VirtualMemoryBudget > 0.0f
+                                    ? LegBudget->VirtualMemoryBudget
+                                    : VirtualMemoryBudget;
+    const int32 ObjectBudget = LegBudget != nullptr && LegBudget->UObjectCountBudget > 0
+                                   ? LegBudget->UObjectCountBudget
+                                   : UObjectCountBudget;
+
+    ValidateMemoryCounter(UsedPhysicalMemory, PhysicalBudget, TEXT("Physical Memory"), false,
+                          Location);
+    ValidateMemoryCounter(UsedVirtualMemory, VirtualBudget, TEXT("Virtual Memory"), false,
+                          Location);
+    ValidateMemoryCounter(static_cast<float>(UObjectCount), static_cast<float>(ObjectBudget),
+                          TEXT("UObjects"), true, Location);
+}
+
+void ADaeTestPerformanceBudgetActor::ValidateMemoryCounter(float Value, float Budget,
+                                                           const FString& Name,
+                                                           bool bIsObjectCount,
+                                                           const FVector& Location)
+{
+    if (Budget <= 0.0f || Value <= Budget)
+    {
+        return;
+    }
+
+    // Memory usually stays up for a while, so report each counter once per leg.
+    const FString ViolationKey = FString::Printf(TEXT("%i-%s"), CurrentTargetPointIndex, *Name);
+
+    if (ReportedMemoryViolations.Contains(ViolationKey))
+    {
+        return;
+    }
+
+    ReportedMemoryViolations.Add(ViolationKey);
+
+    UE_LOG(LogDaeTest, Warning, TEXT("Memory budget violated: %s - Budget: %f, Value: %f"), *Name,
+           Budget, Value);
+
+    FDaeTestPerformanceMemoryViolation MemoryViolation;
+
+    MemoryViolation.PreviousTargetPointName = GetTargetPointName(CurrentTargetPointIndex - 1);
+    MemoryViolation.NextTargetPointName = GetTargetPointName(CurrentTargetPointIndex);
+    MemoryViolation.CurrentLocation = Location;
+    MemoryViolation.Counter = Name;
+    MemoryViolation.bIsObjectCount = bIsObjectCount;
+    MemoryViolation.Value = Value;
+    MemoryViolation.Budget = Budget;
+    MemoryViolation.AllocatorStats = GetAllocatorStats();
+
+    MemoryViolations.Add(MemoryViolation);
+}
+
+TMap<FString, uint64> ADaeTestPerformanceBudgetActor::GetAllocatorStats()
+{
+    TMap<FString, uint64> AllocatorStats;
+
+    if (GMalloc == nullptr)
+    {
+        return AllocatorStats;
+    }
+
+    // Available stats depend on the allocator, e.g. binned or ansi.
+    FGenericMemoryStats MemoryStats;
+    GMalloc->GetAllocatorStats(MemoryStats);
+
+    for (const auto& Stat : MemoryStats.Data)
+    {
+        AllocatorStats.Add(FString(Stat.Key), Stat.Value);
+    }
+
+    return AllocatorStats;
+}
+
+float ADaeTestPerformanceBudgetActor::GetGameThreadTime() const
+{
+    if (bIsRendering)
+    {
+        return GetWorld()->GetGameViewport()->GetStatUnitData()->GameThreadTime;
+    }
+
+    // Stat unit data is only updated when drawing the viewport, so read the raw game thread time instead.
+    return FPlatformTime::ToMilliseconds(GGameThreadTime);
+}
+
 bool ADaeTestPerformanceBudgetActor::ValidatePerformanceCounter(float Time, float Budget,
                                                                 const FString& Name)
 {
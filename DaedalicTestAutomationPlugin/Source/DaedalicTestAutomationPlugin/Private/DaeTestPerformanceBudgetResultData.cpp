@@ -4,3 +4,369 @@ FName FDaeTestPerformanceBudgetResultData::GetDataType() const
 {
     return TEXT("FDaeTestPerformanceBudgetResultData");
 }
+
+TSharedRef<FJsonObject> FDaeTestPerformanceBudgetResultData::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = FDaeTestResultData::ToJson();
+
+    TArray<TSharedPtr<FJsonValue>> BudgetViolationValues;
+
+    for (const FDaeTestPerformanceBudgetViolation& BudgetViolation : BudgetViolations)
+    {
+        TSharedRef<FJsonObject> BudgetViolationObject = MakeShareable(new FJsonObject());
+
+        BudgetViolationObject->SetStringField(TEXT("PreviousTargetPointName"),
+                                              BudgetViolation.PreviousTargetPointName);
+        BudgetViolationObject->SetStringField(TEXT("NextTargetPointName"),
+                                              BudgetViolation.NextTargetPointName);
+        BudgetViolationObject->SetArrayField(
+            TEXT("CurrentLocation"),
+            {MakeShareable(new FJsonValueNumber(BudgetViolation.CurrentLocation.X)),
+             MakeShareable(new FJsonValueNumber(BudgetViolation.CurrentLocation.Y)),
+             MakeShareable(new FJsonValueNumber(BudgetViolation.CurrentLocation.Z))});
+        BudgetViolationObject->SetNumberField(TEXT("FPS"), BudgetViolation.FPS);
+        BudgetViolationObject->SetNumberField(TEXT("GameThreadTime"),
+                                              BudgetViolation.GameThreadTime);
+        BudgetViolationObject->SetNumberField(TEXT("RenderThreadTime"),
+                                              BudgetViolation.RenderThreadTime);
+        BudgetViolationObject->SetNumberField(TEXT("GPUTime"), BudgetViolation.GPUTime);
+        BudgetViolationObject->SetStringField(TEXT("ScreenshotPath"),
+                                              BudgetViolation.ScreenshotPath);
+
+        BudgetViolationValues.Add(MakeShareable(new FJsonValueObject(BudgetViolationObject)));
+    }
+
+    JsonObject->SetArrayField(TEXT("BudgetViolations"), BudgetViolationValues);
+
+    TArray<TSharedPtr<FJsonValue>> MemoryViolationValues;
+
+    for (const FDaeTestPerformanceMemoryViolation& MemoryViolation : MemoryViolations)
+    {
+        TSharedRef<FJsonObject> MemoryViolationObject = MakeShareable(new FJsonObject());
+
+        MemoryViolationObject->SetStringField(TEXT("PreviousTargetPointName"),
+                                              MemoryViolation.PreviousTargetPointName);
+        MemoryViolationObject->SetStringField(TEXT("NextTargetPointName"),
+                                              MemoryViolation.NextTargetPointName);
+        MemoryViolationObject->SetArrayField(TEXT("CurrentLocation"),
+                                             LocationToJson(MemoryViolation.CurrentLocation));
+        MemoryViolationObject->SetStringField(TEXT("Counter"), MemoryViolation.Counter);
+        MemoryViolationObject->SetBoolField(TEXT("IsObjectCount"), MemoryViolation.bIsObjectCount);
+        MemoryViolationObject->SetNumberField(TEXT("Value"), MemoryViolation.Value);
+        MemoryViolationObject->SetNumberField(TEXT("Budget"), MemoryViolation.Budget);
+        MemoryViolationObject->SetObjectField(TEXT("AllocatorStats"),
+                                              AllocatorStatsToJson(MemoryViolation.AllocatorStats));
+
+        MemoryViolationValues.Add(MakeShareable(new FJsonValueObject(MemoryViolationObject)));
+    }
+
+    JsonObject->SetArrayField(TEXT("MemoryViolations"), MemoryViolationValues);
+
+    JsonObject->SetNumberField(TEXT("PeakUsedPhysicalMemory"), PeakUsedPhysicalMemory);
+    JsonObject->SetNumberField(TEXT("PeakUsedVirtualMemory"), PeakUsedVirtualMemory);
+    JsonObject->SetNumberField(TEXT("PeakUObjectCount"), PeakUObjectCount);
+    JsonObject->SetArrayField(TEXT("PeakUsedPhysicalMemoryLocation"),
+                              LocationToJson(PeakUsedPhysicalMemoryLocation));
+    JsonObject->SetObjectField(TEXT("AllocatorStats"), AllocatorStatsToJson(AllocatorStats));
+
+    JsonObject->SetNumberField(TEXT("SampleCount"), SampleCount);
+    JsonObject->SetObjectField(TEXT("FrameTime"), FrameTime.ToJson());
+    JsonObject->SetObjectField(TEXT("GameThreadTime"), GameThreadTime.ToJson());
+    JsonObject->SetObjectField(TEXT("RenderThreadTime"), RenderThreadTime.ToJson());
+    JsonObject->SetObjectField(TEXT("GPUTime"), GPUTime.ToJson());
+
+    TArray<TSharedPtr<FJsonValue>> LegValues;
+
+    for (const FDaeTestPerformanceLegResult& Leg : Legs)
+    {
+        TSharedRef<FJsonObject> LegObject = MakeShareable(new FJsonObject());
+
+        LegObject->SetStringField(TEXT("PreviousTargetPointName"), Leg.PreviousTargetPointName);
+        LegObject->SetStringField(TEXT("NextTargetPointName"), Leg.NextTargetPointName);
+        LegObject->SetNumberField(TEXT("SampleCount"), Leg.SampleCount);
+        LegObject->SetNumberField(TEXT("DurationSeconds"), Leg.DurationSeconds);
+        LegObject->SetNumberField(TEXT("Cost"), Leg.GetCost());
+        LegObject->SetObjectField(TEXT("FrameTime"), Leg.FrameTime.ToJson());
+        LegObject->SetObjectField(TEXT("GameThreadTime"), Leg.GameThreadTime.ToJson());
+        LegObject->SetObjectField(TEXT("RenderThreadTime"), Leg.RenderThreadTime.ToJson());
+        LegObject->SetObjectField(TEXT("GPUTime"), Leg.GPUTime.ToJson());
+        LegObject->SetNumberField(TEXT("PeakUsedPhysicalMemory"), Leg.PeakUsedPhysicalMemory);
+        LegObject->SetNumberField(TEXT("PeakUsedVirtualMemory"), Leg.PeakUsedVirtualMemory);
+        LegObject->SetNumberField(TEXT("PeakUObjectCount"), Leg.PeakUObjectCount);
+
+        LegValues.Add(MakeShareable(new FJsonValueObject(LegObject)));
+    }
+
+    JsonObject->SetArrayField(TEXT("Legs"), LegValues);
+
+    JsonObject->SetObjectField(TEXT("BaselineComparison"), BaselineComparison.ToJson());
+    JsonObject->SetStringField(TEXT("CaptureFilePath"), CaptureFilePath);
+
+    return JsonObject;
+}
+
+void FDaeTestPerformanceBudgetResultData::FromJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestResultData::FromJson(JsonObject);
+
+    BudgetViolations.Empty();
+
+    SampleCount = 0;
+    JsonObject->TryGetNumberField(TEXT("SampleCount"), SampleCount);
+
+    const TSharedPtr<FJsonObject>* SummaryObject;
+
+    if (JsonObject->TryGetObjectField(TEXT("FrameTime"), SummaryObject))
+    {
+        FrameTime = FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+    }
+
+    if (JsonObject->TryGetObjectField(TEXT("GameThreadTime"), SummaryObject))
+    {
+        GameThreadTime = FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+    }
+
+    if (JsonObject->TryGetObjectField(TEXT("RenderThreadTime"), SummaryObject))
+    {
+        RenderThreadTime =
+            FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+    }
+
+    if (JsonObject->TryGetObjectField(TEXT("GPUTime"), SummaryObject))
+    {
+        GPUTime = FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+    }
+
+    Legs.Empty();
+
+    const TArray<TSharedPtr<FJsonValue>>* LegValues;
+
+    if (JsonObject->TryGetArrayField(TEXT("Legs"), LegValues))
+    {
+        for (const TSharedPtr<FJsonValue>& LegValue : *LegValues)
+        {
+            const TSharedPtr<FJsonObject>& LegObject = LegValue->AsObject();
+
+            if (!LegObject.IsValid())
+            {
+                continue;
+            }
+
+            FDaeTestPerformanceLegResult Leg;
+
+            Leg.PreviousTargetPointName =
+                LegObject->GetStringField(TEXT("PreviousTargetPointName"));
+            Leg.NextTargetPointName = LegObject->GetStringField(TEXT("NextTargetPointName"));
+            Leg.SampleCount = LegObject->GetIntegerField(TEXT("SampleCount"));
+            Leg.DurationSeconds = LegObject->GetNumberField(TEXT("DurationSeconds"));
+
+            if (LegObject->TryGetObjectField(TEXT("FrameTime"), SummaryObject))
+            {
+                Leg.FrameTime =
+                    FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+            }
+
+            if (LegObject->TryGetObjectField(TEXT("GameThreadTime"), SummaryObject))
+            {
+                Leg.GameThreadTime =
+                    FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+            }
+
+            if (LegObject->TryGetObjectField(TEXT("RenderThreadTime"), SummaryObject))
+            {
+                Leg.RenderThreadTime =
+                    FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+            }
+
+            if (LegObject->TryGetObjectField(TEXT("GPUTime"), SummaryObject))
+            {
+                Leg.GPUTime =
+                    FDaeTestPerformanceCounterSummary::FromJson(SummaryObject->ToSharedRef());
+            }
+
+            // Results of older versions don't contain any memory counters.
+            double PeakMemory;
+
+            if (LegObject->TryGetNumberField(TEXT("PeakUsedPhysicalMemory"), PeakMemory))
+            {
+                Leg.PeakUsedPhysicalMemory = static_cast<float>(PeakMemory);
+            }
+
+            if (LegObject->TryGetNumberField(TEXT("PeakUsedVirtualMemory"), PeakMemory))
+            {
+                Leg.PeakUsedVirtualMemory = static_cast<float>(PeakMemory);
+            }
+
+            LegObject->TryGetNumberField(TEXT("PeakUObjectCount"), Leg.PeakUObjectCount);
+
+            Legs.Add(Leg);
+        }
+    }
+
+    MemoryViolations.Empty();
+
+    const TArray<TSharedPtr<FJsonValue>>* MemoryViolationValues;
+
+    if (JsonObject->TryGetArrayField(TEXT("MemoryViolations"), MemoryViolationValues))
+    {
+        for (const TSharedPtr<FJsonValue>& MemoryViolationValue : *MemoryViolationValues)
+        {
+            const TSharedPtr<FJsonObject>& MemoryViolationObject =
+                MemoryViolationValue->AsObject();
+
+            if (!MemoryViolationObject.IsValid())
+            {
+                continue;
+            }
+
+            FDaeTestPerformanceMemoryViolation MemoryViolation;
+
+            MemoryViolation.PreviousTargetPointName =
+                MemoryViolationObject->GetStringField(TEXT("PreviousTargetPointName"));
+            MemoryViolation.NextTargetPointName =
+                MemoryViolationObject->GetStringField(TEXT("NextTargetPointName"));
+            MemoryViolation.CurrentLocation =
+                LocationFromJson(*MemoryViolationObject, TEXT("CurrentLocation"));
+            MemoryViolation.Counter = MemoryViolationObject->GetStringField(TEXT("Counter"));
+            MemoryViolationObject->TryGetBoolField(TEXT("IsObjectCount"),
+                                                   MemoryViolation.bIsObjectCount);
+            MemoryViolation.Value = MemoryViolationObject->GetNumberField(TEXT("Value"));
+            MemoryViolation.Budget = MemoryViolationObject->GetNumberField(TEXT("Budget"));
+            MemoryViolation.AllocatorStats =
+                AllocatorStatsFromJson(*MemoryViolationObject, TEXT("AllocatorStats"));
+
+            MemoryViolations.Add(MemoryViolation);
+        }
+    }
+
+    // Results of older versions don't contain any memory counters.
+    double PeakMemory;
+
+    PeakUsedPhysicalMemory = 0.0f;
+    PeakUsedVirtualMemory = 0.0f;
+    PeakUObjectCount = 0;
+
+    if (JsonObject->TryGetNumberField(TEXT("PeakUsedPhysicalMemory"), PeakMemory))
+    {
+        PeakUsedPhysicalMemory = static_cast<float>(PeakMemory);
+    }
+
+    if (JsonObject->TryGetNumberField(TEXT("PeakUsedVirtualMemory"), PeakMemory))
+    {
+        PeakUsedVirtualMemory = static_cast<float>(PeakMemory);
+    }
+
+    JsonObject->TryGetNumberField(TEXT("PeakUObjectCount"), PeakUObjectCount);
+    PeakUsedPhysicalMemoryLocation =
+        LocationFromJson(*JsonObject, TEXT("PeakUsedPhysicalMemoryLocation"));
+    AllocatorStats = AllocatorStatsFromJson(*JsonObject, TEXT("AllocatorStats"));
+
+    BaselineComparison = FDaeTestPerformanceBaselineComparison();
+
+    if (JsonObject->TryGetObjectField(TEXT("BaselineComparison"), SummaryObject))
+    {
+        BaselineComparison =
+            FDaeTestPerformanceBaselineComparison::FromJson(SummaryObject->ToSharedRef());
+    }
+
+    CaptureFilePath.Empty();
+    JsonObject->TryGetStringField(TEXT("CaptureFilePath"), CaptureFilePath);
+
+    const TArray<TSharedPtr<FJsonValue>>* BudgetViolationValues;
+
+    if (!JsonObject->TryGetArrayField(TEXT("BudgetViolations"), BudgetViolationValues))
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& BudgetViolationValue : *BudgetViolationValues)
+    {
+        const TSharedPtr<FJsonObject>& BudgetViolationObject = BudgetViolationValue->AsObject();
+
+        if (!BudgetViolationObject.IsValid())
+        {
+            continue;
+        }
+
+        FDaeTestPerformanceBudgetViolation BudgetViolation;
+
+        BudgetViolation.PreviousTargetPointName =
+            BudgetViolationObject->GetStringField(TEXT("PreviousTargetPointName"));
+        BudgetViolation.NextTargetPointName =
+            BudgetViolationObject->GetStringField(TEXT("NextTargetPointName"));
+
+        const TArray<TSharedPtr<FJsonValue>>* LocationValues;
+
+        if (BudgetViolationObject->TryGetArrayField(TEXT("CurrentLocation"), LocationValues)
+            && LocationValues->Num() == 3)
+        {
+            BudgetViolation.CurrentLocation =
+                FVector((*LocationValues)[0]->AsNumber(), (*LocationValues)[1]->AsNumber(),
+                        (*LocationValues)[2]->AsNumber());
+        }
+
+        BudgetViolation.FPS = BudgetViolationObject->GetNumberField(TEXT("FPS"));
+        BudgetViolation.GameThreadTime =
+            BudgetViolationObject->GetNumberField(TEXT("GameThreadTime"));
+        BudgetViolation.RenderThreadTime =
+            BudgetViolationObject->GetNumberField(TEXT("RenderThreadTime"));
+        BudgetViolation.GPUTime = BudgetViolationObject->GetNumberField(TEXT("GPUTime"));
+        BudgetViolation.ScreenshotPath =
+            BudgetViolationObject->GetStringField(TEXT("ScreenshotPath"));
+
+        BudgetViolations.Add(BudgetViolation);
+    }
+}
+
+TArray<TSharedPtr<FJsonValue>> FDaeTestPerformanceBudgetResultData::LocationToJson(
+    const FVector& Location)
+{
+    return {MakeShareable(new FJsonValueNumber(Location.X)),
+            MakeShareable(new FJsonValueNumber(Location.Y)),
+            MakeShareable(new FJsonValueNumber(Location.Z))};
+}
+
+FVector FDaeTestPerformanceBudgetResultData::LocationFromJson(const FJsonObject& JsonObject,
+                                                              const FString& FieldName)
+{
+    const TArray<TSharedPtr<FJsonValue>>* LocationValues;
+
+    if (!JsonObject.TryGetArrayField(FieldName, LocationValues) || LocationValues->Num() != 3)
+    {
+        return FVector::ZeroVector;
+    }
+
+    return FVector((*LocationValues)[0]->AsNumber(), (*LocationValues)[1]->AsNumber(),
+                   (*LocationValues)[2]->AsNumber());
+}
+
+TSharedRef<FJsonObject> FDaeTestPerformanceBudgetResultData::AllocatorStatsToJson(
+    const TMap<FString, uint64>& Stats)
+{
+    TSharedRef<FJsonObject> StatsObject = MakeShareable(new FJsonObject());
+
+    for (const auto& Stat : Stats)
+    {
+        StatsObject->SetNumberField(Stat.Key, Stat.Value);
+    }
+
+    return StatsObject;
+}
+
+TMap<FString, uint64> FDaeTestPerformanceBudgetResultData::AllocatorStatsFromJson(
+    const FJsonObject& JsonObject, const FString& FieldName)
+{
+    TMap<FString, uint64> Stats;
+
+    const TSharedPtr<FJsonObject>* StatsObject;
+
+    if (JsonObject.TryGetObjectField(FieldName, StatsObject))
+    {
+        for (const auto& StatValue : (*StatsObject)->Values)
+        {
+            Stats.Add(StatValue.Key, static_cast<uint64>(StatValue.Value->AsNumber()));
+        }
+    }
+
+    return Stats;
+}
@@ -0,0 +1,19 @@
+#include "DaeTestPerformanceBudgetRule.h"
+
+FString FDaeTestPerformanceBudgetRule::GetCounterName(EDaeTestPerformanceCounter Counter)
+{
+    // Display names of enums are only available in the editor.
+    switch (Counter)
+    {
+        case EDaeTestPerformanceCounter::FrameTime:
+            return TEXT("Frame");
+        case EDaeTestPerformanceCounter::GameThreadTime:
+            return TEXT("Game Thread");
+        case EDaeTestPerformanceCounter::RenderThreadTime:
+            return TEXT("Render Thread");
+        case EDaeTestPerformanceCounter::GPUTime:
+            return TEXT("GPU");
+        default:
+            return FString();
+    }
+}
@@ -0,0 +1,156 @@
+#include "DaeTestPerformanceBudgetRuleEvaluator.h"
+
+FDaeTestPerformanceBudgetRuleEvaluator::FDaeTestPerformanceBudgetRuleEvaluator(
+    const FDaeTestPerformanceBudgetRule& InRule)
+    : Rule(InRule)
+    , NumFrames(0)
+    , NumFramesOverBudget(0)
+    , WindowStartIndex(0)
+    , WindowSum(0.0)
+    , FirstTimeSeconds(0.0f)
+    , MaxWindowAverage(0.0f)
+    , MaxWindowEndTimeSeconds(0.0f)
+{
+}
+
+void FDaeTestPerformanceBudgetRuleEvaluator::Add(const FDaeTestPerformanceSample& Sample)
+{
+    const float Value = GetCounterValue(Sample, Rule.Counter);
+
+    if (NumFrames == 0)
+    {
+        FirstTimeSeconds = Sample.TimeSeconds;
+    }
+
+    ++NumFrames;
+
+    switch (Rule.Type)
+    {
+        case EDaeTestPerformanceBudgetRuleType::Percentile:
+            Histogram.Add(Value);
+            break;
+
+        case EDaeTestPerformanceBudgetRuleType::FrameShare:
+            if (Value > Rule.Budget)
+            {
+                ++NumFramesOverBudget;
+            }
+            break;
+
+        case EDaeTestPerformanceBudgetRuleType::WindowAverage:
+        {
+            // Slide window.
+            WindowSamples.Add({Sample.TimeSeconds, Value});
+            WindowSum += Value;
+
+            while (WindowStartIndex < WindowSamples.Num() - 1
+                   && WindowSamples[WindowStartIndex].TimeSeconds
+                          <= Sample.TimeSeconds - Rule.WindowSeconds)
+            {
+                WindowSum -= WindowSamples[WindowStartIndex].Value;
+                ++WindowStartIndex;
+            }
+
+            // Only count full windows, e.g. not just the first frame.
+            if (Sample.TimeSeconds - FirstTimeSeconds >= Rule.WindowSeconds)
+            {
+                const float WindowAverage =
+                    static_cast<float>(WindowSum / (WindowSamples.Num() - WindowStartIndex));
+
+                if (WindowAverage > MaxWindowAverage)
+                {
+                    MaxWindowAverage = WindowAverage;
+                    MaxWindowEndTimeSeconds = Sample.TimeSeconds;
+                }
+            }
+
+            // Drop samples that left the window once in a while, instead of every frame.
+            if (WindowStartIndex >= 1024 && WindowStartIndex >= WindowSamples.Num() / 2)
+            {
+                WindowSamples.RemoveAt(0, WindowStartIndex, false);
+                WindowStartIndex = 0;
+            }
+            break;
+        }
+    }
+}
+
+bool FDaeTestPerformanceBudgetRuleEvaluator::Evaluate(FString& OutViolation) const
+{
+    if (NumFrames <= 0)
+    {
+        return true;
+    }
+
+    const FString CounterName = FDaeTestPerformanceBudgetRule::GetCounterName(Rule.Counter);
+
+    switch (Rule.Type)
+    {
+        case EDaeTestPerformanceBudgetRuleType::Percentile:
+        {
+            const float Value = Histogram.GetPercentile(Rule.Percentile);
+
+            if (Value <= Rule.Budget)
+            {
+                return true;
+            }
+
+            OutViolation = FString::Printf(
+                TEXT("p%g %s time of %.2f ms exceeds budget of %.2f ms by %.2f ms"),
+                Rule.Percentile, *CounterName, Value, Rule.Budget, Value - Rule.Budget);
+            return false;
+        }
+
+        case EDaeTestPerformanceBudgetRuleType::FrameShare:
+        {
+            const float FramePercentage = 100.0f * NumFramesOverBudget / NumFrames;
+
+            if (FramePercentage <= Rule.MaxFramePercentage)
+            {
+                return true;
+            }
+
+            OutViolation = FString::Printf(
+                TEXT("%.2f%% of frames (%d of %d) exceed %s budget of %.2f ms, allowing %.2f%% "
+                     "(%.2f%% too many)"),
+                FramePercentage, NumFramesOverBudget, NumFrames, *CounterName, Rule.Budget,
+                Rule.MaxFramePercentage, FramePercentage - Rule.MaxFramePercentage);
+            return false;
+        }
+
+        case EDaeTestPerformanceBudgetRuleType::WindowAverage:
+        {
+            if (MaxWindowAverage <= Rule.Budget)
+            {
+                return true;
+            }
+
+            OutViolation = FString::Printf(
+                TEXT("%s time averaged %.2f ms over %.2f seconds until %.2f seconds, exceeding "
+                     "budget of %.2f ms by %.2f ms"),
+                *CounterName, MaxWindowAverage, Rule.WindowSeconds, MaxWindowEndTimeSeconds,
+                Rule.Budget, MaxWindowAverage - Rule.Budget);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+float FDaeTestPerformanceBudgetRuleEvaluator::GetCounterValue(
+    const FDaeTestPerformanceSample& Sample, EDaeTestPerformanceCounter Counter)
+{
+    switch (Counter)
+    {
+        case EDaeTestPerformanceCounter::FrameTime:
+            return Sample.FrameTime;
+        case EDaeTestPerformanceCounter::GameThreadTime:
+            return Sample.GameThreadTime;
+        case EDaeTestPerformanceCounter::RenderThreadTime:
+            return Sample.RenderThreadTime;
+        case EDaeTestPerformanceCounter::GPUTime:
+            return Sample.GPUTime;
+        default:
+            return 0.0f;
+    }
+}
@@ -0,0 +1,610 @@
+#include "DaeTestPerformanceCapture.h"
+#include "DaeTestLogCategory.h"
+#include <Async/Async.h>
+#include <Async/MappedFileHandle.h>
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+const ANSICHAR FDaeTestPerformanceCapture::Magic[8] = "DAEPERF";
+const uint32 FDaeTestPerformanceCapture::Version = 1;
+const FString FDaeTestPerformanceCapture::FileExtension = TEXT(".daeperf");
+
+FString FDaeTestPerformanceCapture::GetDefaultDirectory()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"),
+                           TEXT("PerformanceCaptures"));
+}
+
+void FDaeTestPerformanceCapture::DeleteOldCaptures(const FString& Directory,
+                                                   int32 NumCapturesToKeep)
+{
+    TArray<FString> FileNames;
+    IFileManager::Get().FindFiles(FileNames, *Directory, *FileExtension);
+
+    if (FileNames.Num() <= NumCapturesToKeep)
+    {
+        return;
+    }
+
+    // Keep most recent captures.
+    TArray<TPair<FDateTime, FString>> Captures;
+
+    for (const FString& FileName : FileNames)
+    {
+        const FString FilePath = FPaths::Combine(Directory, FileName);
+        Captures.Add(
+            TPair<FDateTime, FString>(IFileManager::Get().GetTimeStamp(*FilePath), FilePath));
+    }
+
+    Captures.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B) {
+        return A.Key > B.Key;
+    });
+
+    for (int32 Index = FMath::Max(NumCapturesToKeep, 0); Index < Captures.Num(); ++Index)
+    {
+        UE_LOG(LogDaeTest, Log, TEXT("Deleting old performance capture: %s"),
+               *Captures[Index].Value);
+
+        IFileManager::Get().Delete(*Captures[Index].Value);
+    }
+}
+
+const TArray<FDaeTestPerformanceCapture::FColumn>& FDaeTestPerformanceCapture::GetColumns()
+{
+    // Order must match GetColumnValue and SetColumnValue. Append new columns, so that older readers can skip them.
+    static const TArray<FColumn> Columns = {
+        {EColumnType::DeltaVarInt, TEXT("TimeMicroseconds")},
+        {EColumnType::DeltaVarInt, TEXT("LocationX")},
+        {EColumnType::DeltaVarInt, TEXT("LocationY")},
+        {EColumnType::DeltaVarInt, TEXT("LocationZ")},
+        {EColumnType::DeltaVarInt, TEXT("TargetPointIndex")},
+        {EColumnType::Float, TEXT("FrameTime")},
+        {EColumnType::Float, TEXT("GameThreadTime")},
+        {EColumnType::Float, TEXT("RenderThreadTime")},
+        {EColumnType::Float, TEXT("GPUTime")},
+        {EColumnType::Float, TEXT("UsedPhysicalMemory")},
+        {EColumnType::Float, TEXT("UsedVirtualMemory")},
+        {EColumnType::DeltaVarInt, TEXT("UObjectCount")}};
+
+    return Columns;
+}
+
+double FDaeTestPerformanceCapture::GetColumnValue(int32 ColumnIndex,
+                                                  const FDaeTestPerformanceSample& Sample)
+{
+    switch (ColumnIndex)
+    {
+        case 0:
+            return Sample.TimeSeconds * 1000000.0;
+        case 1:
+            return Sample.Location.X;
+        case 2:
+            return Sample.Location.Y;
+        case 3:
+            return Sample.Location.Z;
+        case 4:
+            return Sample.TargetPointIndex;
+        case 5:
+            return Sample.FrameTime;
+        case 6:
+            return Sample.GameThreadTime;
+        case 7:
+            return Sample.RenderThreadTime;
+        case 8:
+            return Sample.GPUTime;
+        case 9:
+            return Sample.UsedPhysicalMemory;
+        case 10:
+            return Sample.UsedVirtualMemory;
+        case 11:
+            return Sample.UObjectCount;
+        default:
+            return 0.0;
+    }
+}
+
+void FDaeTestPerformanceCapture::SetColumnValue(int32 ColumnIndex, double Value,
+                                                FDaeTestPerformanceSample& Sample)
+{
+    switch (ColumnIndex)
+    {
+        case 0:
+            Sample.TimeSeconds = static_cast<float>(Value / 1000000.0);
+            break;
+        case 1:
+            Sample.Location.X = Value;
+            break;
+        case 2:
+            Sample.Location.Y = Value;
+            break;
+        case 3:
+            Sample.Location.Z = Value;
+            break;
+        case 4:
+            Sample.TargetPointIndex = static_cast<int32>(Value);
+            break;
+        case 5:
+            Sample.FrameTime = static_cast<float>(Value);
+            break;
+        case 6:
+            Sample.GameThreadTime = static_cast<float>(Value);
+            break;
+        case 7:
+            Sample.RenderThreadTime = static_cast<float>(Value);
+            break;
+        case 8:
+            Sample.GPUTime = static_cast<float>(Value);
+            break;
+        case 9:
+            Sample.UsedPhysicalMemory = static_cast<float>(Value);
+            break;
+        case 10:
+            Sample.UsedVirtualMemory = static_cast<float>(Value);
+            break;
+        case 11:
+            Sample.UObjectCount = static_cast<int32>(Value);
+            break;
+        default:
+            break;
+    }
+}
+
+FDaeTestPerformanceCaptureWriter::FDaeTestPerformanceCaptureWriter()
+    : NumSamples(0)
+{
+}
+
+FDaeTestPerformanceCaptureWriter::~FDaeTestPerformanceCaptureWriter()
+{
+    Close();
+}
+
+bool FDaeTestPerformanceCaptureWriter::Open(const FString& InFilePath)
+{
+    Close();
+
+    FilePath = InFilePath;
+    NumSamples = 0;
+    Chunk.Reset();
+
+    File = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*FilePath));
+
+    if (!File.IsValid())
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestPerformanceCaptureWriter::Open - Unable to create capture file %s."),
+               *FilePath);
+        return false;
+    }
+
+    // Write header and schema.
+    TArray<uint8> Bytes;
+    Bytes.Append(reinterpret_cast<const uint8*>(FDaeTestPerformanceCapture::Magic),
+                 sizeof(FDaeTestPerformanceCapture::Magic));
+    WriteUInt32(FDaeTestPerformanceCapture::Version, Bytes);
+
+    const TArray<FDaeTestPerformanceCapture::FColumn>& Columns =
+        FDaeTestPerformanceCapture::GetColumns();
+
+    WriteUInt32(Columns.Num(), Bytes);
+
+    for (const FDaeTestPerformanceCapture::FColumn& Column : Columns)
+    {
+        const FTCHARToUTF8 ColumnName(*Column.Name);
+
+        Bytes.Add(static_cast<uint8>(Column.Type));
+        Bytes.Add(static_cast<uint8>(ColumnName.Length()));
+        Bytes.Append(reinterpret_cast<const uint8*>(ColumnName.Get()), ColumnName.Length());
+    }
+
+    File->Serialize(Bytes.GetData(), Bytes.Num());
+
+    UE_LOG(LogDaeTest, Log, TEXT("Writing performance capture to: %s"), *FilePath);
+
+    return true;
+}
+
+bool FDaeTestPerformanceCaptureWriter::IsOpen() const
+{
+    return File.IsValid();
+}
+
+void FDaeTestPerformanceCaptureWriter::Add(const FDaeTestPerformanceSample& Sample)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    Chunk.Add(Sample);
+    ++NumSamples;
+
+    if (Chunk.Num() >= FDaeTestPerformanceSampleStore::ChunkSize)
+    {
+        FlushChunk();
+    }
+}
+
+void FDaeTestPerformanceCaptureWriter::Close()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    FlushChunk();
+    WaitForPendingWrite();
+
+    File->Close();
+    File.Reset();
+
+    UE_LOG(LogDaeTest, Log, TEXT("Wrote %i performance samples to: %s"), NumSamples, *FilePath);
+}
+
+const FString& FDaeTestPerformanceCaptureWriter::GetFilePath() const
+{
+    return FilePath;
+}
+
+int32 FDaeTestPerformanceCaptureWriter::Num() const
+{
+    return NumSamples;
+}
+
+void FDaeTestPerformanceCaptureWriter::FlushChunk()
+{
+    if (Chunk.Num() <= 0)
+    {
+        return;
+    }
+
+    // The previous chunk has usually been written long ago, as it takes a whole chunk of frames
+    // to fill the next one.
+    WaitForPendingWrite();
+
+    Swap(Chunk, PendingChunk);
+    Chunk.Reset();
+
+    PendingWrite = Async(EAsyncExecution::ThreadPool, [this]() { WriteChunk(PendingChunk); });
+}
+
+void FDaeTestPerformanceCaptureWriter::WaitForPendingWrite()
+{
+    if (PendingWrite.IsValid())
+    {
+        PendingWrite.Wait();
+        PendingWrite.Reset();
+    }
+}
+
+void FDaeTestPerformanceCaptureWriter::WriteChunk(
+    const FDaeTestPerformanceSampleStore& ChunkToWrite)
+{
+    const TArray<FDaeTestPerformanceCapture::FColumn>& Columns =
+        FDaeTestPerformanceCapture::GetColumns();
+
+    TArray<uint8> ChunkBytes;
+    WriteUInt32(ChunkToWrite.Num(), ChunkBytes);
+
+    TArray<uint8> ColumnBytes;
+
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        ColumnBytes.Reset();
+
+        int64 PreviousValue = 0;
+
+        for (int32 SampleIndex = 0; SampleIndex < ChunkToWrite.Num(); ++SampleIndex)
+        {
+            const double Value = FDaeTestPerformanceCapture::GetColumnValue(
+                ColumnIndex, ChunkToWrite.Get(SampleIndex));
+
+            if (Columns[ColumnIndex].Type == FDaeTestPerformanceCapture::EColumnType::DeltaVarInt)
+            {
+                // Zigzag encoding keeps small negative deltas small, too.
+                const int64 IntValue = static_cast<int64>(FMath::RoundToDouble(Value));
+                const int64 Delta = IntValue - PreviousValue;
+                WriteVarInt((static_cast<uint64>(Delta) << 1) ^ static_cast<uint64>(Delta >> 63),
+                            ColumnBytes);
+                PreviousValue = IntValue;
+            }
+            else
+            {
+                const float FloatValue = static_cast<float>(Value);
+                ColumnBytes.Append(reinterpret_cast<const uint8*>(&FloatValue), sizeof(float));
+            }
+        }
+
+        WriteUInt32(ColumnBytes.Num(), ChunkBytes);
+        ChunkBytes.Append(ColumnBytes);
+    }
+
+    TArray<uint8> Bytes;
+    WriteUInt32(ChunkBytes.Num(), Bytes);
+    Bytes.Append(ChunkBytes);
+
+    // Leave flushing to the archive, to avoid stalling on disk for every chunk.
+    File->Serialize(Bytes.GetData(), Bytes.Num());
+}
+
+void FDaeTestPerformanceCaptureWriter::WriteUInt32(uint32 Value, TArray<uint8>& OutBytes)
+{
+    for (int32 ByteIndex = 0; ByteIndex < 4; ++ByteIndex)
+    {
+        OutBytes.Add(static_cast<uint8>(Value >> (ByteIndex * 8)));
+    }
+}
+
+void FDaeTestPerformanceCaptureWriter::WriteVarInt(uint64 Value, TArray<uint8>& OutBytes)
+{
+    // 7 bits per byte, highest bit set if more bytes follow.
+    while (Value >= 0x80)
+    {
+        OutBytes.Add(static_cast<uint8>(Value | 0x80));
+        Value >>= 7;
+    }
+
+    OutBytes.Add(static_cast<uint8>(Value));
+}
+
+FDaeTestPerformanceCaptureReader::FDaeTestPerformanceCaptureReader()
+    : Data(nullptr)
+    , Size(0)
+    , FirstChunkOffset(0)
+{
+}
+
+FDaeTestPerformanceCaptureReader::~FDaeTestPerformanceCaptureReader()
+{
+}
+
+bool FDaeTestPerformanceCaptureReader::Open(const FString& FilePath)
+{
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    FileData.Empty();
+    Columns.Empty();
+    KnownColumnIndices.Empty();
+    Data = nullptr;
+    Size = 0;
+
+    // Memory-map the file, so that hour-long captures don't need to fit into memory.
+    MappedFile = TUniquePtr<IMappedFileHandle>(
+        FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+
+    if (MappedFile.IsValid() && MappedFile->GetFileSize() > 0)
+    {
+        MappedRegion = TUniquePtr<IMappedFileRegion>(MappedFile->MapRegion());
+    }
+
+    if (MappedRegion.IsValid())
+    {
+        Data = MappedRegion->GetMappedPtr();
+        Size = MappedRegion->GetMappedSize();
+    }
+    else if (FFileHelper::LoadFileToArray(FileData, *FilePath))
+    {
+        Data = FileData.GetData();
+        Size = FileData.Num();
+    }
+    else
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestPerformanceCaptureReader::Open - Unable to read capture file %s."),
+               *FilePath);
+        return false;
+    }
+
+    // Read header.
+    int64 Offset = sizeof(FDaeTestPerformanceCapture::Magic);
+    uint32 FileVersion = 0;
+
+    if (Size < Offset
+        || FMemory::Memcmp(Data, FDaeTestPerformanceCapture::Magic, Offset) != 0
+        || !ReadUInt32(Data, Size, Offset, FileVersion)
+        || FileVersion > FDaeTestPerformanceCapture::Version)
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestPerformanceCaptureReader::Open - %s is not a supported capture file."),
+               *FilePath);
+        return false;
+    }
+
+    // Read schema.
+    uint32 NumColumns = 0;
+
+    if (!ReadUInt32(Data, Size, Offset, NumColumns))
+    {
+        return false;
+    }
+
+    const TArray<FDaeTestPerformanceCapture::FColumn>& KnownColumns =
+        FDaeTestPerformanceCapture::GetColumns();
+
+    for (uint32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+    {
+        if (Offset + 2 > Size || Offset + 2 + Data[Offset + 1] > Size)
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("FDaeTestPerformanceCaptureReader::Open - Schema of %s is truncated."),
+                   *FilePath);
+            return false;
+        }
+
+        FDaeTestPerformanceCapture::FColumn Column;
+        Column.Type = static_cast<FDaeTestPerformanceCapture::EColumnType>(Data[Offset]);
+
+        const int32 NameLength = Data[Offset + 1];
+        const FUTF8ToTCHAR ColumnName(reinterpret_cast<const ANSICHAR*>(Data + Offset + 2),
+                                      NameLength);
+        Column.Name = FString(ColumnName.Length(), ColumnName.Get());
+
+        Offset += 2 + NameLength;
+
+        const int32 KnownColumnIndex = KnownColumns.IndexOfByPredicate(
+            [&Column](const FDaeTestPerformanceCapture::FColumn& KnownColumn) {
+                return KnownColumn.Name == Column.Name && KnownColumn.Type == Column.Type;
+            });
+
+        Columns.Add(Column);
+        KnownColumnIndices.Add(KnownColumnIndex);
+    }
+
+    FirstChunkOffset = Offset;
+    return true;
+}
+
+const TArray<FDaeTestPerformanceCapture::FColumn>& FDaeTestPerformanceCaptureReader::GetColumns()
+    const
+{
+    return Columns;
+}
+
+bool FDaeTestPerformanceCaptureReader::ForEachSample(
+    TFunctionRef<void(const FDaeTestPerformanceSample&)> Callback) const
+{
+    if (Data == nullptr)
+    {
+        return false;
+    }
+
+    // Decode one chunk at a time, column by column.
+    TArray<FDaeTestPerformanceSample> ChunkSamples;
+    int64 Offset = FirstChunkOffset;
+
+    while (Offset < Size)
+    {
+        uint32 ChunkByteSize = 0;
+        uint32 NumSamples = 0;
+
+        if (!ReadUInt32(Data, Size, Offset, ChunkByteSize) || Offset + ChunkByteSize > Size)
+        {
+            // Last chunk might be incomplete if the process crashed while writing it.
+            UE_LOG(LogDaeTest, Warning,
+                   TEXT("FDaeTestPerformanceCaptureReader::ForEachSample - Capture file is "
+                        "truncated, skipping last chunk."));
+            return true;
+        }
+
+        const int64 ChunkEnd = Offset + ChunkByteSize;
+
+        if (!ReadUInt32(Data, ChunkEnd, Offset, NumSamples))
+        {
+            return false;
+        }
+
+        ChunkSamples.Reset();
+        ChunkSamples.SetNum(NumSamples);
+
+        for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+        {
+            uint32 ColumnByteSize = 0;
+
+            if (!ReadUInt32(Data, ChunkEnd, Offset, ColumnByteSize)
+                || Offset + ColumnByteSize > ChunkEnd)
+            {
+                return false;
+            }
+
+            const int64 ColumnEnd = Offset + ColumnByteSize;
+            const int32 KnownColumnIndex = KnownColumnIndices[ColumnIndex];
+
+            if (KnownColumnIndex != INDEX_NONE)
+            {
+                int64 PreviousValue = 0;
+
+                for (FDaeTestPerformanceSample& Sample : ChunkSamples)
+                {
+                    double Value = 0.0;
+
+                    if (Columns[ColumnIndex].Type
+                        == FDaeTestPerformanceCapture::EColumnType::DeltaVarInt)
+                    {
+                        uint64 EncodedDelta = 0;
+
+                        if (!ReadVarInt(Data, ColumnEnd, Offset, EncodedDelta))
+                        {
+                            return false;
+                        }
+
+                        const int64 Delta = static_cast<int64>(EncodedDelta >> 1)
+                                            ^ -static_cast<int64>(EncodedDelta & 1);
+                        PreviousValue += Delta;
+                        Value = PreviousValue;
+                    }
+                    else
+                    {
+                        if (Offset + sizeof(float) > ColumnEnd)
+                        {
+                            return false;
+                        }
+
+                        float FloatValue;
+                        FMemory::Memcpy(&FloatValue, Data + Offset, sizeof(float));
+                        Offset += sizeof(float);
+                        Value = FloatValue;
+                    }
+
+                    FDaeTestPerformanceCapture::SetColumnValue(KnownColumnIndex, Value, Sample);
+                }
+            }
+
+            // Skip columns written by newer versions of the plugin.
+            Offset = ColumnEnd;
+        }
+
+        for (const FDaeTestPerformanceSample& Sample : ChunkSamples)
+        {
+            Callback(Sample);
+        }
+
+        Offset = ChunkEnd;
+    }
+
+    return true;
+}
+
+bool FDaeTestPerformanceCaptureReader::ReadUInt32(const uint8* Bytes, int64 Size,
+                                                  int64& InOutOffset, uint32& OutValue)
+{
+    if (InOutOffset + 4 > Size)
+    {
+        return false;
+    }
+
+    OutValue = 0;
+
+    for (int32 ByteIndex = 0; ByteIndex < 4; ++ByteIndex)
+    {
+        OutValue |= static_cast<uint32>(Bytes[InOutOffset + ByteIndex]) << (ByteIndex * 8);
+    }
+
+    InOutOffset += 4;
+    return true;
+}
+
+bool FDaeTestPerformanceCaptureReader::ReadVarInt(const uint8* Bytes, int64 Size,
+                                                  int64& InOutOffset, uint64& OutValue)
+{
+    OutValue = 0;
+
+    for (int32 Shift = 0; Shift < 64; Shift += 7)
+    {
+        if (InOutOffset >= Size)
+        {
+            return false;
+        }
+
+        const uint8 Byte = Bytes[InOutOffset++];
+        OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+
+        if ((Byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,65 @@
+#include "DaeTestPerformanceCounterSummary.h"
+
+TSharedRef<FJsonObject> FDaeTestPerformanceCounterSummary::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+    JsonObject->SetNumberField(TEXT("Min"), Min);
+    JsonObject->SetNumberField(TEXT("Mean"), Mean);
+    JsonObject->SetNumberField(TEXT("P50"), P50);
+    JsonObject->SetNumberField(TEXT("P90"), P90);
+    JsonObject->SetNumberField(TEXT("P99"), P99);
+    JsonObject->SetNumberField(TEXT("Max"), Max);
+
+    return JsonObject;
+}
+
+FDaeTestPerformanceCounterSummary FDaeTestPerformanceCounterSummary::FromJson(
+    const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestPerformanceCounterSummary Summary;
+
+    Summary.Min = JsonObject->GetNumberField(TEXT("Min"));
+    Summary.Mean = JsonObject->GetNumberField(TEXT("Mean"));
+    Summary.P50 = JsonObject->GetNumberField(TEXT("P50"));
+    Summary.P90 = JsonObject->GetNumberField(TEXT("P90"));
+    Summary.P99 = JsonObject->GetNumberField(TEXT("P99"));
+    Summary.Max = JsonObject->GetNumberField(TEXT("Max"));
+
+    return Summary;
+}
+
+FDaeTestPerformanceCounterSummaryBuilder::FDaeTestPerformanceCounterSummaryBuilder()
+    : Min(0.0f)
+    , Max(0.0f)
+    , Sum(0.0)
+{
+}
+
+void FDaeTestPerformanceCounterSummaryBuilder::Add(float Value)
+{
+    Min = Histogram.Num() > 0 ? FMath::Min(Min, Value) : Value;
+    Max = Histogram.Num() > 0 ? FMath::Max(Max, Value) : Value;
+    Sum += Value;
+
+    Histogram.Add(Value);
+}
+
+FDaeTestPerformanceCounterSummary FDaeTestPerformanceCounterSummaryBuilder::ToSummary() const
+{
+    FDaeTestPerformanceCounterSummary Summary;
+
+    if (Histogram.Num() <= 0)
+    {
+        return Summary;
+    }
+
+    Summary.Min = Min;
+    Summary.Mean = static_cast<float>(Sum / Histogram.Num());
+    Summary.P50 = Histogram.GetPercentile(50.0f);
+    Summary.P90 = Histogram.GetPercentile(90.0f);
+    Summary.P99 = Histogram.GetPercentile(99.0f);
+    Summary.Max = Max;
+
+    return Summary;
+}
@@ -0,0 +1,127 @@
+#include "DaeTestPerformanceHistogram.h"
+
+// 1% relative accuracy for values between 0.01 ms and 100 s, using about 800 buckets.
+const float FDaeTestPerformanceHistogram::MinValue = 0.01f;
+const float FDaeTestPerformanceHistogram::MaxValue = 100000.0f;
+const float FDaeTestPerformanceHistogram::Gamma = 1.01f / 0.99f;
+
+FDaeTestPerformanceHistogram::FDaeTestPerformanceHistogram()
+    : NumValues(0)
+    , Min(0.0f)
+    , Max(0.0f)
+{
+    const int32 NumBuckets =
+        FMath::CeilToInt(FMath::Loge(MaxValue / MinValue) / FMath::Loge(Gamma)) + 1;
+    BucketCounts.SetNumZeroed(NumBuckets);
+}
+
+void FDaeTestPerformanceHistogram::Add(float Value)
+{
+    Min = NumValues > 0 ? FMath::Min(Min, Value) : Value;
+    Max = NumValues > 0 ? FMath::Max(Max, Value) : Value;
+    ++NumValues;
+
+    const float ClampedValue = FMath::Clamp(Value, MinValue, MaxValue);
+    const int32 BucketIndex =
+        FMath::FloorToInt(FMath::Loge(ClampedValue / MinValue) / FMath::Loge(Gamma));
+
+    ++BucketCounts[FMath::Clamp(BucketIndex, 0, BucketCounts.Num() - 1)];
+}
+
+int32 FDaeTestPerformanceHistogram::Num() const
+{
+    return NumValues;
+}
+
+float FDaeTestPerformanceHistogram::GetPercentile(float Percentile) const
+{
+    if (NumValues <= 0)
+    {
+        return 0.0f;
+    }
+
+    // Find bucket of the value with the nearest rank.
+    const int32 Rank =
+        FMath::Clamp(FMath::CeilToInt(Percentile / 100.0f * NumValues), 1, NumValues);
+    int32 Count = 0;
+
+    for (int32 BucketIndex = 0; BucketIndex < BucketCounts.Num(); ++BucketIndex)
+    {
+        Count += BucketCounts[BucketIndex];
+
+        if (Count >= Rank)
+        {
+            // Center of the bucket, relative to its bounds.
+            const float LowerBound = MinValue * FMath::Pow(Gamma, BucketIndex);
+            const float Value = LowerBound * 2.0f * Gamma / (Gamma + 1.0f);
+            return FMath::Clamp(Value, Min, Max);
+        }
+    }
+
+    return Max;
+}
+
+const TArray<uint32>& FDaeTestPerformanceHistogram::GetBucketCounts() const
+{
+    return BucketCounts;
+}
+
+TSharedRef<FJsonObject> FDaeTestPerformanceHistogram::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+    JsonObject->SetNumberField(TEXT("Num"), NumValues);
+    JsonObject->SetNumberField(TEXT("Min"), Min);
+    JsonObject->SetNumberField(TEXT("Max"), Max);
+
+    // Pairs of bucket index and count.
+    TArray<TSharedPtr<FJsonValue>> BucketValues;
+
+    for (int32 BucketIndex = 0; BucketIndex < BucketCounts.Num(); ++BucketIndex)
+    {
+        if (BucketCounts[BucketIndex] > 0)
+        {
+            BucketValues.Add(MakeShareable(new FJsonValueArray(
+                {MakeShareable(new FJsonValueNumber(BucketIndex)),
+                 MakeShareable(new FJsonValueNumber(BucketCounts[BucketIndex]))})));
+        }
+    }
+
+    JsonObject->SetArrayField(TEXT("Buckets"), BucketValues);
+
+    return JsonObject;
+}
+
+FDaeTestPerformanceHistogram FDaeTestPerformanceHistogram::FromJson(
+    const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestPerformanceHistogram Histogram;
+
+    Histogram.NumValues = JsonObject->GetIntegerField(TEXT("Num"));
+    Histogram.Min = JsonObject->GetNumberField(TEXT("Min"));
+    Histogram.Max = JsonObject->GetNumberField(TEXT("Max"));
+
+    const TArray<TSharedPtr<FJsonValue>>* BucketValues;
+
+    if (JsonObject->TryGetArrayField(TEXT("Buckets"), BucketValues))
+    {
+        for (const TSharedPtr<FJsonValue>& BucketValue : *BucketValues)
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Pair = BucketValue->AsArray();
+
+            if (Pair.Num() != 2)
+            {
+                continue;
+            }
+
+            const int32 BucketIndex = static_cast<int32>(Pair[0]->AsNumber());
+
+            if (Histogram.BucketCounts.IsValidIndex(BucketIndex))
+            {
+                Histogram.BucketCounts[BucketIndex] = static_cast<uint32>(Pair[1]->AsNumber());
+            }
+        }
+    }
+
+    return Histogram;
+}
@@ -0,0 +1,6 @@
+#include "DaeTestPerformanceLegResult.h"
+
+float FDaeTestPerformanceLegResult::GetCost() const
+{
+    return FMath::Max3(GameThreadTime.P90, RenderThreadTime.P90, GPUTime.P90);
+}
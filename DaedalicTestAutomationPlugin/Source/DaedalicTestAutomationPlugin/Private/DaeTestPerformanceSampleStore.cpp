@@ -0,0 +1,31 @@
+#include "DaeTestPerformanceSampleStore.h"
+
+void FDaeTestPerformanceSampleStore::Reset()
+{
+    Chunks.SetNum(1);
+    Chunks[0].Reset(ChunkSize);
+    NumSamples = 0;
+}
+
+void FDaeTestPerformanceSampleStore::Add(const FDaeTestPerformanceSample& Sample)
+{
+    const int32 ChunkIndex = NumSamples / ChunkSize;
+
+    if (!Chunks.IsValidIndex(ChunkIndex))
+    {
+        Chunks.AddDefaulted_GetRef().Reserve(ChunkSize);
+    }
+
+    Chunks[ChunkIndex].Add(Sample);
+    ++NumSamples;
+}
+
+int32 FDaeTestPerformanceSampleStore::Num() const
+{
+    return NumSamples;
+}
+
+const FDaeTestPerformanceSample& FDaeTestPerformanceSampleStore::Get(int32 Index) const
+{
+    return Chunks[Index / ChunkSize][Index % ChunkSize];
+}
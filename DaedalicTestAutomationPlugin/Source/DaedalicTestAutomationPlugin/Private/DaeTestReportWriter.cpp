@@ -1,5 +1,20 @@
 #include "DaeTestReportWriter.h"
 
+void FDaeTestReportWriter::BeginReport(const FString& ReportPath)
+{
+}
+
+void FDaeTestReportWriter::AppendTestSuite(const FDaeTestSuiteResult& TestSuite,
+                                           const FString& ReportPath)
+{
+}
+
+void FDaeTestReportWriter::FinishReport(const TArray<FDaeTestSuiteResult>& TestSuites,
+                                        const FString& ReportPath)
+{
+    WriteReport(TestSuites, ReportPath);
+}
+
 int32 FDaeTestReportWriter::NumTotalTests(const TArray<FDaeTestSuiteResult>& TestSuites) const
 {
     int32 TotalTests = 0;
@@ -1,5 +1,17 @@
 #include "DaeTestReportWriterJUnit.h"
 #include "DaeTestLogCategory.h"
+#include <HAL/PlatformFileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+FDaeTestReportWriterJUnit::FDaeTestReportWriterJUnit()
+    : ClosingTagOffset(0)
+{
+}
+
+FDaeTestReportWriterJUnit::~FDaeTestReportWriterJUnit()
+{
+}
 
 FName FDaeTestReportWriterJUnit::GetReportType() const
 {
@@ -10,23 +22,126 @@ void FDaeTestReportWriterJUnit::WriteReport(const TArray<FDaeTestSuiteResult>& T
                                             const FString& ReportPath) const
 {
     // Build report path.
+    const FString JUnitReportPath = GetJUnitReportPath(ReportPath);
+
+    if (JUnitReportPath.IsEmpty())
+    {
+        return;
+    }
+
+    EnsureReportDirectoryExists(JUnitReportPath);
+
+    // Write a JUnit XML report based on FXmlFile::WriteNodeHierarchy.
+    // Unfortunately, FXmlNode::Tag is private, so we have to do the hard work here ourselves...
+    FString XmlString;
+
+    XmlString += TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>") LINE_TERMINATOR;
+    XmlString += TEXT("<testsuites");
+    XmlString += TEXT(" name=\"JUnit Test Report\"");
+    XmlString += FString::Printf(TEXT(" tests=\"%d\""), NumTotalTests(TestSuites));
+    XmlString += FString::Printf(TEXT(" skipped=\"%d\""), NumSkippedTests(TestSuites));
+    XmlString += FString::Printf(TEXT(" failures=\"%d\""), NumFailedTests(TestSuites));
+    XmlString += FString::Printf(TEXT(" errors=\"0\""));
+    XmlString += FString::Printf(TEXT(" time=\"%f\""), GetTotalTimeSeconds(TestSuites));
+    XmlString += FString::Printf(TEXT(" timestamp=\"%s\""), *GetTimestamp(TestSuites));
+    XmlString += TEXT(">") LINE_TERMINATOR;
+
+    for (const FDaeTestSuiteResult& TestSuiteResult : TestSuites)
+    {
+        XmlString += TestSuiteToXml(TestSuiteResult);
+    }
+
+    XmlString += TEXT("</testsuites>") LINE_TERMINATOR;
+
+    UE_LOG(LogDaeTest, Verbose, TEXT("Test report:\r\n%s"), *XmlString);
+    UE_LOG(LogDaeTest, Display, TEXT("Writing test report to: %s"), *JUnitReportPath);
+
+    FFileHelper::SaveStringToFile(XmlString, *JUnitReportPath);
+}
+
+void FDaeTestReportWriterJUnit::BeginReport(const FString& ReportPath)
+{
+    const FString JUnitReportPath = GetJUnitReportPath(ReportPath);
+
+    if (JUnitReportPath.IsEmpty())
+    {
+        return;
+    }
+
+    EnsureReportDirectoryExists(JUnitReportPath);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    ReportFile.Reset(PlatformFile.OpenWrite(*JUnitReportPath));
+
+    if (!ReportFile.IsValid())
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestReportWriterJUnit::BeginReport - Unable to open %s for writing."),
+               *JUnitReportPath);
+        return;
+    }
+
+    UE_LOG(LogDaeTest, Display, TEXT("Writing test report to: %s"), *JUnitReportPath);
+
+    // Totals are added when finishing the report.
+    WriteToReportFile(TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>") LINE_TERMINATOR);
+    WriteToReportFile(TEXT("<testsuites name=\"JUnit Test Report\">") LINE_TERMINATOR);
+
+    ClosingTagOffset = ReportFile->Tell();
+    WriteToReportFile(TEXT("</testsuites>") LINE_TERMINATOR);
+    ReportFile->Flush();
+}
+
+void FDaeTestReportWriterJUnit::AppendTestSuite(const FDaeTestSuiteResult& TestSuite,
+                                                const FString& ReportPath)
+{
+    if (!ReportFile.IsValid())
+    {
+        return;
+    }
+
+    // Overwrite closing tag, and add it again afterwards, so the report stays valid in case we crash.
+    ReportFile->Seek(ClosingTagOffset);
+    WriteToReportFile(TestSuiteToXml(TestSuite));
+
+    ClosingTagOffset = ReportFile->Tell();
+    WriteToReportFile(TEXT("</testsuites>") LINE_TERMINATOR);
+    ReportFile->Flush();
+}
+
+void FDaeTestReportWriterJUnit::FinishReport(const TArray<FDaeTestSuiteResult>& TestSuites,
+                                             const FString& ReportPath)
+{
+    // Write once more, including totals.
+    ReportFile.Reset();
+    WriteReport(TestSuites, ReportPath);
+}
+
+FString FDaeTestReportWriterJUnit::GetJUnitReportPath(const FString& ReportPath) const
+{
     FString JUnitReportPath;
 
+    // Each test server request writes its reports to its own report path, so don't let all of them
+    // overwrite the same JUnit report.
+    if (FParse::Param(FCommandLine::Get(), TEXT("TestServer")) && !ReportPath.IsEmpty())
+    {
+        return FPaths::Combine(ReportPath, TEXT("junit-report.xml"));
+    }
+
     // Backwards compatibility:
     FParse::Value(FCommandLine::Get(), TEXT("JUnitReportPath"), JUnitReportPath);
     JUnitReportPath = JUnitReportPath.Mid(1);
 
-    if (JUnitReportPath.IsEmpty())
+    if (JUnitReportPath.IsEmpty() && !ReportPath.IsEmpty())
     {
-        if (ReportPath.IsEmpty())
-        {
-            return;
-        }
-
         JUnitReportPath = FPaths::Combine(ReportPath, TEXT("junit-report.xml"));
     }
 
-    // Ensure report path exists.
+    return JUnitReportPath;
+}
+
+void FDaeTestReportWriterJUnit::EnsureReportDirectoryExists(const FString& JUnitReportPath) const
+{
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
     FString ReportDirectory = FPaths::GetPath(JUnitReportPath);
 
@@ -36,57 +151,109 @@ void FDaeTestReportWriterJUnit::WriteReport(const TArray<FDaeTestSuiteResult>& T
 
         PlatformFile.CreateDirectoryTree(*ReportDirectory);
     }
+}
+
+FString FDaeTestReportWriterJUnit::TestSuiteToXml(const FDaeTestSuiteResult& TestSuite) const
+{
+    // Names and messages might contain anything, e.g. raw log lines of crashed runs.
+    const FString& TestClassName =
+        EscapeXml(FString::Printf(TEXT("%s.%s"), *TestSuite.MapName, *TestSuite.TestSuiteName));
 
-    // Write a JUnit XML report based on FXmlFile::WriteNodeHierarchy.
-    // Unfortunately, FXmlNode::Tag is private, so we have to do the hard work here ourselves...
     FString XmlString;
 
-    XmlString += TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>") LINE_TERMINATOR;
-    XmlString += TEXT("<testsuite");
-    XmlString += TEXT(" name=\"JUnit Test Report\"");
-    XmlString += FString::Printf(TEXT(" tests=\"%d\""), NumTotalTests(TestSuites));
-    XmlString += FString::Printf(TEXT(" skipped=\"%d\""), NumSkippedTests(TestSuites));
-    XmlString += FString::Printf(TEXT(" failures=\"%d\""), NumFailedTests(TestSuites));
+    XmlString += TEXT("    <testsuite");
+    XmlString += FString::Printf(TEXT(" name=\"%s\""), *TestClassName);
+    XmlString += FString::Printf(TEXT(" tests=\"%d\""), TestSuite.NumTotalTests());
+    XmlString += FString::Printf(TEXT(" skipped=\"%d\""), TestSuite.NumSkippedTests());
+    XmlString += FString::Printf(TEXT(" failures=\"%d\""), TestSuite.NumFailedTests());
     XmlString += FString::Printf(TEXT(" errors=\"0\""));
-    XmlString += FString::Printf(TEXT(" time=\"%f\""), GetTotalTimeSeconds(TestSuites));
-    XmlString += FString::Printf(TEXT(" timestamp=\"%s\""), *GetTimestamp(TestSuites));
+    XmlString += FString::Printf(TEXT(" time=\"%f\""), TestSuite.GetTotalTimeSeconds());
+    XmlString += FString::Printf(TEXT(" timestamp=\"%s\""), *TestSuite.Timestamp.ToIso8601());
     XmlString += TEXT(">") LINE_TERMINATOR;
 
-    for (const FDaeTestSuiteResult& TestSuiteResult : TestSuites)
+    if (TestSuite.bFromCache)
     {
-        const FString& TestClassName = FString::Printf(TEXT("%s.%s"), *TestSuiteResult.MapName,
-                                                       *TestSuiteResult.TestSuiteName);
+        XmlString += TEXT("        <properties>") LINE_TERMINATOR;
+        XmlString +=
+            TEXT("            <property name=\"FromCache\" value=\"true\"/>") LINE_TERMINATOR;
+        XmlString += TEXT("        </properties>") LINE_TERMINATOR;
+    }
 
-        for (const FDaeTestResult& TestResult : TestSuiteResult.TestResults)
+    for (const FDaeTestResult& TestResult : TestSuite.TestResults)
+    {
+        XmlString += TEXT("        <testcase");
+        XmlString += FString::Printf(TEXT(" name=\"%s\""), *EscapeXml(TestResult.TestName));
+        XmlString += FString::Printf(TEXT(" classname=\"%s\""), *TestClassName);
+        XmlString += FString::Printf(TEXT(" time=\"%f\""), TestResult.TimeSeconds);
+        XmlString += TEXT(">") LINE_TERMINATOR;
+
+        if (TestResult.HasFailed())
+        {
+            XmlString +=
+                FString::Printf(TEXT("            <failure type=\"Assertion failed\">%s</failure>"),
+                                *EscapeXml(TestResult.FailureMessage))
+                + LINE_TERMINATOR;
+        }
+        else if (TestResult.WasSkipped())
         {
-            XmlString += TEXT("    <testcase");
-            XmlString += FString::Printf(TEXT(" name=\"%s\""), *TestResult.TestName);
-            XmlString += FString::Printf(TEXT(" classname=\"%s\""), *TestClassName);
-            XmlString += FString::Printf(TEXT(" time=\"%f\""), TestResult.TimeSeconds);
-            XmlString += TEXT(">") LINE_TERMINATOR;
-
-            if (TestResult.HasFailed())
-            {
-                XmlString +=
-                    FString::Printf(TEXT("        <failure type=\"Assertion failed\">%s</failure>"),
-                                    *TestResult.FailureMessage)
-                    + LINE_TERMINATOR;
-            }
-            else if (TestResult.WasSkipped())
-            {
-                XmlString +=
-                    FString::Printf(TEXT("        <skipped>%s</skipped>"), *TestResult.SkipReason)
-                    + LINE_TERMINATOR;
-            }
-
-            XmlString += TEXT("    </testcase>") LINE_TERMINATOR;
+            XmlString += FString::Printf(TEXT("            <skipped>%s</skipped>"),
+                                         *EscapeXml(TestResult.SkipReason))
+                         + LINE_TERMINATOR;
         }
+
+        XmlString += TEXT("        </testcase>") LINE_TERMINATOR;
     }
 
-    XmlString += TEXT("</testsuite>") LINE_TERMINATOR;
+    XmlString += TEXT("    </testsuite>") LINE_TERMINATOR;
 
-    UE_LOG(LogDaeTest, Verbose, TEXT("Test report:\r\n%s"), *XmlString);
-    UE_LOG(LogDaeTest, Display, TEXT("Writing test report to: %s"), *JUnitReportPath);
+    return XmlString;
+}
 
-    FFileHelper::SaveStringToFile(XmlString, *JUnitReportPath);
+FString FDaeTestReportWriterJUnit::EscapeXml(const FString& Text) const
+{
+    FString EscapedText;
+    EscapedText.Reserve(Text.Len());
+
+    for (const TCHAR Character : Text)
+    {
+        switch (Character)
+        {
+            case TEXT('&'):
+                EscapedText += TEXT("&amp;");
+                break;
+
+            case TEXT('<'):
+                EscapedText += TEXT("&lt;");
+                break;
+
+            case TEXT('>'):
+                EscapedText += TEXT("&gt;");
+                break;
+
+            case TEXT('"'):
+                EscapedText += TEXT("&quot;");
+                break;
+
+            case TEXT('\''):
+                EscapedText += TEXT("&apos;");
+                break;
+
+            default:
+                // XML 1.0 doesn't allow control characters other than tabs and line breaks.
+                if (Character >= 0x20 || Character == TEXT('\t') || Character == TEXT('\n')
+                    || Character == TEXT('\r'))
+                {
+                    EscapedText += Character;
+                }
+                break;
+        }
+    }
+
+    return EscapedText;
+}
+
+void FDaeTestReportWriterJUnit::WriteToReportFile(const FString& String)
+{
+    FTCHARToUTF8 Utf8String(*String);
+    ReportFile->Write(reinterpret_cast<const uint8*>(Utf8String.Get()), Utf8String.Length());
 }
@@ -1,10 +1,13 @@
 #include "DaeTestReportWriterPerformance.h"
 #include "DaeTestPerformanceBudgetResultData.h"
 #include "DaeTestPerformanceBudgetViolation.h"
+#include "DaeTestPerformanceMemoryViolation.h"
 #include "DaeTestLogCategory.h"
 #include <HAL/PlatformFileManager.h>
 #include <Interfaces/IPluginManager.h>
 #include <Kismet/KismetTextLibrary.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
 
 FName FDaeTestReportWriterPerformance::GetReportType() const
 {
@@ -14,7 +17,45 @@ FName FDaeTestReportWriterPerformance::GetReportType() const
 void FDaeTestReportWriterPerformance::WriteReport(const TArray<FDaeTestSuiteResult>& TestSuites,
                                                   const FString& ReportPath) const
 {
-    // Ensure report path exists.
+    EnsureReportDirectoryExists(ReportPath);
+
+    // Write performance budget violations.
+    FString MapString;
+
+    for (const FDaeTestSuiteResult& TestSuiteResult : TestSuites)
+    {
+        MapString += WriteTestSuite(TestSuiteResult, ReportPath);
+    }
+
+    // Write report.
+    WriteReportFile(MapString, GetTimestamp(TestSuites), GetTotalTimeSeconds(TestSuites),
+                    ReportPath);
+    WriteJsonReportFile(TestSuites, ReportPath);
+}
+
+void FDaeTestReportWriterPerformance::BeginReport(const FString& ReportPath)
+{
+    EnsureReportDirectoryExists(ReportPath);
+    AppendedMapString.Empty();
+}
+
+void FDaeTestReportWriterPerformance::AppendTestSuite(const FDaeTestSuiteResult& TestSuite,
+                                                      const FString& ReportPath)
+{
+    // Copy screenshots as soon as possible, but write report only once.
+    AppendedMapString += WriteTestSuite(TestSuite, ReportPath);
+}
+
+void FDaeTestReportWriterPerformance::FinishReport(const TArray<FDaeTestSuiteResult>& TestSuites,
+                                                   const FString& ReportPath)
+{
+    WriteReportFile(AppendedMapString, GetTimestamp(TestSuites), GetTotalTimeSeconds(TestSuites),
+                    ReportPath);
+    WriteJsonReportFile(TestSuites, ReportPath);
+}
+
+void FDaeTestReportWriterPerformance::EnsureReportDirectoryExists(const FString& ReportPath) const
+{
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 
     if (!PlatformFile.DirectoryExists(*ReportPath))
@@ -23,109 +64,266 @@ void FDaeTestReportWriterPerformance::WriteReport(const TArray<FDaeTestSuiteResu
 
         PlatformFile.CreateDirectoryTree(*ReportPath);
     }
+}
 
-    // Prepare report.
+FString FDaeTestReportWriterPerformance::GetTemplatePath(const FString& FileName) const
+{
     FString ContentDir =
         IPluginManager::Get().FindPlugin(TEXT("DaedalicTestAutomationPlugin"))->GetContentDir();
-    FString ReportTemplatePath = FPaths::Combine(ContentDir, TEXT("ReportTemplates"),
-                                                 TEXT("PerformanceReport.template.html"));
-    FString MapTemplatePath = FPaths::Combine(ContentDir, TEXT("ReportTemplates"),
-                                              TEXT("PerformanceReportMap.template.html"));
+    return FPaths::Combine(ContentDir, TEXT("ReportTemplates"), FileName);
+}
+
+FString FDaeTestReportWriterPerformance::WriteTestSuite(const FDaeTestSuiteResult& TestSuiteResult,
+                                                        const FString& ReportPath) const
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    FString MapTemplatePath = GetTemplatePath(TEXT("PerformanceReportMap.template.html"));
     FString BudgetViolationTemplatePath =
-        FPaths::Combine(ContentDir, TEXT("ReportTemplates"),
-                        TEXT("PerformanceReportBudgetViolation.template.html"));
+        GetTemplatePath(TEXT("PerformanceReportBudgetViolation.template.html"));
 
-    // Write performance budget violations.
     FString MapString;
 
-    for (const FDaeTestSuiteResult& TestSuiteResult : TestSuites)
+    for (const FDaeTestResult& TestResult : TestSuiteResult.TestResults)
     {
-        for (const FDaeTestResult& TestResult : TestSuiteResult.TestResults)
+        if (TestResult.Data != nullptr
+            && TestResult.Data->GetDataType() == TEXT("FDaeTestPerformanceBudgetResultData"))
         {
-            if (TestResult.Data != nullptr
-                && TestResult.Data->GetDataType() == TEXT("FDaeTestPerformanceBudgetResultData"))
-            {
-                TSharedPtr<FDaeTestPerformanceBudgetResultData> Data =
-                    StaticCastSharedPtr<FDaeTestPerformanceBudgetResultData>(TestResult.Data);
+            // Don't copy shared pointers here, as this might be called on a background thread.
+            const FDaeTestPerformanceBudgetResultData* Data =
+                static_cast<const FDaeTestPerformanceBudgetResultData*>(TestResult.Data.Get());
+
+            FString BudgetViolationsString;
 
-                FString BudgetViolationsString;
+            for (const FDaeTestPerformanceBudgetViolation& BudgetViolation :
+                 Data->BudgetViolations)
+            {
+                // Copy screenshot, if any (e.g. not when running headless).
+                FString OldScreenshotPath = BudgetViolation.ScreenshotPath;
+                FString ScreenshotFilename = FPaths::GetCleanFilename(OldScreenshotPath);
 
-                for (const FDaeTestPerformanceBudgetViolation& BudgetViolation :
-                     Data->BudgetViolations)
+                if (!OldScreenshotPath.IsEmpty())
                 {
-                    // Copy screenshot.
-                    FString OldScreenshotPath = BudgetViolation.ScreenshotPath;
-                    FString ScreenshotFilename = FPaths::GetCleanFilename(OldScreenshotPath);
                     FString NewScreenshotPath = FPaths::Combine(ReportPath, ScreenshotFilename);
 
                     UE_LOG(LogDaeTest, Display, TEXT("Copying %s to %s."), *OldScreenshotPath,
                            *NewScreenshotPath);
 
                     PlatformFile.CopyFile(*NewScreenshotPath, *OldScreenshotPath);
-
-                    // Write budget violation.
-                    TMap<FString, FString> BudgetViolationTemplateReplacements;
-
-                    BudgetViolationTemplateReplacements.Add(TEXT("{LOCATION}"),
-                                                            FormatLocation(
-                                                                BudgetViolation.CurrentLocation));
-                    BudgetViolationTemplateReplacements.Add(
-                        TEXT("{PREVIOUS}"), BudgetViolation.PreviousTargetPointName);
-                    BudgetViolationTemplateReplacements.Add(TEXT("{NEXT}"),
-                                                            BudgetViolation.NextTargetPointName);
-                    BudgetViolationTemplateReplacements.Add(TEXT("{FPS}"),
-                                                            FormatTime(BudgetViolation.FPS));
-                    BudgetViolationTemplateReplacements.Add(TEXT("{GAME_TIME}"),
-                                                            FormatTime(
-                                                                BudgetViolation.GameThreadTime));
-                    BudgetViolationTemplateReplacements.Add(TEXT("{RENDER_TIME}"),
-                                                            FormatTime(
-                                                                BudgetViolation.RenderThreadTime));
-                    BudgetViolationTemplateReplacements.Add(TEXT("{GPU_TIME}"),
-                                                            FormatTime(BudgetViolation.GPUTime));
-                    BudgetViolationTemplateReplacements.Add(TEXT("{SCREENSHOT_PATH}"),
-                                                            ScreenshotFilename);
-
-                    BudgetViolationsString +=
-                        ApplyTemplateFile(BudgetViolationTemplatePath,
-                                          BudgetViolationTemplateReplacements);
                 }
 
-                // Write map.
-                TMap<FString, FString> MapTemplateReplacements;
+                // Write budget violation.
+                TMap<FString, FString> BudgetViolationTemplateReplacements;
+
+                BudgetViolationTemplateReplacements.Add(TEXT("{LOCATION}"),
+                                                        FormatLocation(
+                                                            BudgetViolation.CurrentLocation));
+                BudgetViolationTemplateReplacements.Add(
+                    TEXT("{PREVIOUS}"), BudgetViolation.PreviousTargetPointName);
+                BudgetViolationTemplateReplacements.Add(TEXT("{NEXT}"),
+                                                        BudgetViolation.NextTargetPointName);
+                BudgetViolationTemplateReplacements.Add(TEXT("{FPS}"),
+                                                        FormatTime(BudgetViolation.FPS));
+                BudgetViolationTemplateReplacements.Add(TEXT("{GAME_TIME}"),
+                                                        FormatTime(
+                                                            BudgetViolation.GameThreadTime));
+                BudgetViolationTemplateReplacements.Add(TEXT("{RENDER_TIME}"),
+                                                        FormatTime(
+                                                            BudgetViolation.RenderThreadTime));
+                BudgetViolationTemplateReplacements.Add(TEXT("{GPU_TIME}"),
+                                                        FormatTime(BudgetViolation.GPUTime));
+                BudgetViolationTemplateReplacements.Add(TEXT("{SCREENSHOT_PATH}"),
+                                                        ScreenshotFilename);
+
+                BudgetViolationsString +=
+                    ApplyTemplateFile(BudgetViolationTemplatePath,
+                                      BudgetViolationTemplateReplacements);
+            }
+
+            // Write memory budget violations.
+            const FString MemoryViolationTemplatePath =
+                GetTemplatePath(TEXT("PerformanceReportMemoryViolation.template.html"));
+            FString MemoryViolationsString;
+
+            for (const FDaeTestPerformanceMemoryViolation& MemoryViolation :
+                 Data->MemoryViolations)
+            {
+                TMap<FString, FString> MemoryViolationTemplateReplacements;
+
+                MemoryViolationTemplateReplacements.Add(
+                    TEXT("{LOCATION}"), FormatLocation(MemoryViolation.CurrentLocation));
+                MemoryViolationTemplateReplacements.Add(
+                    TEXT("{PREVIOUS}"), MemoryViolation.PreviousTargetPointName);
+                MemoryViolationTemplateReplacements.Add(TEXT("{NEXT}"),
+                                                        MemoryViolation.NextTargetPointName);
+                MemoryViolationTemplateReplacements.Add(TEXT("{COUNTER}"),
+                                                        MemoryViolation.Counter);
+                MemoryViolationTemplateReplacements.Add(
+                    TEXT("{VALUE}"),
+                    MemoryViolation.bIsObjectCount
+                        ? FormatCount(FMath::RoundToInt(MemoryViolation.Value))
+                        : FormatMemory(MemoryViolation.Value));
+                MemoryViolationTemplateReplacements.Add(
+                    TEXT("{BUDGET}"),
+                    MemoryViolation.bIsObjectCount
+                        ? FormatCount(FMath::RoundToInt(MemoryViolation.Budget))
+                        : FormatMemory(MemoryViolation.Budget));
+                MemoryViolationTemplateReplacements.Add(
+                    TEXT("{ALLOCATOR_STATS}"),
+                    FormatAllocatorStats(MemoryViolation.AllocatorStats));
+
+                MemoryViolationsString += ApplyTemplateFile(MemoryViolationTemplatePath,
+                                                            MemoryViolationTemplateReplacements);
+            }
+
+            // Write distributions of all performance counters.
+            FString CounterSummariesString;
+
+            CounterSummariesString += WriteCounterSummary(TEXT("Frame"), Data->FrameTime);
+            CounterSummariesString += WriteCounterSummary(TEXT("Game"), Data->GameThreadTime);
+            CounterSummariesString += WriteCounterSummary(TEXT("Render"), Data->RenderThreadTime);
+            CounterSummariesString += WriteCounterSummary(TEXT("GPU"), Data->GPUTime);
+
+            // Write legs of the flight path, most expensive first.
+            const FString LegTemplatePath =
+                GetTemplatePath(TEXT("PerformanceReportLeg.template.html"));
+            FString LegsString;
+
+            for (int32 LegIndex = 0; LegIndex < Data->Legs.Num(); ++LegIndex)
+            {
+                const FDaeTestPerformanceLegResult& Leg = Data->Legs[LegIndex];
+
+                TMap<FString, FString> LegTemplateReplacements;
+
+                LegTemplateReplacements.Add(TEXT("{RANK}"), FString::FromInt(LegIndex + 1));
+                LegTemplateReplacements.Add(TEXT("{PREVIOUS}"), Leg.PreviousTargetPointName);
+                LegTemplateReplacements.Add(TEXT("{NEXT}"), Leg.NextTargetPointName);
+                LegTemplateReplacements.Add(TEXT("{DURATION}"), FormatTime(Leg.DurationSeconds));
+                LegTemplateReplacements.Add(TEXT("{SAMPLE_COUNT}"),
+                                            FString::FromInt(Leg.SampleCount));
+                LegTemplateReplacements.Add(TEXT("{GAME_TIME}"),
+                                            FormatTime(Leg.GameThreadTime.P90));
+                LegTemplateReplacements.Add(TEXT("{RENDER_TIME}"),
+                                            FormatTime(Leg.RenderThreadTime.P90));
+                LegTemplateReplacements.Add(TEXT("{GPU_TIME}"), FormatTime(Leg.GPUTime.P90));
+                LegTemplateReplacements.Add(TEXT("{FRAME_TIME}"), FormatTime(Leg.FrameTime.Max));
+                LegTemplateReplacements.Add(TEXT("{PEAK_MEMORY}"),
+                                            FormatMemory(Leg.PeakUsedPhysicalMemory));
+
+                LegsString += ApplyTemplateFile(LegTemplatePath, LegTemplateReplacements);
+            }
+
+            // Copy capture file, for analyzing single frames with the capture export commandlet.
+            FString CaptureFilename = FPaths::GetCleanFilename(Data->CaptureFilePath);
+
+            if (PlatformFile.FileExists(*Data->CaptureFilePath))
+            {
+                FString NewCapturePath = FPaths::Combine(ReportPath, CaptureFilename);
+
+                UE_LOG(LogDaeTest, Display, TEXT("Copying %s to %s."), *Data->CaptureFilePath,
+                       *NewCapturePath);
+
+                PlatformFile.CopyFile(*NewCapturePath, *Data->CaptureFilePath);
+            }
+            else
+            {
+                CaptureFilename.Empty();
+            }
 
-                MapTemplateReplacements.Add(TEXT("{MAP_NAME}"), TestSuiteResult.MapName);
-                MapTemplateReplacements.Add(TEXT("{MAP_DURATION}"),
-                                            FormatTime(TestResult.TimeSeconds));
-                MapTemplateReplacements.Add(TEXT("{BUDGET_VIOLATIONS}"), BudgetViolationsString);
+            // Write baseline comparison.
+            const FDaeTestPerformanceBaselineComparison& Comparison = Data->BaselineComparison;
+            FString BaselineString = TEXT("n/a");
 
-                MapString += ApplyTemplateFile(MapTemplatePath, MapTemplateReplacements);
+            if (Comparison.bHasBaseline)
+            {
+                BaselineString = FString::Printf(
+                    TEXT("Median frame time %s ms (baseline from %s: %s ms, %+.1f%%, p = %g)%s"),
+                    *FormatTime(Comparison.CurrentP50), *Comparison.BaselineTimestamp,
+                    *FormatTime(Comparison.BaselineP50), Comparison.GetP50ChangePercentage(),
+                    Comparison.PValue,
+                    Comparison.bRegression ? TEXT(" <strong>Regression</strong>") : TEXT(""));
             }
+
+            // Write map.
+            TMap<FString, FString> MapTemplateReplacements;
+
+            MapTemplateReplacements.Add(TEXT("{MAP_NAME}"), TestSuiteResult.MapName);
+            MapTemplateReplacements.Add(TEXT("{MAP_DURATION}"),
+                                        FormatTime(TestResult.TimeSeconds));
+            MapTemplateReplacements.Add(TEXT("{SAMPLE_COUNT}"),
+                                        FString::FromInt(Data->SampleCount));
+            MapTemplateReplacements.Add(TEXT("{PEAK_PHYSICAL_MEMORY}"),
+                                        FormatMemory(Data->PeakUsedPhysicalMemory));
+            MapTemplateReplacements.Add(TEXT("{PEAK_VIRTUAL_MEMORY}"),
+                                        FormatMemory(Data->PeakUsedVirtualMemory));
+            MapTemplateReplacements.Add(TEXT("{PEAK_UOBJECT_COUNT}"),
+                                        FormatCount(Data->PeakUObjectCount));
+            MapTemplateReplacements.Add(TEXT("{PEAK_LOCATION}"),
+                                        FormatLocation(Data->PeakUsedPhysicalMemoryLocation));
+            MapTemplateReplacements.Add(TEXT("{BASELINE}"), BaselineString);
+            MapTemplateReplacements.Add(TEXT("{CAPTURE_PATH}"), CaptureFilename);
+            MapTemplateReplacements.Add(TEXT("{COUNTER_SUMMARIES}"), CounterSummariesString);
+            MapTemplateReplacements.Add(TEXT("{LEGS}"), LegsString);
+            MapTemplateReplacements.Add(TEXT("{BUDGET_VIOLATIONS}"), BudgetViolationsString);
+            MapTemplateReplacements.Add(TEXT("{MEMORY_VIOLATIONS}"), MemoryViolationsString);
+
+            MapString += ApplyTemplateFile(MapTemplatePath, MapTemplateReplacements);
         }
     }
 
-    // Write report.
+    return MapString;
+}
+
+FString FDaeTestReportWriterPerformance::WriteCounterSummary(
+    const FString& CounterName, const FDaeTestPerformanceCounterSummary& Summary) const
+{
+    // E.g. render thread and GPU times when running headless.
+    if (Summary.Max <= 0.0f)
+    {
+        return FString();
+    }
+
+    TMap<FString, FString> CounterSummaryTemplateReplacements;
+
+    CounterSummaryTemplateReplacements.Add(TEXT("{COUNTER}"), CounterName);
+    CounterSummaryTemplateReplacements.Add(TEXT("{MIN}"), FormatTime(Summary.Min));
+    CounterSummaryTemplateReplacements.Add(TEXT("{MEAN}"), FormatTime(Summary.Mean));
+    CounterSummaryTemplateReplacements.Add(TEXT("{P50}"), FormatTime(Summary.P50));
+    CounterSummaryTemplateReplacements.Add(TEXT("{P90}"), FormatTime(Summary.P90));
+    CounterSummaryTemplateReplacements.Add(TEXT("{P99}"), FormatTime(Summary.P99));
+    CounterSummaryTemplateReplacements.Add(TEXT("{MAX}"), FormatTime(Summary.Max));
+
+    return ApplyTemplateFile(GetTemplatePath(TEXT("PerformanceReportCounterSummary.template.html")),
+                             CounterSummaryTemplateReplacements);
+}
+
+void FDaeTestReportWriterPerformance::WriteReportFile(const FString& MapString,
+                                                      const FString& StartTime,
+                                                      float TotalTimeSeconds,
+                                                      const FString& ReportPath) const
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
     TMap<FString, FString> ReportTemplateReplacements;
 
-    ReportTemplateReplacements.Add(TEXT("{START_TIME}"), GetTimestamp(TestSuites));
-    ReportTemplateReplacements.Add(TEXT("{TOTAL_DURATION}"),
-                                   FormatTime(GetTotalTimeSeconds(TestSuites)));
+    ReportTemplateReplacements.Add(TEXT("{START_TIME}"), StartTime);
+    ReportTemplateReplacements.Add(TEXT("{TOTAL_DURATION}"), FormatTime(TotalTimeSeconds));
     ReportTemplateReplacements.Add(TEXT("{MAP_RESULTS}"), MapString);
 
-    FString ReportHtmlString = ApplyTemplateFile(ReportTemplatePath, ReportTemplateReplacements);
-
-    UE_LOG(LogDaeTest, Verbose, TEXT("Test report:\r\n%s"), *ReportHtmlString);
-    UE_LOG(LogDaeTest, Display, TEXT("Writing test report to: %s"), *ReportHtmlString);
+    FString ReportHtmlString = ApplyTemplateFile(
+        GetTemplatePath(TEXT("PerformanceReport.template.html")), ReportTemplateReplacements);
 
     FString HtmlReportPath = FPaths::Combine(ReportPath, TEXT("performance-report.html"));
 
+    UE_LOG(LogDaeTest, Verbose, TEXT("Test report:\r\n%s"), *ReportHtmlString);
+    UE_LOG(LogDaeTest, Display, TEXT("Writing test report to: %s"), *HtmlReportPath);
+
     FFileHelper::SaveStringToFile(ReportHtmlString, *HtmlReportPath);
 
     // Copy style file.
     const FString& StyleFileName = TEXT("bootstrap.min.css");
 
-    FString PluginStyleFilePath =
-        FPaths::Combine(ContentDir, TEXT("ReportTemplates"), StyleFileName);
+    FString PluginStyleFilePath = GetTemplatePath(StyleFileName);
     FString ReportStyleFilePath = FPaths::Combine(ReportPath, StyleFileName);
 
     UE_LOG(LogDaeTest, Display, TEXT("Copying %s to %s."), *PluginStyleFilePath,
@@ -134,6 +332,48 @@ void FDaeTestReportWriterPerformance::WriteReport(const TArray<FDaeTestSuiteResu
     PlatformFile.CopyFile(*ReportStyleFilePath, *PluginStyleFilePath);
 }
 
+void FDaeTestReportWriterPerformance::WriteJsonReportFile(
+    const TArray<FDaeTestSuiteResult>& TestSuites, const FString& ReportPath) const
+{
+    // Same data as the HTML report, e.g. for tracking legs of flight paths across builds.
+    TArray<TSharedPtr<FJsonValue>> TestValues;
+
+    for (const FDaeTestSuiteResult& TestSuiteResult : TestSuites)
+    {
+        for (const FDaeTestResult& TestResult : TestSuiteResult.TestResults)
+        {
+            if (TestResult.Data == nullptr
+                || TestResult.Data->GetDataType() != TEXT("FDaeTestPerformanceBudgetResultData"))
+            {
+                continue;
+            }
+
+            TSharedRef<FJsonObject> TestObject = MakeShareable(new FJsonObject());
+
+            TestObject->SetStringField(TEXT("MapName"), TestSuiteResult.MapName);
+            TestObject->SetStringField(TEXT("TestName"), TestResult.TestName);
+            TestObject->SetNumberField(TEXT("TimeSeconds"), TestResult.TimeSeconds);
+            TestObject->SetObjectField(TEXT("Data"), TestResult.Data->ToJson());
+
+            TestValues.Add(MakeShareable(new FJsonValueObject(TestObject)));
+        }
+    }
+
+    TSharedRef<FJsonObject> ReportObject = MakeShareable(new FJsonObject());
+    ReportObject->SetStringField(TEXT("StartTime"), GetTimestamp(TestSuites));
+    ReportObject->SetArrayField(TEXT("Tests"), TestValues);
+
+    FString ReportJsonString;
+    TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ReportJsonString);
+    FJsonSerializer::Serialize(ReportObject, JsonWriter);
+
+    FString JsonReportPath = FPaths::Combine(ReportPath, TEXT("performance-report.json"));
+
+    UE_LOG(LogDaeTest, Display, TEXT("Writing test report to: %s"), *JsonReportPath);
+
+    FFileHelper::SaveStringToFile(ReportJsonString, *JsonReportPath);
+}
+
 FString FDaeTestReportWriterPerformance::FormatTime(float Time) const
 {
     return UKismetTextLibrary::Conv_FloatToText(Time, ERoundingMode::HalfToEven, false, false, 1,
@@ -141,8 +381,35 @@ FString FDaeTestReportWriterPerformance::FormatTime(float Time) const
         .ToString();
 }
 
+FString FDaeTestReportWriterPerformance::FormatMemory(float Megabytes) const
+{
+    return UKismetTextLibrary::Conv_FloatToText(Megabytes, ERoundingMode::HalfToEven, false, true,
+                                                1, 324, 1, 1)
+               .ToString()
+           + TEXT("&nbsp;MB");
+}
+
+FString FDaeTestReportWriterPerformance::FormatCount(int32 Count) const
+{
+    return UKismetTextLibrary::Conv_IntToText(Count, false, true).ToString();
+}
+
 FString FDaeTestReportWriterPerformance::FormatLocation(const FVector& Location) const
 {
     return FString::Printf(TEXT("X=%d Y=%d Z=%d"), FMath::FloorToInt(Location.X),
                            FMath::FloorToInt(Location.Y), FMath::FloorToInt(Location.Z));
 }
+
+FString FDaeTestReportWriterPerformance::FormatAllocatorStats(
+    const TMap<FString, uint64>& AllocatorStats) const
+{
+    TArray<FString> StatStrings;
+
+    for (const auto& Stat : AllocatorStats)
+    {
+        StatStrings.Add(FString::Printf(TEXT("%s: %s"), *Stat.Key,
+                                        *FormatMemory(Stat.Value / (1024.0f * 1024.0f))));
+    }
+
+    return FString::Join(StatStrings, TEXT("<br/>"));
+}
@@ -0,0 +1,146 @@
+#include "DaeTestReportWriterQueue.h"
+#include "DaeTestLogCategory.h"
+#include "DaeTestReportWriter.h"
+#include <HAL/Event.h>
+#include <HAL/PlatformProcess.h>
+#include <HAL/RunnableThread.h>
+
+FDaeTestReportWriterQueue::FDaeTestReportWriterQueue(const FString& InReportPath)
+    : ReportPath(InReportPath)
+    , Thread(nullptr)
+{
+    TasksQueuedEvent = FPlatformProcess::GetSynchEventFromPool();
+
+    if (FPlatformProcess::SupportsMultithreading())
+    {
+        Thread = FRunnableThread::Create(this, TEXT("DaeTestReportWriterQueue"));
+    }
+}
+
+FDaeTestReportWriterQueue::~FDaeTestReportWriterQueue()
+{
+    Flush();
+
+    if (Thread != nullptr)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(TasksQueuedEvent);
+    TasksQueuedEvent = nullptr;
+}
+
+void FDaeTestReportWriterQueue::AddReportWriter(TSharedPtr<FDaeTestReportWriter> ReportWriter)
+{
+    if (!ReportWriter.IsValid())
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FDaeTestReportWriter>& ExistingReportWriter : ReportWriters)
+    {
+        if (ExistingReportWriter->GetReportType() == ReportWriter->GetReportType())
+        {
+            return;
+        }
+    }
+
+    ReportWriters.Add(ReportWriter);
+
+    // Pass raw pointers to the background thread, as shared pointers might not be thread-safe.
+    // Both writers and test suites live as long as this queue.
+    FDaeTestReportWriter* Writer = ReportWriter.Get();
+    const FString Path = ReportPath;
+
+    Enqueue([Writer, Path]() { Writer->BeginReport(Path); });
+
+    for (const FDaeTestSuiteResult& TestSuite : TestSuites)
+    {
+        const FDaeTestSuiteResult* TestSuitePtr = &TestSuite;
+        Enqueue([Writer, TestSuitePtr, Path]() { Writer->AppendTestSuite(*TestSuitePtr, Path); });
+    }
+}
+
+void FDaeTestReportWriterQueue::AppendTestSuite(const FDaeTestSuiteResult& TestSuite)
+{
+    FDaeTestSuiteResult* TestSuiteCopy = new FDaeTestSuiteResult(TestSuite);
+    TestSuites.Add(TestSuiteCopy);
+
+    const FDaeTestSuiteResult* TestSuitePtr = TestSuiteCopy;
+
+    const FString Path = ReportPath;
+
+    for (const TSharedPtr<FDaeTestReportWriter>& ReportWriter : ReportWriters)
+    {
+        FDaeTestReportWriter* Writer = ReportWriter.Get();
+        Enqueue([Writer, TestSuitePtr, Path]() { Writer->AppendTestSuite(*TestSuitePtr, Path); });
+    }
+}
+
+void FDaeTestReportWriterQueue::FinishReports()
+{
+    Flush();
+
+    // Finish on the calling thread, as the final reports might need all results at once.
+    TArray<FDaeTestSuiteResult> AllTestSuites;
+
+    for (const FDaeTestSuiteResult& TestSuite : TestSuites)
+    {
+        AllTestSuites.Add(TestSuite);
+    }
+
+    for (const TSharedPtr<FDaeTestReportWriter>& ReportWriter : ReportWriters)
+    {
+        ReportWriter->FinishReport(AllTestSuites, ReportPath);
+    }
+}
+
+void FDaeTestReportWriterQueue::Flush()
+{
+    while (NumPendingTasks.GetValue() > 0)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+uint32 FDaeTestReportWriterQueue::Run()
+{
+    while (!bStopping)
+    {
+        TFunction<void()> Task;
+
+        while (Tasks.Dequeue(Task))
+        {
+            Task();
+            Task = nullptr;
+
+            NumPendingTasks.Decrement();
+        }
+
+        TasksQueuedEvent->Wait(100);
+    }
+
+    return 0;
+}
+
+void FDaeTestReportWriterQueue::Stop()
+{
+    bStopping = true;
+    TasksQueuedEvent->Trigger();
+}
+
+void FDaeTestReportWriterQueue::Enqueue(TFunction<void()>&& Task)
+{
+    if (Thread == nullptr)
+    {
+        // No background thread available, write immediately.
+        Task();
+        return;
+    }
+
+    NumPendingTasks.Increment();
+    Tasks.Enqueue(MoveTemp(Task));
+    TasksQueuedEvent->Trigger();
+}
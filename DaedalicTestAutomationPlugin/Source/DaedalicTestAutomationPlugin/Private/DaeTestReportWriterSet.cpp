@@ -1,5 +1,8 @@
 #include "DaeTestReportWriterSet.h"
+#include "DaeTestLogCategory.h"
 #include "DaeTestReportWriter.h"
+#include "DaeTestReportWriterJUnit.h"
+#include "DaeTestReportWriterPerformance.h"
 
 void FDaeTestReportWriterSet::Add(TSharedPtr<FDaeTestReportWriter> ReportWriter)
 {
@@ -26,3 +29,45 @@ TArray<TSharedPtr<FDaeTestReportWriter>> FDaeTestReportWriterSet::GetReportWrite
 {
     return ReportWriters;
 }
+
+TArray<TSharedPtr<FJsonValue>> FDaeTestReportWriterSet::ToJson() const
+{
+    TArray<TSharedPtr<FJsonValue>> ReportTypeValues;
+
+    for (const TSharedPtr<FDaeTestReportWriter>& ReportWriter : ReportWriters)
+    {
+        ReportTypeValues.Add(
+            MakeShareable(new FJsonValueString(ReportWriter->GetReportType().ToString())));
+    }
+
+    return ReportTypeValues;
+}
+
+FDaeTestReportWriterSet FDaeTestReportWriterSet::FromJson(
+    const TArray<TSharedPtr<FJsonValue>>& JsonValues)
+{
+    FDaeTestReportWriterSet ReportWriterSet;
+
+    for (const TSharedPtr<FJsonValue>& JsonValue : JsonValues)
+    {
+        const FString ReportType = JsonValue->AsString();
+
+        if (ReportType == TEXT("FDaeTestReportWriterJUnit"))
+        {
+            ReportWriterSet.Add(MakeShareable(new FDaeTestReportWriterJUnit()));
+        }
+        else if (ReportType == TEXT("FDaeTestReportWriterPerformance"))
+        {
+            ReportWriterSet.Add(MakeShareable(new FDaeTestReportWriterPerformance()));
+        }
+        else
+        {
+            UE_LOG(LogDaeTest, Warning,
+                   TEXT("FDaeTestReportWriterSet::FromJson - Unknown report type %s, reports of "
+                        "that type are only written by the process running the test."),
+                   *ReportType);
+        }
+    }
+
+    return ReportWriterSet;
+}
@@ -1,4 +1,5 @@
 #include "DaeTestResult.h"
+#include "DaeTestPerformanceBudgetResultData.h"
 
 FDaeTestResult::FDaeTestResult()
     : FDaeTestResult(FString(), 0.0f)
@@ -25,3 +26,50 @@ bool FDaeTestResult::WasSkipped() const
 {
     return !SkipReason.IsEmpty();
 }
+
+TSharedRef<FJsonObject> FDaeTestResult::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+    JsonObject->SetStringField(TEXT("TestName"), TestName);
+    JsonObject->SetStringField(TEXT("FailureMessage"), FailureMessage);
+    JsonObject->SetStringField(TEXT("SkipReason"), SkipReason);
+    JsonObject->SetNumberField(TEXT("TimeSeconds"), TimeSeconds);
+
+    if (Data.IsValid())
+    {
+        JsonObject->SetObjectField(TEXT("Data"), Data->ToJson());
+    }
+
+    return JsonObject;
+}
+
+FDaeTestResult FDaeTestResult::FromJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestResult Result(JsonObject->GetStringField(TEXT("TestName")),
+                          JsonObject->GetNumberField(TEXT("TimeSeconds")));
+
+    Result.FailureMessage = JsonObject->GetStringField(TEXT("FailureMessage"));
+    Result.SkipReason = JsonObject->GetStringField(TEXT("SkipReason"));
+
+    const TSharedPtr<FJsonObject>* DataObject;
+
+    if (JsonObject->TryGetObjectField(TEXT("Data"), DataObject) && DataObject->IsValid())
+    {
+        // Restore the actual type of the data, for report writers to type-cast safely.
+        const FString DataType = (*DataObject)->GetStringField(TEXT("DataType"));
+
+        if (DataType == TEXT("FDaeTestPerformanceBudgetResultData"))
+        {
+            Result.Data = MakeShareable(new FDaeTestPerformanceBudgetResultData());
+        }
+        else
+        {
+            Result.Data = MakeShareable(new FDaeTestResultData());
+        }
+
+        Result.Data->FromJson(DataObject->ToSharedRef());
+    }
+
+    return Result;
+}
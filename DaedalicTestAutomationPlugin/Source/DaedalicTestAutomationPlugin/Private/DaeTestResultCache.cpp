@@ -0,0 +1,178 @@
+#include "DaeTestResultCache.h"
+#include "DaeTestLogCategory.h"
+#include "Settings/DaeTestAutomationPluginSettings.h"
+#include <HAL/PlatformFileManager.h>
+#include <Interfaces/IPluginManager.h>
+#include <Misc/App.h>
+#include <Misc/EngineVersion.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Misc/SecureHash.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+
+FString FDaeTestResultCache::GetDefaultDirectory()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DaedalicTestAutomationPlugin"),
+                           TEXT("TestResultCache"));
+}
+
+void FDaeTestResultCache::Open(const FString& InDirectory)
+{
+    Directory = InDirectory;
+    EnvironmentHash = ComputeEnvironmentHash();
+    PackageDependencies = MakeUnique<FDaeTestPackageDependencies>();
+
+    UE_LOG(LogDaeTest, Display, TEXT("Using test result cache: %s"), *Directory);
+}
+
+bool FDaeTestResultCache::IsOpen() const
+{
+    return PackageDependencies.IsValid();
+}
+
+FString FDaeTestResultCache::GetKey(const FName& MapName, const FName& PackageName)
+{
+    if (!IsOpen())
+    {
+        return FString();
+    }
+
+    TArray<FName> Closure =
+        PackageDependencies
+            ->GetClosure(FDaeTestPackageDependencies::GetTestMapPackages(MapName, PackageName))
+            .Array();
+    Closure.Sort(FNameLexicalLess());
+
+    // One line per input, so that the same inputs always result in the same key.
+    TArray<FString> Entries;
+    Entries.Add(EnvironmentHash);
+    Entries.Add(MapName.ToString());
+
+    for (const FName& DependencyName : Closure)
+    {
+        Entries.Add(FString::Printf(TEXT("%s=%s"), *DependencyName.ToString(),
+                                    *PackageDependencies->GetPackageHash(DependencyName)));
+    }
+
+    return FMD5::HashAnsiString(*FString::Join(Entries, TEXT("\n")));
+}
+
+bool FDaeTestResultCache::Find(const FString& Key, FDaeTestCheckpointResult& OutResult) const
+{
+    if (!IsOpen() || Key.IsEmpty())
+    {
+        return false;
+    }
+
+    FString EntryString;
+
+    if (!FFileHelper::LoadFileToString(EntryString, *GetFilePath(Key)))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Entry;
+    TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(EntryString);
+
+    const TSharedPtr<FJsonObject>* ResultObject;
+
+    if (!FJsonSerializer::Deserialize(JsonReader, Entry) || !Entry.IsValid()
+        || !Entry->TryGetObjectField(TEXT("Result"), ResultObject))
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("FDaeTestResultCache::Find - Unable to read cached result %s, ignoring."),
+               *GetFilePath(Key));
+        return false;
+    }
+
+    OutResult.Result = FDaeTestSuiteResult::FromJson(ResultObject->ToSharedRef());
+    OutResult.Result.bFromCache = true;
+
+    const TArray<TSharedPtr<FJsonValue>>* ReportTypeValues;
+
+    if (Entry->TryGetArrayField(TEXT("ReportWriters"), ReportTypeValues))
+    {
+        OutResult.ReportWriters = FDaeTestReportWriterSet::FromJson(*ReportTypeValues);
+    }
+
+    OutResult.LoadTimeSeconds = Entry->GetNumberField(TEXT("LoadTimeSeconds"));
+
+    return true;
+}
+
+void FDaeTestResultCache::Store(const FString& Key, const FDaeTestSuiteResult& Result,
+                                const FDaeTestReportWriterSet& ReportWriters,
+                                float LoadTimeSeconds) const
+{
+    // Failing tests should be run again, and cached results are already stored.
+    if (!IsOpen() || Key.IsEmpty() || Result.bFromCache || Result.NumTotalTests() <= 0
+        || Result.NumFailedTests() > 0)
+    {
+        return;
+    }
+
+    TSharedRef<FJsonObject> Entry = MakeShareable(new FJsonObject());
+    Entry->SetObjectField(TEXT("Result"), Result.ToJson());
+    Entry->SetArrayField(TEXT("ReportWriters"), ReportWriters.ToJson());
+    Entry->SetNumberField(TEXT("LoadTimeSeconds"), LoadTimeSeconds);
+
+    FString EntryString;
+    TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&EntryString);
+    FJsonSerializer::Serialize(Entry, JsonWriter);
+
+    // Ensure path exists.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    if (!FFileHelper::SaveStringToFile(EntryString, *GetFilePath(Key)))
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("FDaeTestResultCache::Store - Unable to write cached result %s."),
+               *GetFilePath(Key));
+    }
+}
+
+FString FDaeTestResultCache::GetFilePath(const FString& Key) const
+{
+    return FPaths::Combine(Directory, Key + TEXT(".json"));
+}
+
+FString FDaeTestResultCache::ComputeEnvironmentHash()
+{
+    TArray<FString> Entries;
+
+    // Code changes aren't reflected by any package, but by the build.
+    Entries.Add(FEngineVersion::Current().ToString());
+    Entries.Add(FApp::GetBuildVersion());
+    Entries.Add(LexToString(FApp::GetBuildConfiguration()));
+
+    TSharedPtr<IPlugin> Plugin =
+        IPluginManager::Get().FindPlugin(TEXT("DaedalicTestAutomationPlugin"));
+
+    if (Plugin.IsValid())
+    {
+        Entries.Add(Plugin->GetDescriptor().VersionName);
+    }
+
+    // Console variables and commands change behavior of all tests.
+    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
+        GetDefault<UDaeTestAutomationPluginSettings>();
+
+    TMap<FString, FString> ConsoleVariables = TestAutomationPluginSettings->ConsoleVariables;
+    ConsoleVariables.KeySort(TLess<FString>());
+
+    for (const auto& ConsoleVariable : ConsoleVariables)
+    {
+        Entries.Add(FString::Printf(TEXT("%s=%s"), *ConsoleVariable.Key, *ConsoleVariable.Value));
+    }
+
+    Entries.Append(TestAutomationPluginSettings->ConsoleCommands);
+
+    return FMD5::HashAnsiString(*FString::Join(Entries, TEXT("\n")));
+}
@@ -0,0 +1,404 @@
+#include "DaeTestSelection.h"
+
+bool FDaeTestSelection::Compile(const FString& Expression, FString& OutError)
+{
+    Nodes.Empty();
+    RootIndex = INDEX_NONE;
+    TokenIndex = 0;
+    Error.Empty();
+
+    if (!Tokenize(Expression, Tokens, OutError))
+    {
+        return false;
+    }
+
+    if (Tokens.Num() == 0)
+    {
+        return true;
+    }
+
+    RootIndex = ParseOr();
+
+    if (Error.IsEmpty() && PeekToken() != nullptr)
+    {
+        Error = FString::Printf(TEXT("Unexpected token: %s"), **PeekToken());
+    }
+
+    if (!Error.IsEmpty())
+    {
+        OutError = Error;
+        Nodes.Empty();
+        RootIndex = INDEX_NONE;
+        return false;
+    }
+
+    return true;
+}
+
+FString FDaeTestSelection::FromLegacyOptions(const FString& TestName, const FString& TestTags,
+                                             const FString& TestPriority)
+{
+    FString Expression;
+
+    if (!TestName.IsEmpty())
+    {
+        Expression = CombineAnd(Expression, FString::Printf(TEXT("name:\"%s\""), *TestName));
+    }
+
+    TArray<FString> Tags;
+    TestTags.ParseIntoArray(Tags, TEXT(";"));
+
+    if (Tags.Num() > 0)
+    {
+        TArray<FString> TagTerms;
+
+        for (const FString& Tag : Tags)
+        {
+            TagTerms.Add(FString::Printf(TEXT("tag:\"%s\""), *Tag));
+        }
+
+        Expression = CombineAnd(Expression, FString::Join(TagTerms, TEXT(" || ")));
+    }
+
+    if (!TestPriority.IsEmpty())
+    {
+        Expression =
+            CombineAnd(Expression, FString::Printf(TEXT("priority:\"%s\".."), *TestPriority));
+    }
+
+    return Expression;
+}
+
+FString FDaeTestSelection::CombineAnd(const FString& First, const FString& Second)
+{
+    if (First.IsEmpty())
+    {
+        return Second;
+    }
+
+    if (Second.IsEmpty())
+    {
+        return First;
+    }
+
+    return FString::Printf(TEXT("(%s) && (%s)"), *First, *Second);
+}
+
+bool FDaeTestSelection::Matches(const FName& MapName, const FDaeTestMapInfo& MapInfo) const
+{
+    return RootIndex == INDEX_NONE || Evaluate(RootIndex, MapName, MapInfo);
+}
+
+bool FDaeTestSelection::ParsePriority(const FString& PriorityString,
+                                      EDaeTestPriority& OutPriority)
+{
+    if (PriorityString.Contains("Critical", ESearchCase::IgnoreCase)
+        || PriorityString.Equals("3"))
+    {
+        OutPriority = EDaeTestPriority::DTP_CriticalPriority;
+        return true;
+    }
+    if (PriorityString.Contains("High", ESearchCase::IgnoreCase) || PriorityString.Equals("2"))
+    {
+        OutPriority = EDaeTestPriority::DTP_HighPriority;
+        return true;
+    }
+    if (PriorityString.Contains("Medium", ESearchCase::IgnoreCase)
+        || PriorityString.Equals("1"))
+    {
+        OutPriority = EDaeTestPriority::DTP_MediumPriority;
+        return true;
+    }
+    if (PriorityString.Contains("Low", ESearchCase::IgnoreCase) || PriorityString.Equals("0"))
+    {
+        OutPriority = EDaeTestPriority::DTP_LowPriority;
+        return true;
+    }
+
+    return false;
+}
+
+bool FDaeTestSelection::Tokenize(const FString& Expression, TArray<FString>& OutTokens,
+                                 FString& OutError)
+{
+    OutTokens.Empty();
+
+    int32 Index = 0;
+
+    while (Index < Expression.Len())
+    {
+        const TCHAR Char = Expression[Index];
+
+        if (FChar::IsWhitespace(Char))
+        {
+            ++Index;
+        }
+        else if (Char == TEXT('(') || Char == TEXT(')') || Char == TEXT('!'))
+        {
+            OutTokens.Add(FString::Chr(Char));
+            ++Index;
+        }
+        else if (Expression.Mid(Index, 2) == TEXT("&&") || Expression.Mid(Index, 2) == TEXT("||"))
+        {
+            OutTokens.Add(Expression.Mid(Index, 2));
+            Index += 2;
+        }
+        else
+        {
+            // Read term, allowing quoted parts.
+            FString Token;
+            bool bQuoted = false;
+
+            while (Index < Expression.Len())
+            {
+                const TCHAR TokenChar = Expression[Index];
+
+                if (TokenChar == TEXT('"'))
+                {
+                    bQuoted = !bQuoted;
+                }
+                else if (!bQuoted
+                         && (FChar::IsWhitespace(TokenChar) || TokenChar == TEXT('(')
+                             || TokenChar == TEXT(')') || Expression.Mid(Index, 2) == TEXT("&&")
+                             || Expression.Mid(Index, 2) == TEXT("||")))
+                {
+                    break;
+                }
+                else
+                {
+                    Token.AppendChar(TokenChar);
+                }
+
+                ++Index;
+            }
+
+            if (bQuoted)
+            {
+                OutError = TEXT("Missing closing quote.");
+                return false;
+            }
+
+            OutTokens.Add(Token);
+        }
+    }
+
+    return true;
+}
+
+int32 FDaeTestSelection::ParseOr()
+{
+    TArray<int32> Children;
+    Children.Add(ParseAnd());
+
+    while (Error.IsEmpty() && PeekToken() != nullptr
+           && IsOperator(*PeekToken(), TEXT("||"), TEXT("OR")))
+    {
+        ++TokenIndex;
+        Children.Add(ParseAnd());
+    }
+
+    return Children.Num() == 1 ? Children[0] : AddNode(ENodeType::Or, Children);
+}
+
+int32 FDaeTestSelection::ParseAnd()
+{
+    TArray<int32> Children;
+    Children.Add(ParseNot());
+
+    while (Error.IsEmpty() && PeekToken() != nullptr && *PeekToken() != TEXT(")")
+           && !IsOperator(*PeekToken(), TEXT("||"), TEXT("OR")))
+    {
+        // Explicit or implicit AND.
+        if (IsOperator(*PeekToken(), TEXT("&&"), TEXT("AND")))
+        {
+            ++TokenIndex;
+        }
+
+        Children.Add(ParseNot());
+    }
+
+    return Children.Num() == 1 ? Children[0] : AddNode(ENodeType::And, Children);
+}
+
+int32 FDaeTestSelection::ParseNot()
+{
+    if (PeekToken() != nullptr && IsOperator(*PeekToken(), TEXT("!"), TEXT("NOT")))
+    {
+        ++TokenIndex;
+
+        TArray<int32> Children;
+        Children.Add(ParseNot());
+        return AddNode(ENodeType::Not, Children);
+    }
+
+    return ParsePrimary();
+}
+
+int32 FDaeTestSelection::ParsePrimary()
+{
+    const FString* Token = PeekToken();
+
+    if (Token == nullptr)
+    {
+        Error = TEXT("Unexpected end of expression.");
+        return INDEX_NONE;
+    }
+
+    ++TokenIndex;
+
+    if (*Token == TEXT("("))
+    {
+        const int32 NodeIndex = ParseOr();
+
+        if (Error.IsEmpty())
+        {
+            if (PeekToken() == nullptr || *PeekToken() != TEXT(")"))
+            {
+                Error = TEXT("Missing closing parenthesis.");
+                return INDEX_NONE;
+            }
+
+            ++TokenIndex;
+        }
+
+        return NodeIndex;
+    }
+
+    if (*Token == TEXT(")") || *Token == TEXT("&&") || *Token == TEXT("||"))
+    {
+        Error = FString::Printf(TEXT("Unexpected token: %s"), **Token);
+        return INDEX_NONE;
+    }
+
+    return ParseTerm(*Token);
+}
+
+int32 FDaeTestSelection::ParseTerm(const FString& Token)
+{
+    FString Key;
+    FString Value;
+
+    if (!Token.Split(TEXT(":"), &Key, &Value))
+    {
+        // Plain words match map names.
+        Key = TEXT("name");
+        Value = Token;
+    }
+
+    ENodeType Type;
+
+    if (Key.Equals(TEXT("name"), ESearchCase::IgnoreCase))
+    {
+        Type = ENodeType::Name;
+    }
+    else if (Key.Equals(TEXT("path"), ESearchCase::IgnoreCase))
+    {
+        Type = ENodeType::Path;
+    }
+    else if (Key.Equals(TEXT("tag"), ESearchCase::IgnoreCase))
+    {
+        Type = ENodeType::Tag;
+    }
+    else if (Key.Equals(TEXT("priority"), ESearchCase::IgnoreCase))
+    {
+        Type = ENodeType::Priority;
+    }
+    else
+    {
+        Error = FString::Printf(TEXT("Unknown term: %s"), *Key);
+        return INDEX_NONE;
+    }
+
+    const int32 NodeIndex = AddNode(Type, TArray<int32>());
+    FNode& Node = Nodes[NodeIndex];
+    Node.Pattern = Value;
+
+    if (Type == ENodeType::Priority)
+    {
+        FString MinString = Value;
+        FString MaxString = Value;
+        Value.Split(TEXT(".."), &MinString, &MaxString);
+
+        if ((!MinString.IsEmpty() && !ParsePriority(MinString, Node.MinPriority))
+            || (!MaxString.IsEmpty() && !ParsePriority(MaxString, Node.MaxPriority)))
+        {
+            Error = FString::Printf(TEXT("Invalid priority: %s"), *Value);
+            return INDEX_NONE;
+        }
+    }
+
+    return NodeIndex;
+}
+
+int32 FDaeTestSelection::AddNode(ENodeType Type, const TArray<int32>& Children)
+{
+    FNode Node;
+    Node.Type = Type;
+    Node.Children = Children;
+    return Nodes.Add(Node);
+}
+
+bool FDaeTestSelection::IsOperator(const FString& Token, const TCHAR* Symbol,
+                                   const TCHAR* Keyword) const
+{
+    return Token == Symbol || Token.Equals(Keyword, ESearchCase::CaseSensitive);
+}
+
+const FString* FDaeTestSelection::PeekToken() const
+{
+    return Tokens.IsValidIndex(TokenIndex) ? &Tokens[TokenIndex] : nullptr;
+}
+
+bool FDaeTestSelection::Evaluate(int32 NodeIndex, const FName& MapName,
+                                 const FDaeTestMapInfo& MapInfo) const
+{
+    const FNode& Node = Nodes[NodeIndex];
+
+    switch (Node.Type)
+    {
+        case ENodeType::And:
+            for (int32 Child : Node.Children)
+            {
+                if (!Evaluate(Child, MapName, MapInfo))
+                {
+                    return false;
+                }
+            }
+            return true;
+
+        case ENodeType::Or:
+            for (int32 Child : Node.Children)
+            {
+                if (Evaluate(Child, MapName, MapInfo))
+                {
+                    return true;
+                }
+            }
+            return false;
+
+        case ENodeType::Not:
+            return !Evaluate(Node.Children[0], MapName, MapInfo);
+
+        case ENodeType::Name:
+            return MapName.ToString().MatchesWildcard(Node.Pattern);
+
+        case ENodeType::Path:
+            return MapInfo.PackageName.ToString().MatchesWildcard(Node.Pattern);
+
+        case ENodeType::Tag:
+            for (const FString& Tag : MapInfo.MetaData.Tags)
+            {
+                if (Tag.MatchesWildcard(Node.Pattern))
+                {
+                    return true;
+                }
+            }
+            return false;
+
+        case ENodeType::Priority:
+            return MapInfo.MetaData.Priority >= Node.MinPriority
+                   && MapInfo.MetaData.Priority <= Node.MaxPriority;
+    }
+
+    return false;
+}
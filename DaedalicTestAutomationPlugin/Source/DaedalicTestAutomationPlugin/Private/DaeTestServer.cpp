@@ -0,0 +1,76 @@
+#include "DaeTestServer.h"
+#include "DaeTestLogCategory.h"
+#include "DaeTestMessageChannel.h"
+#include <Sockets.h>
+
+const int32 FDaeTestServer::DefaultPort = 17891;
+
+const FString FDaeTestServer::MessageTypeRunTests = TEXT("RunTests");
+const FString FDaeTestServer::MessageTypeTestsFinished = TEXT("TestsFinished");
+const FString FDaeTestServer::MessageTypeShutdown = TEXT("Shutdown");
+
+FDaeTestServer::FDaeTestServer()
+    : ListenSocket(nullptr)
+{
+}
+
+FDaeTestServer::~FDaeTestServer()
+{
+    Client = nullptr;
+    FDaeTestMessageChannel::DestroySocket(ListenSocket);
+}
+
+bool FDaeTestServer::Start(int32 Port)
+{
+    ListenSocket = FDaeTestMessageChannel::Listen(Port, TEXT("DaeTestServer"));
+
+    if (ListenSocket == nullptr)
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestServer::Start - Unable to listen for requests on port %d."), Port);
+        return false;
+    }
+
+    UE_LOG(LogDaeTest, Display, TEXT("FDaeTestServer::Start - Listening for requests on port %d."),
+           Port);
+
+    return true;
+}
+
+TSharedPtr<FJsonObject> FDaeTestServer::ReceiveRequest()
+{
+    // Serve one client at a time. Pending clients are accepted after the current one has disconnected.
+    if (Client.IsValid() && !Client->IsConnected())
+    {
+        Client = nullptr;
+    }
+
+    if (!Client.IsValid() && ListenSocket != nullptr)
+    {
+        bool bHasPendingConnection = false;
+
+        if (ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+        {
+            FSocket* ClientSocket = ListenSocket->Accept(TEXT("DaeTestServerClient"));
+
+            if (ClientSocket != nullptr)
+            {
+                Client = MakeShareable(new FDaeTestMessageChannel(ClientSocket));
+
+                UE_LOG(LogDaeTest, Log, TEXT("FDaeTestServer::ReceiveRequest - Client connected."));
+            }
+        }
+    }
+
+    return Client.IsValid() ? Client->Receive() : nullptr;
+}
+
+void FDaeTestServer::SendResponse(const TSharedRef<FJsonObject>& Response)
+{
+    if (!Client.IsValid() || !Client->Send(Response))
+    {
+        UE_LOG(LogDaeTest, Warning,
+               TEXT("FDaeTestServer::SendResponse - Client has disconnected before receiving "
+                    "the response."));
+    }
+}
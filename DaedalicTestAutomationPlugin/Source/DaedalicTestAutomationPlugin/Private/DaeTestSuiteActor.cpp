@@ -8,7 +8,10 @@ ADaeTestSuiteActor::ADaeTestSuiteActor(
     const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
 {
     bRunInPIE = true;
+    MaxConcurrentTests = 1;
+    bRestoreWorldStateAfterEachTest = false;
     TestIndex = -1;
+    bIsStartingTests = false;
 
     PrimaryActorTick.bCanEverTick = true;
 
@@ -42,13 +45,22 @@ void ADaeTestSuiteActor::Tick(float DeltaSeconds)
         return;
     }
 
-    TestTimeSeconds += DeltaSeconds;
+    // Tests may finish while timing out, so check on a copy.
+    TArray<ADaeTestActor*> TimedOutTests;
 
-    ADaeTestActor* CurrentTest = GetCurrentTest();
+    for (FDaeTestSuiteActorTestRun& TestRun : RunningTests)
+    {
+        TestRun.TimeSeconds += DeltaSeconds;
 
-    if (TestTimeSeconds >= CurrentTest->GetTimeoutInSeconds())
+        if (TestRun.TimeSeconds >= TestRun.Test->GetTimeoutInSeconds())
+        {
+            TimedOutTests.Add(TestRun.Test);
+        }
+    }
+
+    for (ADaeTestActor* TimedOutTest : TimedOutTests)
     {
-        CurrentTest->Timeout();
+        TimedOutTest->Timeout();
     }
 }
 
@@ -67,29 +79,52 @@ void ADaeTestSuiteActor::RunAllTests()
 
 bool ADaeTestSuiteActor::IsRunning() const
 {
-    return IsValid(GetCurrentTest());
+    return RunningTests.Num() > 0;
 }
 
 ADaeTestActor* ADaeTestSuiteActor::GetCurrentTest() const
 {
-    return Tests.IsValidIndex(TestIndex) ? Tests[TestIndex] : nullptr;
+    return CurrentTestRun.Test;
 }
 
 UObject* ADaeTestSuiteActor::GetCurrentTestParameter() const
 {
-    const ADaeTestActor* Test = GetCurrentTest();
+    return GetTestParameter(CurrentTestRun.Test, CurrentTestRun.ParameterIndex);
+}
+
+FString ADaeTestSuiteActor::GetCurrentTestName() const
+{
+    return GetTestName(CurrentTestRun.Test, CurrentTestRun.ParameterIndex);
+}
+
+float ADaeTestSuiteActor::GetRemainingTimeoutSeconds() const
+{
+    float RemainingTimeoutSeconds = 0.0f;
+
+    for (const FDaeTestSuiteActorTestRun& TestRun : RunningTests)
+    {
+        RemainingTimeoutSeconds = FMath::Max(
+            RemainingTimeoutSeconds, TestRun.Test->GetTimeoutInSeconds() - TestRun.TimeSeconds);
+    }
+
+    return RemainingTimeoutSeconds;
+}
+
+UObject* ADaeTestSuiteActor::GetTestParameter(const ADaeTestActor* Test,
+                                              int32 ParameterIndex) const
+{
     if (!IsValid(Test))
     {
         return nullptr;
     }
 
     TArray<TSoftObjectPtr<UObject>> TestParameters = Test->GetParameters();
-    if (!TestParameters.IsValidIndex(TestParameterIndex))
+    if (!TestParameters.IsValidIndex(ParameterIndex))
     {
         return nullptr;
     }
     
-    UObject* Parameter = TestParameters[TestParameterIndex].LoadSynchronous();
+    UObject* Parameter = TestParameters[ParameterIndex].LoadSynchronous();
     if (!IsValid(Parameter))
     {
         return nullptr;
@@ -111,10 +146,8 @@ UObject* ADaeTestSuiteActor::GetCurrentTestParameter() const
     return Parameter;
 }
 
-FString ADaeTestSuiteActor::GetCurrentTestName() const
+FString ADaeTestSuiteActor::GetTestName(const ADaeTestActor* Test, int32 ParameterIndex) const
 {
-    ADaeTestActor* Test = GetCurrentTest();
-
     if (!IsValid(Test))
     {
         return FString();
@@ -122,7 +155,7 @@ FString ADaeTestSuiteActor::GetCurrentTestName() const
 
     FString TestName = Test->GetName();
 
-    UObject* Parameter = GetCurrentTestParameter();
+    UObject* Parameter = GetTestParameter(Test, ParameterIndex);
 
     if (IsValid(Parameter))
     {
@@ -149,6 +182,16 @@ FDaeTestReportWriterSet ADaeTestSuiteActor::GetReportWriters() const
     return ReportWriters;
 }
 
+const TArray<ADaeTestActor*>& ADaeTestSuiteActor::GetTests() const
+{
+    return Tests;
+}
+
+void ADaeTestSuiteActor::AddTest(ADaeTestActor* Test)
+{
+    Tests.Add(Test);
+}
+
 void ADaeTestSuiteActor::NotifyOnBeforeAll()
 {
     ReceiveOnBeforeAll();
@@ -171,108 +214,205 @@ void ADaeTestSuiteActor::NotifyOnAfterEach()
 
 void ADaeTestSuiteActor::RunNextTest()
 {
-    ADaeTestActor* CurrentTest = GetCurrentTest();
-
-    // Unregister events.
-    if (IsValid(CurrentTest))
+    // Tests that finish immediately when started are picked up by the loop below.
+    if (bIsStartingTests)
     {
-        CurrentTest->OnTestSuccessful.RemoveDynamic(this, &ADaeTestSuiteActor::OnTestSuccessful);
-        CurrentTest->OnTestFailed.RemoveDynamic(this, &ADaeTestSuiteActor::OnTestFailed);
-        CurrentTest->OnTestSkipped.RemoveDynamic(this, &ADaeTestSuiteActor::OnTestSkipped);
+        return;
     }
 
-    // Prepare test run with next parameter.
-    ++TestParameterIndex;
+    bIsStartingTests = true;
 
-    UObject* CurrentTestParameter = GetCurrentTestParameter();
-
-    if (!IsValid(CurrentTestParameter))
+    while (CanStartNextTest())
     {
-        // Prepare next test.
-        ++TestIndex;
-        TestParameterIndex = 0;
+        // Prepare test run with next parameter.
+        ++TestParameterIndex;
 
-        // Apply parameter providers.
-        ADaeTestActor* NextTest = GetCurrentTest();
+        const ADaeTestActor* PreviousTest = Tests.IsValidIndex(TestIndex) ? Tests[TestIndex] : nullptr;
 
-        if (IsValid(NextTest))
+        if (!IsValid(GetTestParameter(PreviousTest, TestParameterIndex)))
         {
-            NextTest->ApplyParameterProviders();
+            // Prepare next test.
+            ++TestIndex;
+            TestParameterIndex = 0;
+
+            if (!Tests.IsValidIndex(TestIndex))
+            {
+                break;
+            }
+
+            // Apply parameter providers.
+            ADaeTestActor* NextTest = Tests[TestIndex];
+
+            if (IsValid(NextTest))
+            {
+                NextTest->ApplyParameterProviders();
+            }
+        }
+
+        ADaeTestActor* Test = Tests[TestIndex];
+
+        if (IsValid(Test))
+        {
+            StartTest(Test, TestParameterIndex);
+        }
+        else
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("ADaeTestSuiteActor::RunNextTest - %s has invalid test at index %i, "
+                        "skipping."),
+                   *GetName(), TestIndex);
         }
     }
 
-    TestTimeSeconds = 0.0f;
+    bIsStartingTests = false;
 
-    if (!Tests.IsValidIndex(TestIndex))
+    if (Tests.IsValidIndex(TestIndex) || TestIndex < 0 || RunningTests.Num() > 0)
     {
-        // All tests finished.
-        UE_LOG(LogDaeTest, Display, TEXT("ADaeTestSuiteActor::RunNextTest - All tests finished."));
+        return;
+    }
+
+    // All tests finished.
+    UE_LOG(LogDaeTest, Display, TEXT("ADaeTestSuiteActor::RunNextTest - All tests finished."));
+
+    CurrentTestRun = FDaeTestSuiteActorTestRun();
 
-        NotifyOnAfterAll();
+    NotifyOnAfterAll();
 
-        // Check if any test failed.
-        for (const FDaeTestResult& TestResult : Result.TestResults)
+    // Check if any test failed.
+    for (const FDaeTestResult& TestResult : Result.TestResults)
+    {
+        if (!TestResult.FailureMessage.IsEmpty())
         {
-            if (!TestResult.FailureMessage.IsEmpty())
-            {
-                OnTestSuiteFailed.Broadcast(this);
-                return;
-            }
+            OnTestSuiteFailed.Broadcast(this);
+            return;
         }
+    }
+
+    OnTestSuiteSuccessful.Broadcast(this);
+}
 
-        OnTestSuiteSuccessful.Broadcast(this);
+void ADaeTestSuiteActor::RestoreWorldState()
+{
+    if (!bRestoreWorldStateAfterEachTest || RunningTests.Num() > 0 || !WorldSnapshot.IsValid())
+    {
         return;
     }
 
-    ADaeTestActor* Test = GetCurrentTest();
+    WorldSnapshot.Restore();
+    WorldSnapshot.Reset();
+}
 
-    if (IsValid(Test))
+bool ADaeTestSuiteActor::CanStartNextTest() const
+{
+    if (TestIndex >= Tests.Num())
     {
-        FString TestName = GetCurrentTestName();
-        UE_LOG(LogDaeTest, Display, TEXT("ADaeTestSuiteActor::RunNextTest - Test: %s"), *TestName);
+        return false;
+    }
 
-        // Register events.
-        Test->OnTestSuccessful.AddDynamic(this, &ADaeTestSuiteActor::OnTestSuccessful);
-        Test->OnTestFailed.AddDynamic(this, &ADaeTestSuiteActor::OnTestFailed);
-        Test->OnTestSkipped.AddDynamic(this, &ADaeTestSuiteActor::OnTestSkipped);
+    if (RunningTests.Num() <= 0)
+    {
+        return true;
+    }
 
-        // Run test.
-        NotifyOnBeforeEach();
+    if (RunningTests.Num() >= MaxConcurrentTests)
+    {
+        return false;
+    }
 
-        UObject* TestParameter = GetCurrentTestParameter();
-        Test->RunTest(TestParameter);
+    for (const FDaeTestSuiteActorTestRun& TestRun : RunningTests)
+    {
+        if (!TestRun.Test->IsIndependent())
+        {
+            return false;
+        }
     }
-    else
+
+    // Next parameter of a running test has to wait for the previous one to finish.
+    if (Tests.IsValidIndex(TestIndex)
+        && IsValid(GetTestParameter(Tests[TestIndex], TestParameterIndex + 1)))
     {
-        UE_LOG(LogDaeTest, Error,
-               TEXT("ADaeTestSuiteActor::RunNextTest - %s has invalid test at index %i, skipping."),
-               *GetName(), TestIndex);
+        return false;
+    }
 
-        RunNextTest();
+    // Next test might be invalid, in which case it's skipped right away.
+    const int32 NextTestIndex = TestIndex + 1;
+    return !Tests.IsValidIndex(NextTestIndex) || !IsValid(Tests[NextTestIndex])
+           || Tests[NextTestIndex]->IsIndependent();
+}
+
+void ADaeTestSuiteActor::StartTest(ADaeTestActor* Test, int32 ParameterIndex)
+{
+    // Capture world state before the first of all concurrent tests changes it.
+    if (bRestoreWorldStateAfterEachTest && RunningTests.Num() <= 0)
+    {
+        WorldSnapshot.Capture(GetWorld());
     }
+
+    FDaeTestSuiteActorTestRun TestRun;
+    TestRun.Test = Test;
+    TestRun.ParameterIndex = ParameterIndex;
+
+    RunningTests.Add(TestRun);
+    CurrentTestRun = TestRun;
+
+    FString TestName = GetCurrentTestName();
+    UE_LOG(LogDaeTest, Display, TEXT("ADaeTestSuiteActor::RunNextTest - Test: %s"), *TestName);
+
+    // Register events.
+    Test->OnTestSuccessful.AddDynamic(this, &ADaeTestSuiteActor::OnTestSuccessful);
+    Test->OnTestFailed.AddDynamic(this, &ADaeTestSuiteActor::OnTestFailed);
+    Test->OnTestSkipped.AddDynamic(this, &ADaeTestSuiteActor::OnTestSkipped);
+
+    // Run test.
+    OnTestStarted.Broadcast(this, Test);
+    NotifyOnBeforeEach();
+
+    UObject* TestParameter = GetTestParameter(Test, ParameterIndex);
+    Test->RunTest(TestParameter);
 }
 
-void ADaeTestSuiteActor::OnTestSuccessful(ADaeTestActor* Test, UObject* Parameter)
+bool ADaeTestSuiteActor::FinishTest(ADaeTestActor* Test, FDaeTestResult& OutTestResult)
 {
-    if (Test != GetCurrentTest())
+    const int32 RunIndex = RunningTests.IndexOfByPredicate(
+        [Test](const FDaeTestSuiteActorTestRun& TestRun) { return TestRun.Test == Test; });
+
+    if (RunIndex == INDEX_NONE)
     {
         // Prevent tests from reporting multiple results.
-        return;
+        return false;
     }
 
-    FString CurrentTestName = GetCurrentTestName();
+    CurrentTestRun = RunningTests[RunIndex];
+    RunningTests.RemoveAt(RunIndex);
+
+    // Unregister events.
+    Test->OnTestSuccessful.RemoveDynamic(this, &ADaeTestSuiteActor::OnTestSuccessful);
+    Test->OnTestFailed.RemoveDynamic(this, &ADaeTestSuiteActor::OnTestFailed);
+    Test->OnTestSkipped.RemoveDynamic(this, &ADaeTestSuiteActor::OnTestSkipped);
+
+    OutTestResult = FDaeTestResult(GetCurrentTestName(), CurrentTestRun.TimeSeconds);
+    OutTestResult.Data = Test->CollectResults();
+    return true;
+}
+
+void ADaeTestSuiteActor::OnTestSuccessful(ADaeTestActor* Test, UObject* Parameter)
+{
+    FDaeTestResult TestResult;
+
+    if (!FinishTest(Test, TestResult))
+    {
+        return;
+    }
 
     UE_LOG(LogDaeTest, Display, TEXT("ADaeTestSuiteActor::OnTestSuccessful - Test: %s"),
-           *CurrentTestName);
+           *TestResult.TestName);
 
     // Store result.
-    FDaeTestResult TestResult(CurrentTestName, TestTimeSeconds);
-    TestResult.Data = Test->CollectResults();
-
     Result.TestResults.Add(TestResult);
 
     // Run next test.
     NotifyOnAfterEach();
+    RestoreWorldState();
 
     RunNextTest();
 }
@@ -280,27 +420,24 @@ void ADaeTestSuiteActor::OnTestSuccessful(ADaeTestActor* Test, UObject* Paramete
 void ADaeTestSuiteActor::OnTestFailed(ADaeTestActor* Test, UObject* Parameter,
                                       const FString& FailureMessage)
 {
-    if (Test != GetCurrentTest())
+    FDaeTestResult TestResult;
+
+    if (!FinishTest(Test, TestResult))
     {
-        // Prevent tests from reporting multiple results.
         return;
     }
 
-    const FString CurrentTestName = GetCurrentTestName();
-
     UE_LOG(LogDaeTest, Error,
            TEXT("ADaeTestSuiteActor::OnTestFailed - Test: %s, FailureMessage: %s"),
-           *CurrentTestName, *FailureMessage);
+           *TestResult.TestName, *FailureMessage);
 
     // Store result.
-    FDaeTestResult TestResult(CurrentTestName, TestTimeSeconds);
     TestResult.FailureMessage = FailureMessage;
-    TestResult.Data = Test->CollectResults();
-
     Result.TestResults.Add(TestResult);
 
     // Run next test.
     NotifyOnAfterEach();
+    RestoreWorldState();
 
     RunNextTest();
 }
@@ -308,25 +445,23 @@ void ADaeTestSuiteActor::OnTestFailed(ADaeTestActor* Test, UObject* Parameter,
 void ADaeTestSuiteActor::OnTestSkipped(ADaeTestActor* Test, UObject* Parameter,
                                        const FString& SkipReason)
 {
-    if (Test != GetCurrentTest())
+    FDaeTestResult TestResult;
+
+    if (!FinishTest(Test, TestResult))
     {
-        // Prevent tests from reporting multiple results.
         return;
     }
 
-    FString CurrentTestName = GetCurrentTestName();
-
     UE_LOG(LogDaeTest, Display,
-           TEXT("ADaeTestSuiteActor::OnTestSkipped - Test: %s, SkipReason: %s"), *CurrentTestName,
-           *SkipReason);
+           TEXT("ADaeTestSuiteActor::OnTestSkipped - Test: %s, SkipReason: %s"),
+           *TestResult.TestName, *SkipReason);
 
     // Store result.
-    FDaeTestResult TestResult(CurrentTestName, TestTimeSeconds);
     TestResult.SkipReason = SkipReason;
-    TestResult.Data = Test->CollectResults();
-
     Result.TestResults.Add(TestResult);
 
     // Run next test.
+    RestoreWorldState();
+
     RunNextTest();
 }
@@ -51,3 +51,52 @@ float FDaeTestSuiteResult::GetTotalTimeSeconds() const
 
     return TimeSeconds;
 }
+
+TSharedRef<FJsonObject> FDaeTestSuiteResult::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+    JsonObject->SetStringField(TEXT("MapName"), MapName);
+    JsonObject->SetStringField(TEXT("TestSuiteName"), TestSuiteName);
+    JsonObject->SetStringField(TEXT("Timestamp"), Timestamp.ToIso8601());
+
+    TArray<TSharedPtr<FJsonValue>> TestResultValues;
+
+    for (const FDaeTestResult& TestResult : TestResults)
+    {
+        TestResultValues.Add(MakeShareable(new FJsonValueObject(TestResult.ToJson())));
+    }
+
+    JsonObject->SetArrayField(TEXT("TestResults"), TestResultValues);
+    JsonObject->SetBoolField(TEXT("FromCache"), bFromCache);
+
+    return JsonObject;
+}
+
+FDaeTestSuiteResult FDaeTestSuiteResult::FromJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+    FDaeTestSuiteResult Result;
+
+    Result.MapName = JsonObject->GetStringField(TEXT("MapName"));
+    Result.TestSuiteName = JsonObject->GetStringField(TEXT("TestSuiteName"));
+    FDateTime::ParseIso8601(*JsonObject->GetStringField(TEXT("Timestamp")), Result.Timestamp);
+
+    const TArray<TSharedPtr<FJsonValue>>* TestResultValues;
+
+    if (JsonObject->TryGetArrayField(TEXT("TestResults"), TestResultValues))
+    {
+        for (const TSharedPtr<FJsonValue>& TestResultValue : *TestResultValues)
+        {
+            const TSharedPtr<FJsonObject>& TestResultObject = TestResultValue->AsObject();
+
+            if (TestResultObject.IsValid())
+            {
+                Result.TestResults.Add(FDaeTestResult::FromJson(TestResultObject.ToSharedRef()));
+            }
+        }
+    }
+
+    JsonObject->TryGetBoolField(TEXT("FromCache"), Result.bFromCache);
+
+    return Result;
+}
@@ -0,0 +1,184 @@
+#include "DaeTestTransientWorld.h"
+#include "DaeTestActor.h"
+#include "DaeTestLogCategory.h"
+#include "DaeTestResult.h"
+#include "DaeTestSuiteActor.h"
+#include "Settings/DaeTestAutomationPluginSettings.h"
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <GameFramework/WorldSettings.h>
+
+const FName FDaeTestTransientWorld::MapName = TEXT("DaeTestTransientWorld");
+
+bool FDaeTestTransientWorld::HasTests()
+{
+    return GetDefault<UDaeTestAutomationPluginSettings>()->TransientWorldTests.Num() > 0;
+}
+
+FDaeTestMapInfo FDaeTestTransientWorld::GetMapInfo()
+{
+    // Combine meta data of all tests, just like for test maps.
+    FDaeTestMapInfo Info;
+    Info.MetaData.Priority = EDaeTestPriority::DTP_LowPriority;
+
+    for (UClass* TestClass : LoadTestClasses())
+    {
+        const ADaeTestActor* Test = GetDefault<ADaeTestActor>(TestClass);
+        const FDaeTestMapMetaData& TestMetaData = Test->GetTestMetaData();
+
+        for (const FString& Tag : TestMetaData.Tags)
+        {
+            Info.MetaData.Tags.AddUnique(Tag);
+        }
+
+        Info.MetaData.Priority = FMath::Max(Info.MetaData.Priority, TestMetaData.Priority);
+        Info.MetaData.ExpectedErrors.Append(TestMetaData.ExpectedErrors);
+
+        ++Info.TestCount;
+        Info.ParameterCount += Test->GetParameters().Num();
+    }
+
+    if (Info.TestCount == 0)
+    {
+        Info.MetaData.Priority = EDaeTestPriority::DTP_Default;
+    }
+
+    return Info;
+}
+
+void FDaeTestTransientWorld::Run()
+{
+    Result = FDaeTestSuiteResult();
+    ReportWriters = FDaeTestReportWriterSet();
+
+    UWorld* World = CreateWorld();
+
+    if (World == nullptr)
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestTransientWorld::Run - Unable to create transient world."));
+
+        Result.MapName = MapName.ToString();
+        Result.Timestamp = FDateTime::UtcNow();
+
+        FDaeTestResult WorldResult(TEXT("TransientWorld"), 0.0f);
+        WorldResult.FailureMessage = TEXT("Unable to create transient world.");
+        Result.TestResults.Add(WorldResult);
+        return;
+    }
+
+    // Set up test suite.
+    ADaeTestSuiteActor* TestSuite = World->SpawnActor<ADaeTestSuiteActor>();
+    float MaxSimulationSeconds = 0.0f;
+
+    for (UClass* TestClass : LoadTestClasses())
+    {
+        ADaeTestActor* Test = World->SpawnActor<ADaeTestActor>(TestClass);
+
+        if (!IsValid(Test))
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("FDaeTestTransientWorld::Run - Unable to spawn test %s, skipping."),
+                   *TestClass->GetName());
+            continue;
+        }
+
+        TestSuite->AddTest(Test);
+
+        MaxSimulationSeconds +=
+            Test->GetTimeoutInSeconds() * FMath::Max(Test->GetParameters().Num(), 1);
+    }
+
+    ReportWriters = TestSuite->GetReportWriters();
+
+    // Simulate as fast as possible. Tests time out in game time, so this won't take forever.
+    const float DeltaSeconds =
+        GetDefault<UDaeTestAutomationPluginSettings>()->AcceleratedSimulationDeltaSeconds;
+    float SimulationSeconds = 0.0f;
+
+    TestSuite->RunAllTests();
+
+    while (TestSuite->IsRunning() && SimulationSeconds <= MaxSimulationSeconds)
+    {
+        World->Tick(LEVELTICK_All, DeltaSeconds);
+        SimulationSeconds += DeltaSeconds;
+    }
+
+    Result = TestSuite->GetResult();
+    Result.MapName = MapName.ToString();
+
+    if (TestSuite->IsRunning())
+    {
+        FDaeTestResult TimeoutResult(TEXT("TransientWorldTimeout"), SimulationSeconds);
+        TimeoutResult.FailureMessage =
+            FString::Printf(TEXT("Tests of transient world didn't finish after %f seconds."),
+                            SimulationSeconds);
+        Result.TestResults.Add(TimeoutResult);
+    }
+
+    UE_LOG(LogDaeTest, Display,
+           TEXT("FDaeTestTransientWorld::Run - Ran %i tests, simulating %f seconds."),
+           Result.TestResults.Num(), SimulationSeconds);
+
+    DestroyWorld(World);
+}
+
+const FDaeTestSuiteResult& FDaeTestTransientWorld::GetResult() const
+{
+    return Result;
+}
+
+const FDaeTestReportWriterSet& FDaeTestTransientWorld::GetReportWriters() const
+{
+    return ReportWriters;
+}
+
+TArray<UClass*> FDaeTestTransientWorld::LoadTestClasses()
+{
+    TArray<UClass*> TestClasses;
+
+    for (const TSoftClassPtr<ADaeTestActor>& TestClass :
+         GetDefault<UDaeTestAutomationPluginSettings>()->TransientWorldTests)
+    {
+        UClass* LoadedTestClass = TestClass.LoadSynchronous();
+
+        if (LoadedTestClass == nullptr)
+        {
+            UE_LOG(LogDaeTest, Error,
+                   TEXT("FDaeTestTransientWorld::LoadTestClasses - Unable to load test class %s, "
+                        "skipping."),
+                   *TestClass.ToString());
+            continue;
+        }
+
+        TestClasses.Add(LoadedTestClass);
+    }
+
+    return TestClasses;
+}
+
+UWorld* FDaeTestTransientWorld::CreateWorld()
+{
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, MapName);
+
+    if (World == nullptr)
+    {
+        return nullptr;
+    }
+
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    // There's no game mode, so begin play directly.
+    World->InitializeActorsForPlay(FURL());
+    World->GetWorldSettings()->NotifyBeginPlay();
+
+    return World;
+}
+
+void FDaeTestTransientWorld::DestroyWorld(UWorld* World)
+{
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+}
@@ -0,0 +1,199 @@
+#include "DaeTestWatchdog.h"
+#include "DaeTestLogCategory.h"
+#include "DaeUEFeatures.h"
+#include <HAL/Event.h>
+#include <HAL/PlatformMisc.h>
+#include <HAL/PlatformProcess.h>
+#include <HAL/PlatformStackWalk.h>
+#include <HAL/PlatformTime.h>
+#include <HAL/RunnableThread.h>
+#include <HAL/ThreadManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/ScopeLock.h>
+#include <cstdlib>
+
+const uint8 FDaeTestWatchdog::ExitCode = 3;
+
+FDaeTestWatchdog::FDaeTestWatchdog(float InGraceSeconds)
+    : GraceSeconds(InGraceSeconds)
+    , DeadlineSeconds(0.0)
+    , bWatchHeartbeat(false)
+    , Thread(nullptr)
+{
+    StopEvent = FPlatformProcess::GetSynchEventFromPool();
+
+    if (FPlatformProcess::SupportsMultithreading())
+    {
+        Thread = FRunnableThread::Create(this, TEXT("DaeTestWatchdog"));
+    }
+}
+
+FDaeTestWatchdog::~FDaeTestWatchdog()
+{
+    if (Thread != nullptr)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(StopEvent);
+    StopEvent = nullptr;
+}
+
+void FDaeTestWatchdog::Arm(const FString& InDescription, float TimeoutSeconds)
+{
+    FScopeLock Lock(&CriticalSection);
+
+    Description = InDescription;
+    DeadlineSeconds = FPlatformTime::Seconds() + TimeoutSeconds + GraceSeconds;
+    bWatchHeartbeat = false;
+}
+
+void FDaeTestWatchdog::ArmHeartbeat(const FString& InDescription)
+{
+    FScopeLock Lock(&CriticalSection);
+
+    Description = InDescription;
+    DeadlineSeconds = FPlatformTime::Seconds() + GraceSeconds;
+    bWatchHeartbeat = true;
+    HeartbeatCycles.Set(static_cast<int64>(FPlatformTime::Cycles64()));
+}
+
+void FDaeTestWatchdog::Heartbeat()
+{
+    HeartbeatCycles.Set(static_cast<int64>(FPlatformTime::Cycles64()));
+}
+
+void FDaeTestWatchdog::Disarm()
+{
+    FScopeLock Lock(&CriticalSection);
+
+    Description.Empty();
+    DeadlineSeconds = 0.0;
+    bWatchHeartbeat = false;
+}
+
+void FDaeTestWatchdog::SetFailureRecord(const FString& InFailureRecordPath,
+                                        const FString& InFailureRecord)
+{
+    FScopeLock Lock(&CriticalSection);
+
+    FailureRecordPath = InFailureRecordPath;
+    FailureRecord = InFailureRecord;
+}
+
+uint32 FDaeTestWatchdog::Run()
+{
+    while (!bStopping)
+    {
+        // Checking once per second is precise enough for timeouts of whole tests.
+        StopEvent->Wait(1000);
+
+        FString TrippedDescription;
+        FString TrippedFailureRecordPath;
+        FString TrippedFailureRecord;
+
+        {
+            FScopeLock Lock(&CriticalSection);
+
+            if (DeadlineSeconds <= 0.0)
+            {
+                continue;
+            }
+
+            if (bWatchHeartbeat)
+            {
+                const uint64 LastHeartbeatCycles = static_cast<uint64>(HeartbeatCycles.GetValue());
+                const double SecondsSinceHeartbeat =
+                    FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - LastHeartbeatCycles);
+
+                if (SecondsSinceHeartbeat < GraceSeconds)
+                {
+                    continue;
+                }
+            }
+            else if (FPlatformTime::Seconds() < DeadlineSeconds)
+            {
+                continue;
+            }
+
+            TrippedDescription = Description;
+            TrippedFailureRecordPath = FailureRecordPath;
+            TrippedFailureRecord = FailureRecord;
+            DeadlineSeconds = 0.0;
+        }
+
+        Trip(TrippedDescription, TrippedFailureRecordPath, TrippedFailureRecord);
+        return 0;
+    }
+
+    return 0;
+}
+
+void FDaeTestWatchdog::Stop()
+{
+    bStopping = true;
+    StopEvent->Trigger();
+}
+
+void FDaeTestWatchdog::Trip(const FString& TrippedDescription,
+                            const FString& TrippedFailureRecordPath,
+                            const FString& TrippedFailureRecord)
+{
+    UE_LOG(LogDaeTest, Error,
+           TEXT("FDaeTestWatchdog::Trip - %s didn't finish in time, game thread seems to be hung. "
+                "Exiting with code %d."),
+           *TrippedDescription, ExitCode);
+
+    LogThreadCallstacks();
+
+    // Don't touch any state of the game thread, just write what it has prepared for us.
+    if (!TrippedFailureRecordPath.IsEmpty())
+    {
+        UE_LOG(LogDaeTest, Error, TEXT("FDaeTestWatchdog::Trip - Writing failure record to: %s"),
+               *TrippedFailureRecordPath);
+
+        FFileHelper::SaveStringToFile(TrippedFailureRecord, *TrippedFailureRecordPath);
+    }
+
+    GLog->Flush();
+
+#if UE_4_26_OR_LATER
+    FPlatformMisc::RequestExitWithStatus(true, ExitCode);
+#else
+    // Forced exits of older engine versions don't support exit codes.
+    std::_Exit(ExitCode);
+#endif
+}
+
+void FDaeTestWatchdog::LogThreadCallstacks() const
+{
+    const SIZE_T StackTraceSize = 65536;
+    ANSICHAR* StackTrace = static_cast<ANSICHAR*>(FMemory::SystemMalloc(StackTraceSize));
+
+    auto LogThreadCallstack = [StackTrace, StackTraceSize](uint32 ThreadId,
+                                                           const FString& ThreadName) {
+        StackTrace[0] = 0;
+        FPlatformStackWalk::ThreadStackWalkAndDump(StackTrace, StackTraceSize, 0, ThreadId);
+
+        UE_LOG(LogDaeTest, Error, TEXT("Callstack of thread %s (%u):%s%s"), *ThreadName, ThreadId,
+               LINE_TERMINATOR, ANSI_TO_TCHAR(StackTrace));
+    };
+
+    LogThreadCallstack(GGameThreadId, TEXT("GameThread"));
+
+#if UE_4_26_OR_LATER
+    const uint32 WatchdogThreadId = FPlatformTLS::GetCurrentThreadId();
+
+    FThreadManager::Get().ForEachThread(
+        [&LogThreadCallstack, WatchdogThreadId](uint32 ThreadId, FRunnableThread* RunnableThread) {
+            if (ThreadId != WatchdogThreadId && ThreadId != GGameThreadId)
+            {
+                LogThreadCallstack(ThreadId, RunnableThread->GetThreadName());
+            }
+        });
+#endif
+
+    FMemory::SystemFree(StackTrace);
+}
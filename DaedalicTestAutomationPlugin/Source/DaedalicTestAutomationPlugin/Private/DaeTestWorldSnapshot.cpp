@@ -0,0 +1,245 @@
+#include "DaeTestWorldSnapshot.h"
+#include "DaeTestActor.h"
+#include "DaeTestLogCategory.h"
+#include "DaeTestParameterProviderActor.h"
+#include "DaeTestSuiteActor.h"
+#include <EngineUtils.h>
+#include <Components/PrimitiveComponent.h>
+#include <Engine/Brush.h>
+#include <Engine/LevelScriptActor.h>
+#include <Engine/World.h>
+#include <GameFramework/Controller.h>
+#include <GameFramework/Info.h>
+#include <GameFramework/Pawn.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+#include <Serialization/ObjectAndNameAsStringProxyArchive.h>
+
+void FDaeTestWorldSnapshot::Capture(UWorld* InWorld)
+{
+    Reset();
+
+    World = InWorld;
+
+    for (TActorIterator<AActor> ActorIt(InWorld); ActorIt; ++ActorIt)
+    {
+        AActor* Actor = *ActorIt;
+
+        ExistingActors.Add(Actor);
+
+        // Controllers are restored along with their pawns, but AI controllers spawned later are still destroyed.
+        if (!IsRelevantActor(Actor) || Actor->IsA<AController>())
+        {
+            continue;
+        }
+
+        FDaeTestWorldSnapshotActor SnapshotActor;
+        SnapshotActor.Actor = Actor;
+        SnapshotActor.Class = Actor->GetClass();
+        SnapshotActor.Name = Actor->GetFName();
+        SnapshotActor.Level = Actor->GetLevel();
+        SnapshotActor.Transform = Actor->GetActorTransform();
+
+        SerializeObject(Actor, SnapshotActor.Data);
+
+        TInlineComponentArray<UActorComponent*> Components;
+        Actor->GetComponents(Components);
+
+        for (UActorComponent* Component : Components)
+        {
+            SerializeObject(Component, SnapshotActor.ComponentData.Add(Component->GetFName()));
+        }
+
+        Actors.Add(SnapshotActor);
+    }
+
+    UE_LOG(LogDaeTest, Log, TEXT("FDaeTestWorldSnapshot::Capture - Captured %i actors of %s."),
+           Actors.Num(), *InWorld->GetName());
+}
+
+void FDaeTestWorldSnapshot::Restore()
+{
+    UWorld* SnapshotWorld = World.Get();
+
+    if (SnapshotWorld == nullptr)
+    {
+        return;
+    }
+
+    // Destroy actors spawned since capturing.
+    TArray<AActor*> SpawnedActors;
+
+    for (TActorIterator<AActor> ActorIt(SnapshotWorld); ActorIt; ++ActorIt)
+    {
+        if (!ExistingActors.Contains(*ActorIt) && IsRelevantActor(*ActorIt))
+        {
+            SpawnedActors.Add(*ActorIt);
+        }
+    }
+
+    for (AActor* SpawnedActor : SpawnedActors)
+    {
+        SpawnedActor->Destroy();
+    }
+
+    // Respawn destroyed actors first, so that references to them can be restored afterwards.
+    int32 RespawnedActorCount = 0;
+
+    for (FDaeTestWorldSnapshotActor& SnapshotActor : Actors)
+    {
+        if (SnapshotActor.Actor.IsValid())
+        {
+            continue;
+        }
+
+        SnapshotActor.Actor = RespawnActor(SnapshotWorld, SnapshotActor);
+
+        if (SnapshotActor.Actor.IsValid())
+        {
+            ExistingActors.Add(SnapshotActor.Actor);
+            ++RespawnedActorCount;
+        }
+    }
+
+    // Restore state.
+    for (const FDaeTestWorldSnapshotActor& SnapshotActor : Actors)
+    {
+        AActor* Actor = SnapshotActor.Actor.Get();
+
+        if (Actor == nullptr)
+        {
+            continue;
+        }
+
+        DeserializeObject(Actor, SnapshotActor.Data);
+
+        TInlineComponentArray<UActorComponent*> Components;
+        Actor->GetComponents(Components);
+
+        for (UActorComponent* Component : Components)
+        {
+            const TArray<uint8>* ComponentData =
+                SnapshotActor.ComponentData.Find(Component->GetFName());
+
+            if (ComponentData != nullptr)
+            {
+                DeserializeObject(Component, *ComponentData);
+            }
+        }
+
+        Actor->SetActorTransform(SnapshotActor.Transform, false, nullptr,
+                                 ETeleportType::ResetPhysics);
+
+        for (UActorComponent* Component : Components)
+        {
+            if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+            {
+                SceneComponent->UpdateComponentToWorld();
+            }
+
+            if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component))
+            {
+                if (PrimitiveComponent->IsSimulatingPhysics())
+                {
+                    PrimitiveComponent->SetPhysicsLinearVelocity(FVector::ZeroVector);
+                    PrimitiveComponent->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+                }
+            }
+
+            Component->MarkRenderStateDirty();
+        }
+    }
+
+    UE_LOG(LogDaeTest, Log,
+           TEXT("FDaeTestWorldSnapshot::Restore - Restored %i actors of %s, destroyed %i spawned "
+                "and respawned %i destroyed ones."),
+           Actors.Num(), *SnapshotWorld->GetName(), SpawnedActors.Num(), RespawnedActorCount);
+}
+
+bool FDaeTestWorldSnapshot::IsValid() const
+{
+    return World.IsValid();
+}
+
+void FDaeTestWorldSnapshot::Reset()
+{
+    World = nullptr;
+    Actors.Empty();
+    ExistingActors.Empty();
+}
+
+bool FDaeTestWorldSnapshot::IsRelevantActor(const AActor* Actor)
+{
+    if (Actor->IsA<ADaeTestActor>() || Actor->IsA<ADaeTestSuiteActor>()
+        || Actor->IsA<ADaeTestParameterProviderActor>() || Actor->IsA<AInfo>()
+        || Actor->IsA<ABrush>() || Actor->IsA<ALevelScriptActor>())
+    {
+        return false;
+    }
+
+    // Players survive between tests.
+    if (const AController* Controller = Cast<AController>(Actor))
+    {
+        return !Controller->IsPlayerController();
+    }
+
+    if (const APawn* Pawn = Cast<APawn>(Actor))
+    {
+        return !Pawn->IsPlayerControlled();
+    }
+
+    return true;
+}
+
+void FDaeTestWorldSnapshot::SerializeObject(UObject* Object, TArray<uint8>& OutData)
+{
+    // Persistent archives skip transient properties, and references are stored by path, so they survive respawning.
+    FMemoryWriter MemoryWriter(OutData, true);
+    FObjectAndNameAsStringProxyArchive Archive(MemoryWriter, false);
+    Object->SerializeScriptProperties(Archive);
+}
+
+void FDaeTestWorldSnapshot::DeserializeObject(UObject* Object, const TArray<uint8>& Data)
+{
+    FMemoryReader MemoryReader(Data, true);
+    FObjectAndNameAsStringProxyArchive Archive(MemoryReader, false);
+    Object->SerializeScriptProperties(Archive);
+}
+
+AActor* FDaeTestWorldSnapshot::RespawnActor(UWorld* World,
+                                            const FDaeTestWorldSnapshotActor& SnapshotActor)
+{
+    UClass* ActorClass = SnapshotActor.Class.Get();
+    ULevel* Level = SnapshotActor.Level.Get();
+
+    if (ActorClass == nullptr || Level == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Destroyed actor keeps its name until garbage collected.
+    UObject* DestroyedActor = StaticFindObjectFast(nullptr, Level, SnapshotActor.Name);
+
+    if (DestroyedActor != nullptr)
+    {
+        DestroyedActor->Rename(nullptr, GetTransientPackage(),
+                               REN_DontCreateRedirectors | REN_ForceNoResetLoaders
+                                   | REN_NonTransactional);
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.Name = SnapshotActor.Name;
+    SpawnParameters.OverrideLevel = Level;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    AActor* Actor = World->SpawnActor(ActorClass, &SnapshotActor.Transform, SpawnParameters);
+
+    if (Actor == nullptr)
+    {
+        UE_LOG(LogDaeTest, Error,
+               TEXT("FDaeTestWorldSnapshot::RespawnActor - Unable to respawn %s of class %s."),
+               *SnapshotActor.Name.ToString(), *ActorClass->GetName());
+    }
+
+    return Actor;
+}
@@ -10,21 +10,6 @@ UDaeTestAutomationPluginSettings::UDaeTestAutomationPluginSettings()
 {
 }
 
-void UDaeTestAutomationPluginSettings::SetTestMetaData(const AActor* TestActor, const FDaeTestMapMetaData& TestMetaData)
-{
-	UDaeTestAutomationPluginSettings* Settings = GetMutableDefault<UDaeTestAutomationPluginSettings>();
-	const FString TestName = TestActor->GetWorld()->GetName();
-	if (Settings->TestMapsMetaData.Contains(TestName))
-	{
-		Settings->TestMapsMetaData[TestName] = TestMetaData;
-	}
-	else
-	{
-		Settings->TestMapsMetaData.Add(TestName, TestMetaData);
-	}
-	Settings->UpdateDefaultConfigFile();
-}
-
 void UDaeTestAutomationPluginSettings::PostInitProperties()
 {
     Super::PostInitProperties();
@@ -5,7 +5,10 @@
 struct DAEDALICTESTAUTOMATIONPLUGIN_API FDaeGauntletStates : FGauntletStates
 {
     static FName LoadingNextMap;
+    static FName StreamingNextMap;
     static FName DiscoveringTests;
     static FName Running;
     static FName Finished;
+    static FName WaitingForRequest;
+    static FName WaitingForTestMap;
 };
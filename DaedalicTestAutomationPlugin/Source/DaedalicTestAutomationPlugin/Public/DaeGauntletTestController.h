@@ -1,12 +1,25 @@
 #pragma once
 
+#include "DaeTestCheckpoint.h"
+#include "DaeTestDurationHistory.h"
+#include "DaeTestMapInfo.h"
+#include "DaeTestReportWriterSet.h"
+#include "DaeTestResultCache.h"
+#include "DaeTestSelection.h"
 #include "DaeTestSuiteResult.h"
 #include "Settings/DaeTestMapMetaData.h"
 #include <CoreMinimal.h>
 #include <GauntletTestController.h>
 #include "DaeGauntletTestController.generated.h"
 
+class ADaeTestActor;
 class ADaeTestSuiteActor;
+class ULevelStreamingDynamic;
+class FDaeTestCoordinator;
+class FDaeTestMessageChannel;
+class FDaeTestReportWriterQueue;
+class FDaeTestServer;
+class FDaeTestWatchdog;
 
 /** Controller for automated tests run by Gauntlet. */
 UCLASS()
@@ -21,16 +34,231 @@ public:
 
 private:
     TArray<FName> MapNames;
+
+    /** Package names and meta data of all test maps, by map name. */
+    TMap<FName, FDaeTestMapInfo> MapInfos;
+
     int32 MapIndex;
     TArray<FDaeTestSuiteResult> Results;
 
+    /** Durations of previous runs of the test maps. */
+    FDaeTestDurationHistory DurationHistory;
+
+    /** Where to read and write durations of test map runs from and to. */
+    FString DurationHistoryPath;
+
+    /** Whether the duration history or a snapshot of it has been passed explicitly, and thus can be expected to be shared by all shards. */
+    bool bHasSharedDurationHistory;
+
+    /** Real time the current test map started loading, in seconds. */
+    double MapLoadStartTime;
+
+    /** Real time it took to load the current test map, in seconds. */
+    double MapLoadTimeSeconds;
+
+    /** Real time the test suite of the current test map started running, in seconds. */
+    double MapStartTime;
+
+    /** Game time the test suite of the current test map started running, in seconds. */
+    double MapStartGameTime;
+
+    /** How long the current test map is allowed to run, in seconds. Zero if there's no limit. */
+    float MapTimeoutSeconds;
+
+    /** Test suite of the current test map. */
+    TWeakObjectPtr<ADaeTestSuiteActor> CurrentTestSuite;
+
+    /** Exits the process if a test map or test doesn't finish in time, even if the game thread is hung. */
+    TSharedPtr<FDaeTestWatchdog> Watchdog;
+
+    /** What the watchdog is currently waiting for, e.g. the name of the current test. */
+    FString WatchdogDescription;
+
+    /** Whether the current test map is simulated with a fixed timestep and an uncapped frame rate. */
+    bool bAcceleratedSimulation;
+
+    /** Timestep settings before starting accelerated simulation, to restore afterwards. */
+    bool bPreviousUseFixedTimeStep;
+    double PreviousFixedDeltaTime;
+    float PreviousMaxFPS;
+    float PreviousTimeDilation;
+
+    /** Long package name of the persistent world to stream test maps into, if running test maps in batches. */
+    FString StreamingPersistentMap;
+
+    /** Whether travel to the persistent world to stream test maps into has been started, but not finished yet. */
+    bool bTravelingToStreamingPersistentMap;
+
+    /** Streaming sublevel of the current test map, if it has been streamed into the persistent world. */
+    TWeakObjectPtr<ULevelStreamingDynamic> CurrentStreamingLevel;
+
+    /** Streaming sublevel of the previous test map, while it's being unloaded. */
+    TWeakObjectPtr<ULevelStreamingDynamic> UnloadingStreamingLevel;
+
+    /** Hands out test maps to worker processes, if this is the coordinator of a distributed run. */
+    TSharedPtr<FDaeTestCoordinator> Coordinator;
+
+    /** Connection to the coordinator, if this is a worker of a distributed run. */
+    TSharedPtr<FDaeTestMessageChannel> CoordinatorChannel;
+
+    /** Whether this is a worker that receives its test maps from a coordinator. */
+    bool bIsWorker;
+
+    /** Local port of the coordinator, if this is a worker of a distributed run. */
+    int32 CoordinatorPort;
+
+    /** Real time the worker has started trying to connect to the coordinator, or 0 if it's done with that. */
+    double CoordinatorConnectStartTime;
+
+    /** Real time of the last attempt to connect to the coordinator, in seconds. */
+    double LastCoordinatorConnectTime;
+
+    /** Real time the next test map has been requested from the coordinator, or 0 if not requested yet. */
+    double TestMapRequestTime;
+
+    /** Accepts test run requests after all tests have finished, if the process is supposed to stay resident. */
+    TSharedPtr<FDaeTestServer> TestServer;
+
+    /** Compiled expression for selecting the test maps to run. */
+    FDaeTestSelection Selection;
+
+    /** Whether to run only test maps that depend on any of the changed packages. */
+    bool bSelectChangedPackagesOnly;
+
+    /** Long names of the packages that have changed, for selecting affected test maps only. */
+    TSet<FName> ChangedPackages;
+
+    /** Indices of the test maps to run, in order. */
+    TArray<int32> Plan;
+
+    /** Index of the current test map in the plan. */
+    int32 PlanIndex;
+
+    /** Where to write test reports to. */
+    FString ReportPath;
+
+    /** Records progress of this run, for resuming after a crash. */
+    FDaeTestCheckpoint Checkpoint;
+
+    /** Remembers passing results of test maps, for skipping them as long as they don't change. */
+    FDaeTestResultCache ResultCache;
+
+    /** Result cache keys of all planned test maps. */
+    TMap<FName, FString> ResultCacheKeys;
+
+    /** Writes test reports in the background, as test maps finish. */
+    TSharedPtr<FDaeTestReportWriterQueue> ReportWriterQueue;
+
+    /** Package that's currently being prefetched for the next test map, if any. */
+    FName PendingPrefetchPackageName;
+
+    /** Packages of the next test map that are still to be prefetched. */
+    TArray<FName> PrefetchQueue;
+
+    /** Physical memory used by the process when prefetching the next test map started, in bytes. */
+    uint64 PrefetchStartUsedPhysical;
+
+    /** Prefetched assets of the next test map, kept from being garbage collected until it has been loaded. */
+    UPROPERTY()
+    TArray<UObject*> PrefetchedAssets;
+
+    /** Restricts the planned test maps to the shard this client is supposed to run, if any. */
+    void ApplyShard();
+
+    /** Restores results of a previous run from the checkpoint, fails the test map it crashed in, and removes both from the plan. */
+    void ResumeFromCheckpoint();
+
+    /** Reports cached results of all planned test maps that haven't changed since passing before, and removes them from the plan. */
+    void ApplyResultCache();
+
+    /** Starts handing out the discovered test maps to worker processes. */
+    void StartCoordinator(int32 Port);
+
+    /** Tries to connect to the coordinator to receive test maps from, at most once per second. Doesn't block. */
+    bool ConnectToCoordinator();
+
     void LoadNextTestMap();
-    /** Does the test has one of the required tags? */
-    bool DoesMapHasTag(const FString& TestName, const TArray<FString>& RequiredTags) const;
-    static EDaeTestPriority ConvertStringToPriority(const FString& TestPriorityString);
+
+    /** Asks the coordinator for the next test map to run, and checks for its answer. Doesn't block. */
+    void RequestNextTestMap();
+
+    /** Whether the specified test map can be streamed into the persistent world, instead of traveling there. */
+    bool ShouldStreamTestMap(int32 Index) const;
+
+    /** Starts streaming the current test map into the persistent world, and checks whether it has become visible. */
+    void StreamTestMap();
+
+    /** Starts unloading the streaming sublevel of the current test map, if any. */
+    void UnloadStreamedTestMap();
+
+    /** Starts loading the hard dependencies of the next planned test map in the background. */
+    void PrefetchNextTestMap();
+
+    /** Starts loading the next queued package in the background, unless the prefetch memory budget is exhausted. */
+    void PrefetchNextPackage();
+
+    void OnPrefetchPackageLoaded(const FName& PackageName, UPackage* LoadedPackage,
+                                 EAsyncLoadingResult::Type Result);
+
+    /** Stops prefetching and allows prefetched assets to be garbage collected. */
+    void ReleasePrefetchedAssets();
+
+    /** Switches to a fixed timestep, an uncapped frame rate and the specified global time dilation. */
+    void BeginAcceleratedSimulation(float TimeDilation);
+
+    /** Restores the timestep, frame rate and time dilation from before accelerated simulation, if active. */
+    void EndAcceleratedSimulation();
+
+    /** Time the current test map has been running for, in seconds. Game time for accelerated test maps, real time otherwise. */
+    double GetMapTimeSeconds() const;
+
+    /** Compiles the specified test filter expression, combined with the legacy test name, tags and priority options. */
+    bool CompileSelection(const FString& TestFilter, const FString& TestName,
+                          const FString& TestTags, const FString& TestPriority);
+
+    /** Reads the changed packages from the specified file or list separated by semicolons, and whether to select affected test maps only. */
+    void ParseChangedPackages(const FString& ChangedPackagesOption);
+
+    /** Selects the test maps to run, in order. */
+    void BuildPlan();
+
+    /** Logs the test maps that are going to be run, without running them. */
+    void LogPlan() const;
+
+    /** Remembers durations, finishes Gauntlet and exits with the overall result. */
+    void FinishAllTests();
+
+    /** Runs the test selection of the specified test server request, or shuts down the server. */
+    void HandleTestServerRequest(const TSharedRef<FJsonObject>& Request);
+
+    /** Sends the results of all tests of the current test server request. */
+    void SendTestServerResponse();
+
 
     UFUNCTION()
     void OnTestSuiteFinished(ADaeTestSuiteActor* TestSuite);
 
+    UFUNCTION()
+    void OnTestStarted(ADaeTestSuiteActor* TestSuite, ADaeTestActor* Test);
+
+    /** Prepares the failure record the watchdog writes if the game thread hangs, based on the specified results so far. */
+    void UpdateWatchdogFailureRecord(const FDaeTestSuiteResult& Result,
+                                     const FDaeTestReportWriterSet& ReportWriters);
+
+    /** Fails the current test map because it ran longer than it was allowed to. */
+    void OnTestMapTimedOut();
+
+    /** Stores or sends the specified result, and proceeds with the next test map. */
+    void FinishTestMap(const FDaeTestSuiteResult& TestSuiteResult,
+                       const FDaeTestReportWriterSet& ReportWriters);
+
+    /** Sends the specified result to the coordinator, if this is a worker of a distributed run. */
+    void SendResultToCoordinator(const FDaeTestSuiteResult& Result,
+                                 const FDaeTestReportWriterSet& ReportWriters);
+
+    /** Stores the specified result, remembers its duration and appends it to test reports. */
+    void StoreResult(const FDaeTestSuiteResult& Result, const FDaeTestReportWriterSet& ReportWriters,
+                     float LoadTimeSeconds);
+
     FString ParseCommandLineOption(const FString& Key) const;
 };
@@ -40,12 +40,18 @@ public:
     /** Gets how long this test is allowed to run before it fails automatically, in seconds. */
     float GetTimeoutInSeconds() const;
 
+    /** Whether this test may run at the same time as other independent tests of its suite. */
+    bool IsIndependent() const;
+
     /** Flag the test that it had a timeout. The test ran longer than TimeoutInSeconds. */
     void Timeout();
 
     /** Gets the parameters to run this test with, one per run.  */
     TArray<TSoftObjectPtr<UObject>> GetParameters() const;
 
+    /** Gets the optional meta data of this test, e.g. tags and priority. */
+    const FDaeTestMapMetaData& GetTestMetaData() const;
+
     /** Gets the parameter for the current test run. */
     UFUNCTION(BlueprintPure)
     UObject* GetCurrentParameter() const;
@@ -103,10 +109,6 @@ public:
     FDaeTestActorTestSkippedSignature OnTestSkipped;
 
 protected:
-#if WITH_EDITOR
-	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
-#endif
-
     /** How long this test is allowed to run before it fails automatically, in seconds. */
     UPROPERTY(EditAnywhere)
     float TimeoutInSeconds;
@@ -120,6 +122,11 @@ private:
     UPROPERTY(EditAnywhere)
     TArray<TSoftObjectPtr<UObject>> Parameters;
 
+    /** Whether this test only touches actors that no other test touches, allowing it to run at the same time as other independent
+     * tests of its suite (see MaxConcurrentTests of the test suite). Runs with different parameters still happen one after another. */
+    UPROPERTY(EditAnywhere)
+    bool bIndependent = false;
+
     /** Additional providers for appending parameters for this test. Applied exactly once before the first test run. */
     UPROPERTY(EditAnywhere)
     TArray<ADaeTestParameterProviderActor*> ParameterProviders;
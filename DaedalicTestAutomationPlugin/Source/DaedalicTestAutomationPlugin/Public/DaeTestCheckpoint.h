@@ -0,0 +1,78 @@
+#pragma once
+
+#include "DaeTestReportWriterSet.h"
+#include "DaeTestSuiteResult.h"
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+
+class IFileHandle;
+
+/** Result of a test map that has finished before, restored from a checkpoint or the result cache. */
+struct DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestCheckpointResult
+{
+    /** Result of the test suite of the test map. */
+    FDaeTestSuiteResult Result;
+
+    /** Report writers the result was supposed to be written with. */
+    FDaeTestReportWriterSet ReportWriters;
+
+    /** Real time it took to load the test map, in seconds. */
+    float LoadTimeSeconds = 0.0f;
+};
+
+/**
+ * Records progress of a test run in a file, one JSON event per line, as soon as it happens.
+ * Allows resuming the run after a crash, skipping all test maps that have finished before.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestCheckpoint
+{
+public:
+    /** Event types of checkpoint files. */
+    static const FString EventTypeTestMapStarted;
+    static const FString EventTypeTestMapFinished;
+
+    FDaeTestCheckpoint();
+    ~FDaeTestCheckpoint();
+
+    /** Gets the path of the checkpoint file to use if none is specified, for the specified shard (-1 if not sharding). */
+    static FString GetDefaultFilePath(int32 ShardIndex);
+
+    /** Starts recording to the specified file. If resuming, restores progress from that file first. */
+    bool Open(const FString& FilePath, bool bResume);
+
+    /** Whether progress is being recorded. */
+    bool IsOpen() const;
+
+    /** Records that the specified test map is about to be loaded. */
+    void AppendTestMapStarted(const FName& MapName);
+
+    /** Records the result of a test map that has finished. */
+    void AppendTestMapFinished(const FDaeTestSuiteResult& Result,
+                               const FDaeTestReportWriterSet& ReportWriters,
+                               float LoadTimeSeconds);
+
+    /** Gets all test map results restored when resuming. */
+    const TArray<FDaeTestCheckpointResult>& GetRestoredResults() const;
+
+    /** Gets the test map that had started, but never finished before resuming (e.g. because it crashed), if any. */
+    FName GetInterruptedMapName() const;
+
+    /** Gets the last lines of the log of the previous run, if it can be found. */
+    static TArray<FString> GetPreviousLogTail(int32 NumLines);
+
+private:
+    /** Checkpoint file being written. */
+    TUniquePtr<IFileHandle> File;
+
+    /** Test map results restored when resuming. */
+    TArray<FDaeTestCheckpointResult> RestoredResults;
+
+    /** Test map that had started, but never finished before resuming. */
+    FName InterruptedMapName;
+
+    /** Reads all events from the specified file. */
+    void ReadFile(const FString& FilePath);
+
+    /** Writes the specified event to the checkpoint file, and flushes it to disk. */
+    void AppendEvent(const TSharedRef<FJsonObject>& Event);
+};
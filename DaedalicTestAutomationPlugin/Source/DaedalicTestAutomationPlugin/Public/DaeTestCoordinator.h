@@ -0,0 +1,83 @@
+#pragma once
+
+#include "DaeTestMapInfo.h"
+#include "DaeTestReportWriterSet.h"
+#include "DaeTestSuiteResult.h"
+#include <CoreMinimal.h>
+
+class FDaeTestMessageChannel;
+class FSocket;
+
+DECLARE_DELEGATE_ThreeParams(FDaeTestCoordinatorResultReceivedSignature,
+                             const FDaeTestSuiteResult& /*Result*/,
+                             const FDaeTestReportWriterSet& /*ReportWriters*/,
+                             float /*LoadTimeSeconds*/);
+
+/**
+ * Hands out test maps to local worker processes on request, and receives their results.
+ * Workers pull the next test map as soon as they're finished with the previous one, so no worker
+ * stays idle while there are test maps left.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestCoordinator
+{
+public:
+    /** Default local port to listen for workers on. */
+    static const int32 DefaultPort;
+
+    /** Message types exchanged between coordinator and workers. */
+    static const FString MessageTypeRequestTestMap;
+    static const FString MessageTypeRunTestMap;
+    static const FString MessageTypeAllTestMapsFinished;
+    static const FString MessageTypeTestMapFinished;
+
+    FDaeTestCoordinator();
+    ~FDaeTestCoordinator();
+
+    /** Starts listening for workers on the specified local port, handing out the passed test maps in order. */
+    bool Start(int32 Port, const TArray<FName>& InMapNames,
+               const TMap<FName, FDaeTestMapInfo>& InMapInfos);
+
+    /** Accepts new workers, and processes their requests and results. */
+    void Tick();
+
+    /** Whether all test maps have been run. */
+    bool IsFinished() const;
+
+    /** Event when a worker has sent the result of a test map. */
+    FDaeTestCoordinatorResultReceivedSignature OnResultReceived;
+
+private:
+    /** Worker process connected to this coordinator. */
+    struct FWorker
+    {
+        /** Connection to the worker. */
+        TSharedPtr<FDaeTestMessageChannel> Channel;
+
+        /** Test map the worker is currently running. */
+        FName MapName;
+    };
+
+    /** Socket to accept new workers with. */
+    FSocket* ListenSocket;
+
+    /** Test maps that haven't been handed out yet, in order. */
+    TArray<FName> PendingMapNames;
+
+    /** Package names and meta data of all test maps, by map name. */
+    TMap<FName, FDaeTestMapInfo> MapInfos;
+
+    /** Currently connected workers. */
+    TArray<FWorker> Workers;
+
+    /** Real time the last worker has been connected (or the coordinator has started), in seconds. */
+    double LastWorkerTime;
+
+    /** Whether any worker has ever connected. */
+    bool bHadWorkers;
+
+    /** Processes the specified message of the passed worker. */
+    void HandleMessage(FWorker& Worker, const TSharedRef<FJsonObject>& Message);
+
+    /** Reports the specified test map as failed, e.g. because its worker crashed. */
+    void FailTestMap(const FName& MapName, const FString& FailureMessage);
+};
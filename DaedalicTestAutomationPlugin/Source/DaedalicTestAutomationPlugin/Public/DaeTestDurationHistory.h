@@ -0,0 +1,36 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/** Durations of previous runs of test maps, e.g. for balancing shards and deriving timeouts. */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestDurationHistory
+{
+public:
+    /** Gets the path of the duration history file to use if none is specified. */
+    static FString GetDefaultFilePath();
+
+    /** Loads all durations from the specified file, if it exists. */
+    void Load(const FString& FilePath);
+
+    /** Merges all durations recorded since loading into the specified file, replacing it as a whole. */
+    void Save(const FString& FilePath) const;
+
+    /** Whether a duration is known for the specified map. */
+    bool Contains(const FName& MapName) const;
+
+    /** Gets the last known duration of the specified map, in seconds, or the passed default duration if unknown. */
+    float GetDurationSeconds(const FName& MapName, float DefaultDurationSeconds) const;
+
+    /** Records the duration of a run of the specified map, in seconds. */
+    void SetDurationSeconds(const FName& MapName, float DurationSeconds);
+
+private:
+    /** Durations of all known maps, in seconds. */
+    TMap<FName, float> DurationsSeconds;
+
+    /** Durations recorded since loading, in seconds. */
+    TMap<FName, float> RecordedDurationsSeconds;
+
+    /** Reads all durations from the specified file into the passed map. */
+    static void ReadFile(const FString& FilePath, TMap<FName, float>& OutDurationsSeconds);
+};
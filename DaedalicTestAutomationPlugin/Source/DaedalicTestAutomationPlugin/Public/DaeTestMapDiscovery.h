@@ -0,0 +1,55 @@
+#pragma once
+
+#include "DaeTestMapInfo.h"
+#include <CoreMinimal.h>
+
+class UDaeTestAutomationPluginSettings;
+
+/**
+ * Finds all test maps by scanning the configured test map folders and additional test maps, only.
+ * Results are stored in a manifest that is reused as long as neither the settings nor any of the scanned map files change.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestMapDiscovery
+{
+public:
+    /** Gets the path of the discovery manifest to use if none is specified. */
+    static FString GetDefaultManifestPath();
+
+    /** Discovers all test maps, reusing the specified manifest if it's still up-to-date. Pass an empty path to always scan. */
+    void Discover(const FString& ManifestPath);
+
+    /** Gets the names of all discovered test maps, in lexical order. */
+    const TArray<FName>& GetMapNames() const;
+
+    /** Gets package names and meta data of all discovered test maps, by map name. */
+    const TMap<FName, FDaeTestMapInfo>& GetMapInfos() const;
+
+private:
+    /** Names of all discovered test maps, in lexical order. */
+    TArray<FName> MapNames;
+
+    /** Package names and meta data of all discovered test maps, by map name. */
+    TMap<FName, FDaeTestMapInfo> MapInfos;
+
+    /** Gets the package paths of all configured test map folders (e.g. /Game/Maps/AutomatedTests). */
+    static TArray<FString> GetTestMapPackagePaths(const UDaeTestAutomationPluginSettings* Settings);
+
+    /** Finds the long package names of all additional test maps, reusing the passed previous results if possible. */
+    static TArray<FName> ResolveAdditionalTestMaps(const UDaeTestAutomationPluginSettings* Settings,
+                                                   const TMap<FName, FDaeTestMapInfo>& PreviousMapInfos);
+
+    /** Hashes the settings and the names, sizes and timestamps of all map files discovery depends on. */
+    static FString ComputeFingerprint(const UDaeTestAutomationPluginSettings* Settings,
+                                      const TArray<FName>& AdditionalPackageNames);
+
+    /** Scans the test map folders and additional test maps with the asset registry. */
+    void ScanAssetRegistry(const UDaeTestAutomationPluginSettings* Settings,
+                           const TArray<FName>& AdditionalPackageNames);
+
+    /** Reads the fingerprint and test maps from the specified manifest. */
+    static bool ReadManifest(const FString& ManifestPath, FString& OutFingerprint,
+                             TMap<FName, FDaeTestMapInfo>& OutMapInfos);
+
+    /** Writes the specified fingerprint and all discovered test maps to the specified manifest. */
+    void WriteManifest(const FString& ManifestPath, const FString& Fingerprint) const;
+};
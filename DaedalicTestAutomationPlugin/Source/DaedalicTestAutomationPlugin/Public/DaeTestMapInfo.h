@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Settings/DaeTestMapMetaData.h"
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+#include <UObject/Object.h>
+
+struct FAssetData;
+
+/**
+ * Information about a test map that's stored as asset registry tags of the map when it's saved.
+ * This allows listing and filtering tests without loading any maps.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestMapInfo
+{
+public:
+    /** Long package name of the map (e.g. /Game/Maps/AutomatedTests/MyTest). */
+    FName PackageName;
+
+    /** Tags, priority, expected errors, travel and simulation requirements of all tests of the map. */
+    FDaeTestMapMetaData MetaData;
+
+    /** Number of tests in the test suite of the map. */
+    int32 TestCount;
+
+    /** Number of parameters of all tests of the map, not including parameter providers. */
+    int32 ParameterCount;
+
+    /** Version of the asset registry tags added to test maps. Increase whenever changing how they're computed. */
+    static const int32 TagsVersion;
+
+    FDaeTestMapInfo();
+
+    /** Reads the information about the specified map from its asset registry tags, falling back to the plugin settings for maps without tags. */
+    static FDaeTestMapInfo FromAssetData(const FAssetData& AssetData);
+
+    /** Adds asset registry tags with information about the specified object, if it's a world containing a test suite. */
+    static void GetWorldAssetRegistryTags(const UObject* Object,
+                                          TArray<UObject::FAssetRegistryTag>& OutTags);
+
+    /** Serializes this information to JSON, e.g. for caching it. */
+    TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores information from the specified JSON object. */
+    static FDaeTestMapInfo FromJson(const TSharedRef<FJsonObject>& JsonObject);
+
+private:
+    /** Names of the asset registry tags of test maps. */
+    static const FName TestTagsTag;
+    static const FName TestPriorityTag;
+    static const FName TestExpectedErrorsTag;
+    static const FName TestCountTag;
+    static const FName TestParameterCountTag;
+    static const FName TestRequiresFullTravelTag;
+    static const FName TestAcceleratedSimulationTag;
+    static const FName TestSimulationTimeDilationTag;
+
+    /** Serializes the specified expected errors to JSON. */
+    static TArray<TSharedPtr<FJsonValue>> ExpectedErrorsToJson(
+        const TArray<FDaeTestExpectedError>& ExpectedErrors);
+
+    /** Restores expected errors from the specified JSON values. */
+    static TArray<FDaeTestExpectedError> ExpectedErrorsFromJson(
+        const TArray<TSharedPtr<FJsonValue>>& JsonValues);
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+
+class FSocket;
+
+/** Sends and receives JSON messages over a local TCP connection, one message per line. */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestMessageChannel
+{
+public:
+    /** Wraps the specified connected socket, taking ownership of it. */
+    explicit FDaeTestMessageChannel(FSocket* InSocket);
+    ~FDaeTestMessageChannel();
+
+    /** Connects to a process listening on the specified local port. Returns nullptr on failure. */
+    static TSharedPtr<FDaeTestMessageChannel> Connect(int32 Port);
+
+    /** Creates a socket listening for connections on the specified local port. Returns nullptr on failure. */
+    static FSocket* Listen(int32 Port, const FString& Description);
+
+    /** Destroys the specified socket. */
+    static void DestroySocket(FSocket* Socket);
+
+    /** Whether the other end of this channel is still connected. */
+    bool IsConnected() const;
+
+    /** Sends the specified message to the other end of this channel. */
+    bool Send(const TSharedRef<FJsonObject>& Message);
+
+    /** Gets the next message that has been received, if any, without blocking. */
+    TSharedPtr<FJsonObject> Receive();
+
+private:
+    /** Socket of this channel. */
+    FSocket* Socket;
+
+    /** Received bytes that don't make up a complete message yet. */
+    TArray<uint8> ReceiveBuffer;
+
+    /** Whether the connection has been lost. */
+    bool bDisconnected;
+};
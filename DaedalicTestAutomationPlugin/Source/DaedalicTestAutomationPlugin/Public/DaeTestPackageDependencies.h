@@ -0,0 +1,32 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * Resolves which packages test maps depend on, directly or indirectly, based on the asset registry.
+ * Includes soft references (e.g. test parameters), and caches direct dependencies shared by multiple test maps.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPackageDependencies
+{
+public:
+    FDaeTestPackageDependencies();
+
+    /** Gets the specified packages and all packages they depend on, directly or indirectly. Native packages (/Script/) are not followed. */
+    TSet<FName> GetClosure(const TArray<FName>& PackageNames);
+
+    /** Gets a hash of the contents of the specified package on disk, or an empty string if it doesn't exist (e.g. native packages). */
+    FString GetPackageHash(const FName& PackageName);
+
+    /** Gets the packages of the specified test map, including test classes that aren't referenced by any map (e.g. transient world tests). */
+    static TArray<FName> GetTestMapPackages(const FName& MapName, const FName& PackageName);
+
+private:
+    /** Direct dependencies of all packages visited so far. */
+    TMap<FName, TArray<FName>> DirectDependencies;
+
+    /** Hashes of all packages hashed so far. */
+    TMap<FName, FString> PackageHashes;
+
+    /** Gets the direct dependencies of the specified package. */
+    const TArray<FName>& GetDirectDependencies(const FName& PackageName);
+};
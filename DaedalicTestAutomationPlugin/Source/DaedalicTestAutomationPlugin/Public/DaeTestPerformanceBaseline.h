@@ -0,0 +1,99 @@
+#pragma once
+
+#include "DaeTestPerformanceHistogram.h"
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+
+/**
+ * Frame time distribution of a previous run of a performance test, for detecting gradual regressions that still pass
+ * all budgets. Stored in a local folder, one file per map, test and machine, as timings of different machines can't be
+ * compared.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceBaseline
+{
+public:
+    /** Map the test has been run in. */
+    FString MapName;
+
+    /** Name of the test, including its parameter, if any. */
+    FString TestName;
+
+    /** Hardware and software the test has been run on. */
+    FString MachineFingerprint;
+
+    /** Build the test has been run with. */
+    FString BuildVersion;
+
+    /** When the baseline has been recorded. */
+    FDateTime Timestamp;
+
+    /** Frame times of all recorded frames. */
+    FDaeTestPerformanceHistogram FrameTime;
+
+    /** Gets the path of the baseline folder to use if none is specified. */
+    static FString GetDefaultDirectory();
+
+    /** Describes the hardware and software of this machine, e.g. CPU, GPU, RHI and OS. */
+    static FString GetMachineFingerprint();
+
+    /** Gets the file the baseline of the specified test on this machine is stored in. */
+    static FString GetFilePath(const FString& Directory, const FString& MapName,
+                               const FString& TestName);
+
+    /** Reads the baseline from the specified file. */
+    bool Load(const FString& FilePath);
+
+    /** Writes the baseline to the specified file. */
+    bool Save(const FString& FilePath) const;
+};
+
+/**
+ * Result of comparing the frame times of a performance test with its baseline, using a one-sided Mann-Whitney U test.
+ * As subsequent frames aren't independent, long flights yield tiny p-values for even tiny changes, so the median
+ * frame time needs to have increased by a relevant amount as well to count as regression.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceBaselineComparison
+{
+public:
+    /** Whether a baseline was available for comparison. */
+    bool bHasBaseline = false;
+
+    /** When the baseline has been recorded. */
+    FString BaselineTimestamp;
+
+    /** Number of frames of the baseline. */
+    int32 BaselineSampleCount = 0;
+
+    /** Median frame time of the baseline, in ms. */
+    float BaselineP50 = 0.0f;
+
+    /** Median frame time of the current run, in ms. */
+    float CurrentP50 = 0.0f;
+
+    /** Probability of frames being at least as much slower as observed, if performance hasn't actually changed. */
+    float PValue = 1.0f;
+
+    /** Probability of a random frame of the current run being slower than a random frame of the baseline. */
+    float ProbabilityOfSlowerFrame = 0.5f;
+
+    /** Whether frame times have increased significantly. */
+    bool bRegression = false;
+
+    /**
+     * Compares the specified frame time distributions. Frames are considered to have regressed if the p-value is below
+     * the significance level, and the median frame time has increased by more than the specified percentage.
+     */
+    static FDaeTestPerformanceBaselineComparison Compare(
+        const FDaeTestPerformanceBaseline& Baseline, const FDaeTestPerformanceHistogram& Current,
+        float SignificanceLevel, float RegressionThresholdPercentage);
+
+    /** Gets the relative change of the median frame time, in percent. */
+    float GetP50ChangePercentage() const;
+
+    /** Serializes this comparison to JSON, e.g. for sending it to other processes. */
+    TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores a comparison from the specified JSON object. */
+    static FDaeTestPerformanceBaselineComparison FromJson(
+        const TSharedRef<FJsonObject>& JsonObject);
+};
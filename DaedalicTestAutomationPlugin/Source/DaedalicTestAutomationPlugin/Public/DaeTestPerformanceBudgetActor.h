@@ -1,7 +1,14 @@
 #pragma once
 
 #include "DaeTestActor.h"
+#include "DaeTestPerformanceBaseline.h"
+#include "DaeTestPerformanceBudgetRule.h"
+#include "DaeTestPerformanceBudgetRuleEvaluator.h"
 #include "DaeTestPerformanceBudgetViolation.h"
+#include "DaeTestPerformanceCapture.h"
+#include "DaeTestPerformanceHistogram.h"
+#include "DaeTestPerformanceLegBudget.h"
+#include "DaeTestPerformanceMemoryViolation.h"
 #include <CoreMinimal.h>
 #include <GameFramework/Pawn.h>
 #include "DaeTestPerformanceBudgetActor.generated.h"
@@ -72,6 +79,50 @@ private:
     UPROPERTY(EditAnywhere)
     float GPUBudget;
 
+    /** How much physical memory the process is allowed to use at any time, in MB. 0 to not check physical memory. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    float PhysicalMemoryBudget;
+
+    /** How much virtual memory the process is allowed to use at any time, in MB. 0 to not check virtual memory. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    float VirtualMemoryBudget;
+
+    /** How many UObjects are allowed to be alive at any time. 0 to not check the number of UObjects. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    int32 UObjectCountBudget;
+
+    /** How often to measure memory usage, in seconds, as querying the operating system takes time itself. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    float MemorySampleInterval;
+
+    /**
+     * Budgets to check over the whole flight, e.g. p95 game thread time within 16 ms, instead of every single frame.
+     * If any are set, single frames exceeding the budgets above are still reported, but don't fail the test anymore,
+     * except on legs with their own budgets without any budget rules.
+     */
+    UPROPERTY(EditAnywhere)
+    TArray<FDaeTestPerformanceBudgetRule> BudgetRules;
+
+    /** Budgets overriding the ones above for single legs of the flight path, e.g. for dense areas. */
+    UPROPERTY(EditInstanceOnly)
+    TArray<FDaeTestPerformanceLegBudget> LegBudgets;
+
+    /**
+     * Whether to compare frame times with the baseline stored for this test on this machine, failing on significant
+     * regressions. Baselines are written when running with -UpdatePerformanceBaseline.
+     */
+    UPROPERTY(EditAnywhere)
+    bool bCompareWithBaseline;
+
+    /** Maximum probability of frames being that much slower by chance, for considering them a regression. */
+    UPROPERTY(EditAnywhere,
+              meta = (EditCondition = "bCompareWithBaseline", ClampMin = 0, ClampMax = 1))
+    float BaselineSignificanceLevel;
+
+    /** How much the median frame time needs to have increased over the baseline to count as regression, in percent. */
+    UPROPERTY(EditAnywhere, meta = (EditCondition = "bCompareWithBaseline", ClampMin = 0))
+    float BaselineRegressionThreshold;
+
     /** Whether performance budget violations should cause a failure item in default test reports. */
     UPROPERTY(EditAnywhere)
     bool bIncludeInDefaultTestReport;
@@ -79,11 +130,89 @@ private:
     bool bIsRunning;
     bool bIsRecording;
 
+    /** Whether render thread and GPU times can be measured, and screenshots be taken. False when running headless. */
+    bool bIsRendering;
+
     int32 CurrentTargetPointIndex;
     TArray<FDaeTestPerformanceBudgetViolation> BudgetViolations;
     float LastBudgetViolationTime;
 
+    /** Number of budget violations on legs that aren't checked by any budget rules, which fail the test. */
+    int32 NumBudgetViolationsWithoutRules;
+
+    /** Whether performance counters are available and recorded every frame. */
+    bool bIsSampling;
+
+    /** Writes the performance counters of every frame of the current test to disk, instead of keeping them in memory. */
+    FDaeTestPerformanceCaptureWriter Capture;
+
+    /** Memory budget violations that occurred during the current test. */
+    TArray<FDaeTestPerformanceMemoryViolation> MemoryViolations;
+
+    /** Memory counters that already exceeded their budget, by leg, for reporting each of them once per leg only. */
+    TSet<FString> ReportedMemoryViolations;
+
+    /** When memory usage has been measured last, in seconds. Negative if not yet. */
+    float LastMemorySampleTime;
+
+    /** Memory usage measured last. */
+    float UsedPhysicalMemory;
+    float UsedVirtualMemory;
+    int32 UObjectCount;
+
+    /** Frame times of all recorded frames, for comparing them with the baseline. */
+    FDaeTestPerformanceHistogram FrameTimeHistogram;
+
+    /** Result of comparing frame times with the baseline. */
+    FDaeTestPerformanceBaselineComparison BaselineComparison;
+
+    /** Checks all budget rules as frames come in. */
+    TArray<FDaeTestPerformanceBudgetRuleEvaluator> BudgetRuleEvaluators;
+
+    /** Checks the budget rules of legs with their own budgets, by index of the target point they lead to. */
+    TMap<int32, TArray<FDaeTestPerformanceBudgetRuleEvaluator>> LegBudgetRuleEvaluators;
+
     void BeginRecording();
     void EndRecording();
+
+    /** Gets the name of the target point with the specified index, or n/a if there's none. */
+    FString GetTargetPointName(int32 TargetPointIndex) const;
+
+    /** Gets the budgets of the leg leading to the target point with the specified index, if it has its own. */
+    const FDaeTestPerformanceLegBudget* FindLegBudget(int32 TargetPointIndex) const;
+
+    /** Whether the leg leading to the target point with the specified index is checked by any budget rules, its own or the ones of the test. */
+    bool HasBudgetRules(int32 TargetPointIndex) const;
+
+    /** Adds evaluators for all specified rules that can be checked. */
+    void AddBudgetRuleEvaluators(
+        const TArray<FDaeTestPerformanceBudgetRule>& Rules,
+        TArray<FDaeTestPerformanceBudgetRuleEvaluator>& OutEvaluators) const;
+
+    /** Checks memory budgets, single frame budgets and budget rules, failing the test on violations. */
+    void AssertBudgets();
+
+    /** Gets the path of the baseline of this test and its current parameter on this machine, along with its map and test names. */
+    FString GetBaselinePath(FString& OutMapName, FString& OutTestName) const;
+
+    /** Compares frame times with the baseline and fails on significant regressions. */
+    void CompareWithBaseline();
+
+    /** Replaces the baseline with the frame times of this run. */
+    void UpdateBaseline();
+
+    /** Measures memory usage, if due, and checks it against the memory budgets of the current leg. */
+    void UpdateMemoryCounters(float Time, const FVector& Location);
+
+    /** Adds a memory violation if the specified counter exceeds its budget on the current leg for the first time. */
+    void ValidateMemoryCounter(float Value, float Budget, const FString& Name, bool bIsObjectCount,
+                               const FVector& Location);
+
+    /** Gets the statistics of the memory allocator, by name (in bytes). */
+    static TMap<FString, uint64> GetAllocatorStats();
+
+    /** Gets the time the game thread took for the last frame, in ms. */
+    float GetGameThreadTime() const;
+
     bool ValidatePerformanceCounter(float Time, float Budget, const FString& Name);
 };
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "DaeTestPerformanceBaseline.h"
 #include "DaeTestPerformanceBudgetViolation.h"
+#include "DaeTestPerformanceCounterSummary.h"
+#include "DaeTestPerformanceLegResult.h"
+#include "DaeTestPerformanceMemoryViolation.h"
 #include "DaeTestResultData.h"
 #include <CoreMinimal.h>
 
@@ -10,7 +14,59 @@ class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceBudgetResultData
 {
 public:
     virtual FName GetDataType() const override;
+    virtual TSharedRef<FJsonObject> ToJson() const override;
+    virtual void FromJson(const TSharedRef<FJsonObject>& JsonObject) override;
 
     /** Performance budget violations that occurred during the test. */
     TArray<FDaeTestPerformanceBudgetViolation> BudgetViolations;
+
+    /** Memory budget violations that occurred during the test, at most one per counter and leg. */
+    TArray<FDaeTestPerformanceMemoryViolation> MemoryViolations;
+
+    /** Most physical memory used by the process during the test (in MB). */
+    float PeakUsedPhysicalMemory = 0.0f;
+
+    /** Most virtual memory used by the process during the test (in MB). */
+    float PeakUsedVirtualMemory = 0.0f;
+
+    /** Most UObjects alive during the test. */
+    int32 PeakUObjectCount = 0;
+
+    /** World location where the most physical memory has been used. */
+    FVector PeakUsedPhysicalMemoryLocation = FVector::ZeroVector;
+
+    /** Statistics of the memory allocator at the end of the test, by name (in bytes). */
+    TMap<FString, uint64> AllocatorStats;
+
+    /** Number of frames performance counters have been recorded for. */
+    int32 SampleCount = 0;
+
+    /** Distribution of frame times over all recorded frames. */
+    FDaeTestPerformanceCounterSummary FrameTime;
+
+    /** Distribution of game thread times over all recorded frames. */
+    FDaeTestPerformanceCounterSummary GameThreadTime;
+
+    /** Distribution of render thread times over all recorded frames. */
+    FDaeTestPerformanceCounterSummary RenderThreadTime;
+
+    /** Distribution of GPU times over all recorded frames. */
+    FDaeTestPerformanceCounterSummary GPUTime;
+
+    /** Performance of all legs of the flight path, most expensive first. */
+    TArray<FDaeTestPerformanceLegResult> Legs;
+
+    /** Result of comparing frame times with the baseline of the test. */
+    FDaeTestPerformanceBaselineComparison BaselineComparison;
+
+    /** Path of the capture file holding the performance counters of every recorded frame. */
+    FString CaptureFilePath;
+
+private:
+    static TArray<TSharedPtr<FJsonValue>> LocationToJson(const FVector& Location);
+    static FVector LocationFromJson(const FJsonObject& JsonObject, const FString& FieldName);
+
+    static TSharedRef<FJsonObject> AllocatorStatsToJson(const TMap<FString, uint64>& Stats);
+    static TMap<FString, uint64> AllocatorStatsFromJson(const FJsonObject& JsonObject,
+                                                        const FString& FieldName);
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include "DaeTestPerformanceBudgetRule.generated.h"
+
+/** Performance counter measured every frame of a performance test. */
+UENUM()
+enum class EDaeTestPerformanceCounter : uint8
+{
+    FrameTime UMETA(DisplayName = "Frame"),
+    GameThreadTime UMETA(DisplayName = "Game Thread"),
+    RenderThreadTime UMETA(DisplayName = "Render Thread"),
+    GPUTime UMETA(DisplayName = "GPU")
+};
+
+/** How a performance budget rule is checked. */
+UENUM()
+enum class EDaeTestPerformanceBudgetRuleType : uint8
+{
+    /** Percentile of all frames must be within budget, e.g. p95 game thread time within 16 ms. */
+    Percentile,
+
+    /** Only a small share of frames may exceed the budget, e.g. no more than 0.5% of frames over 33 ms. */
+    FrameShare,
+
+    /** No time window may average over budget, e.g. no 2 seconds averaging over 16 ms. */
+    WindowAverage
+};
+
+/** Performance budget checked over the whole flight of a performance test, instead of every single frame. */
+USTRUCT()
+struct DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceBudgetRule
+{
+    GENERATED_BODY()
+
+    /** How to check the budget. */
+    UPROPERTY(EditAnywhere)
+    EDaeTestPerformanceBudgetRuleType Type = EDaeTestPerformanceBudgetRuleType::Percentile;
+
+    /** Performance counter to check. */
+    UPROPERTY(EditAnywhere)
+    EDaeTestPerformanceCounter Counter = EDaeTestPerformanceCounter::GameThreadTime;
+
+    /** Time the counter is allowed to take, in ms. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    float Budget = 16.0f;
+
+    /** Percentile of all frames that must be within budget. */
+    UPROPERTY(EditAnywhere,
+              meta = (EditCondition = "Type == EDaeTestPerformanceBudgetRuleType::Percentile",
+                      ClampMin = 0, ClampMax = 100))
+    float Percentile = 95.0f;
+
+    /** Percentage of all frames that is allowed to exceed the budget. */
+    UPROPERTY(EditAnywhere,
+              meta = (EditCondition = "Type == EDaeTestPerformanceBudgetRuleType::FrameShare",
+                      ClampMin = 0, ClampMax = 100))
+    float MaxFramePercentage = 0.5f;
+
+    /** Length of the time windows that must average within budget, in seconds. */
+    UPROPERTY(EditAnywhere,
+              meta = (EditCondition = "Type == EDaeTestPerformanceBudgetRuleType::WindowAverage",
+                      ClampMin = 0))
+    float WindowSeconds = 2.0f;
+
+    /** Gets the display name of the specified counter, e.g. Game Thread. */
+    static FString GetCounterName(EDaeTestPerformanceCounter Counter);
+};
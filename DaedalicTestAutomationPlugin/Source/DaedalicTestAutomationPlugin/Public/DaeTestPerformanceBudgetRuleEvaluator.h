@@ -0,0 +1,59 @@
+#pragma once
+
+#include "DaeTestPerformanceBudgetRule.h"
+#include "DaeTestPerformanceHistogram.h"
+#include "DaeTestPerformanceSampleStore.h"
+#include <CoreMinimal.h>
+
+/**
+ * Checks a performance budget rule frame by frame, as samples come in.
+ * Memory stays bounded regardless of the length of the test: Percentiles are approximated by a histogram, and only
+ * the samples of the current time window are kept.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceBudgetRuleEvaluator
+{
+public:
+    explicit FDaeTestPerformanceBudgetRuleEvaluator(const FDaeTestPerformanceBudgetRule& InRule);
+
+    /** Adds the performance counters of the next frame. */
+    void Add(const FDaeTestPerformanceSample& Sample);
+
+    /** Checks whether all frames added so far satisfy the rule. If not, describes which rule failed and by how much. */
+    bool Evaluate(FString& OutViolation) const;
+
+    /** Gets the specified counter of the passed sample, in ms. */
+    static float GetCounterValue(const FDaeTestPerformanceSample& Sample,
+                                 EDaeTestPerformanceCounter Counter);
+
+private:
+    /** Single counter value of the current time window. */
+    struct FWindowSample
+    {
+        float TimeSeconds;
+        float Value;
+    };
+
+    /** Rule to check. */
+    FDaeTestPerformanceBudgetRule Rule;
+
+    /** Distribution of all counter values, for percentile rules. */
+    FDaeTestPerformanceHistogram Histogram;
+
+    /** Number of frames added so far. */
+    int32 NumFrames;
+
+    /** Number of frames over budget so far, for frame share rules. */
+    int32 NumFramesOverBudget;
+
+    /** Counter values of the current time window, starting at WindowStartIndex, for window average rules. */
+    TArray<FWindowSample> WindowSamples;
+    int32 WindowStartIndex;
+    double WindowSum;
+
+    /** World time of the first frame, for ignoring windows that haven't been filled yet. */
+    float FirstTimeSeconds;
+
+    /** Highest average of any full time window so far, and the time that window ended. */
+    float MaxWindowAverage;
+    float MaxWindowEndTimeSeconds;
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "DaeTestPerformanceSampleStore.h"
+#include <CoreMinimal.h>
+#include <Async/Future.h>
+#include <Templates/Function.h>
+
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Compact binary file with the performance counters of every frame of a performance test.
+ *
+ * Layout:
+ * - Header: magic bytes DAEPERF\0, format version (uint32)
+ * - Schema: number of columns (uint32), followed by type (uint8) and name (uint8 length, UTF-8 characters) of each column
+ * - Chunks of up to FDaeTestPerformanceSampleStore::ChunkSize samples each: size of the chunk in bytes after this field
+ *   (uint32), number of samples (uint32), followed by all values of each column in schema order, prefixed with their
+ *   size in bytes (uint32)
+ *
+ * Integer columns (time in microseconds, location in cm, target point index, UObject count) are delta-encoded from the
+ * previous sample of the same chunk, stored as zigzag varints. Float columns (times in ms, memory in MB) are stored as
+ * raw 32-bit floats.
+ * Each chunk can be decoded on its own. All values are little-endian.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceCapture
+{
+public:
+    /** Type of a column of a capture file. */
+    enum class EColumnType : uint8
+    {
+        DeltaVarInt = 0,
+        Float = 1
+    };
+
+    /** Column of a capture file. */
+    struct FColumn
+    {
+        EColumnType Type;
+        FString Name;
+    };
+
+    /** Magic bytes at the start of every capture file. */
+    static const ANSICHAR Magic[8];
+
+    /** Version of the capture file format. */
+    static const uint32 Version;
+
+    /** File extension of capture files, including the dot. */
+    static const FString FileExtension;
+
+    /** Gets the folder to write capture files to. */
+    static FString GetDefaultDirectory();
+
+    /** Deletes the oldest capture files in the specified folder, keeping the specified number of most recent ones. */
+    static void DeleteOldCaptures(const FString& Directory, int32 NumCapturesToKeep);
+
+    /** Gets the columns written by this version of the plugin, in order. */
+    static const TArray<FColumn>& GetColumns();
+
+    /** Gets the value of the column with the specified index for the passed sample, in the unit stored in files. */
+    static double GetColumnValue(int32 ColumnIndex, const FDaeTestPerformanceSample& Sample);
+
+    /** Sets the value of the column with the specified index of the passed sample, in the unit stored in files. */
+    static void SetColumnValue(int32 ColumnIndex, double Value, FDaeTestPerformanceSample& Sample);
+};
+
+/**
+ * Writes performance samples to a capture file incrementally, keeping just two chunks in memory: the one being filled,
+ * and the full one being encoded and written to disk in the background.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceCaptureWriter
+{
+public:
+    FDaeTestPerformanceCaptureWriter();
+    ~FDaeTestPerformanceCaptureWriter();
+
+    /** Creates the specified capture file and writes its header. */
+    bool Open(const FString& InFilePath);
+
+    /** Whether samples are being written. */
+    bool IsOpen() const;
+
+    /** Adds the specified sample, handing the current chunk to a background task as soon as it is full. */
+    void Add(const FDaeTestPerformanceSample& Sample);
+
+    /** Writes all remaining samples to disk and closes the file. */
+    void Close();
+
+    /** Gets the path of the capture file. */
+    const FString& GetFilePath() const;
+
+    /** Number of samples added since opening. */
+    int32 Num() const;
+
+private:
+    /** Capture file being written. */
+    TUniquePtr<FArchive> File;
+
+    /** Path of the capture file. */
+    FString FilePath;
+
+    /** Samples of the current chunk. */
+    FDaeTestPerformanceSampleStore Chunk;
+
+    /** Samples of the previous chunk, while being written in the background. */
+    FDaeTestPerformanceSampleStore PendingChunk;
+
+    /** Background task writing the pending chunk, if any. */
+    TFuture<void> PendingWrite;
+
+    /** Number of samples added since opening. */
+    int32 NumSamples;
+
+    /** Hands the current chunk to a background task for writing it to disk, and starts a new one. */
+    void FlushChunk();
+
+    /** Waits for the pending chunk to be written, if any. */
+    void WaitForPendingWrite();
+
+    /** Encodes all samples of the specified chunk and writes them to disk. */
+    void WriteChunk(const FDaeTestPerformanceSampleStore& ChunkToWrite);
+
+    static void WriteUInt32(uint32 Value, TArray<uint8>& OutBytes);
+    static void WriteVarInt(uint64 Value, TArray<uint8>& OutBytes);
+};
+
+/** Reads performance samples from a capture file, memory-mapping it if possible. */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceCaptureReader
+{
+public:
+    FDaeTestPerformanceCaptureReader();
+    ~FDaeTestPerformanceCaptureReader();
+
+    /** Opens the specified capture file and reads its header and schema. */
+    bool Open(const FString& FilePath);
+
+    /** Gets the columns of the capture file, in order. */
+    const TArray<FDaeTestPerformanceCapture::FColumn>& GetColumns() const;
+
+    /** Decodes all samples chunk by chunk, passing them to the specified callback in order. Returns false if the file is corrupt. */
+    bool ForEachSample(TFunctionRef<void(const FDaeTestPerformanceSample&)> Callback) const;
+
+private:
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** Contents of the capture file, if it can't be memory-mapped. */
+    TArray<uint8> FileData;
+
+    /** Contents of the capture file, either mapped or loaded. */
+    const uint8* Data;
+    int64 Size;
+
+    /** Offset of the first chunk, right after the schema. */
+    int64 FirstChunkOffset;
+
+    /** Columns of the capture file, in order. */
+    TArray<FDaeTestPerformanceCapture::FColumn> Columns;
+
+    /** Index of each column of the capture file in the columns known to this version of the plugin, or INDEX_NONE. */
+    TArray<int32> KnownColumnIndices;
+
+    static bool ReadUInt32(const uint8* Bytes, int64 Size, int64& InOutOffset, uint32& OutValue);
+    static bool ReadVarInt(const uint8* Bytes, int64 Size, int64& InOutOffset, uint64& OutValue);
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "DaeTestPerformanceHistogram.h"
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+
+/** Distribution of a performance counter over all frames of a test (in milliseconds). */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceCounterSummary
+{
+public:
+    float Min = 0.0f;
+    float Mean = 0.0f;
+    float P50 = 0.0f;
+    float P90 = 0.0f;
+    float P99 = 0.0f;
+    float Max = 0.0f;
+
+    /** Serializes this summary to JSON, e.g. for sending it to other processes. */
+    TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores a summary from the specified JSON object. */
+    static FDaeTestPerformanceCounterSummary FromJson(const TSharedRef<FJsonObject>& JsonObject);
+};
+
+/** Summarizes the values of a counter as frames come in, in constant memory. Percentiles are accurate within about 1%. */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceCounterSummaryBuilder
+{
+public:
+    FDaeTestPerformanceCounterSummaryBuilder();
+
+    /** Adds the value of the counter of a single frame. */
+    void Add(float Value);
+
+    /** Summarizes all values added so far. */
+    FDaeTestPerformanceCounterSummary ToSummary() const;
+
+private:
+    FDaeTestPerformanceHistogram Histogram;
+
+    float Min;
+    float Max;
+    double Sum;
+};
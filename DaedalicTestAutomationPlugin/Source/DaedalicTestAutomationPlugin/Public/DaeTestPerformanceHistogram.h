@@ -0,0 +1,52 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+
+/**
+ * Approximates percentiles of a stream of positive values (e.g. frame times in ms) in constant memory.
+ * Values are counted in logarithmic buckets, so that each percentile is accurate within about 1% of its value.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceHistogram
+{
+public:
+    FDaeTestPerformanceHistogram();
+
+    /** Adds the specified value. */
+    void Add(float Value);
+
+    /** Number of values added so far. */
+    int32 Num() const;
+
+    /** Gets the specified percentile (between 0 and 100) of all values added so far. */
+    float GetPercentile(float Percentile) const;
+
+    /** Gets the number of values per bucket, in ascending order of their values. Equal for all histograms. */
+    const TArray<uint32>& GetBucketCounts() const;
+
+    /** Serializes this histogram to JSON, e.g. for storing it as baseline. Only non-empty buckets are written. */
+    TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores a histogram from the specified JSON object. */
+    static FDaeTestPerformanceHistogram FromJson(const TSharedRef<FJsonObject>& JsonObject);
+
+private:
+    /** Smallest value to distinguish. Smaller values are counted as this one. */
+    static const float MinValue;
+
+    /** Largest value to distinguish. Larger values are counted as this one. */
+    static const float MaxValue;
+
+    /** Ratio between the upper and lower bound of each bucket. */
+    static const float Gamma;
+
+    /** Number of values per bucket. */
+    TArray<uint32> BucketCounts;
+
+    /** Number of values added so far. */
+    int32 NumValues;
+
+    /** Exact bounds of all values added so far, for not reporting percentiles beyond them. */
+    float Min;
+    float Max;
+};
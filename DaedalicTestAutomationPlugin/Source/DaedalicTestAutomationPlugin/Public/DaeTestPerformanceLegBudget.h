@@ -0,0 +1,46 @@
+#pragma once
+
+#include "DaeTestPerformanceBudgetRule.h"
+#include <CoreMinimal.h>
+#include "DaeTestPerformanceLegBudget.generated.h"
+
+class ATargetPoint;
+
+/** Performance budgets overriding the ones of a performance test for a single leg of its flight path. */
+USTRUCT()
+struct DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceLegBudget
+{
+    GENERATED_BODY()
+
+    /** Target point the leg leads to, from the previous one of the flight path. */
+    UPROPERTY(EditAnywhere)
+    ATargetPoint* TargetPoint = nullptr;
+
+    /** How long game thread is allowed to take for a single frame on this leg, in ms. */
+    UPROPERTY(EditAnywhere)
+    float GameThreadBudget = 20.0f;
+
+    /** How long draw is allowed to take for a single frame on this leg, in ms. */
+    UPROPERTY(EditAnywhere)
+    float RenderThreadBudget = 20.0f;
+
+    /** How long GPU is allowed to take for a single frame on this leg, in ms. */
+    UPROPERTY(EditAnywhere)
+    float GPUBudget = 20.0f;
+
+    /** How much physical memory the process is allowed to use on this leg, in MB. 0 to use the budget of the performance test. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    float PhysicalMemoryBudget = 0.0f;
+
+    /** How much virtual memory the process is allowed to use on this leg, in MB. 0 to use the budget of the performance test. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    float VirtualMemoryBudget = 0.0f;
+
+    /** How many UObjects are allowed to be alive on this leg. 0 to use the budget of the performance test. */
+    UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+    int32 UObjectCountBudget = 0;
+
+    /** Budgets to check over all frames of this leg. Empty to use the budget rules of the performance test instead. */
+    UPROPERTY(EditAnywhere)
+    TArray<FDaeTestPerformanceBudgetRule> BudgetRules;
+};
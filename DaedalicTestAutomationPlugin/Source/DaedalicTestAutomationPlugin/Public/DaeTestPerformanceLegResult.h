@@ -0,0 +1,39 @@
+#pragma once
+
+#include "DaeTestPerformanceCounterSummary.h"
+#include <CoreMinimal.h>
+
+/** Performance of a single leg of the flight path of a performance test, between two consecutive target points. */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceLegResult
+{
+public:
+    /** Target point the leg starts at. */
+    FString PreviousTargetPointName;
+
+    /** Target point the leg leads to. */
+    FString NextTargetPointName;
+
+    /** Number of frames recorded on this leg. */
+    int32 SampleCount = 0;
+
+    /** How long it took to fly along this leg, in seconds. */
+    float DurationSeconds = 0.0f;
+
+    /** Distributions of all performance counters over the frames of this leg. */
+    FDaeTestPerformanceCounterSummary FrameTime;
+    FDaeTestPerformanceCounterSummary GameThreadTime;
+    FDaeTestPerformanceCounterSummary RenderThreadTime;
+    FDaeTestPerformanceCounterSummary GPUTime;
+
+    /** Most physical memory used by the process on this leg (in MB). */
+    float PeakUsedPhysicalMemory = 0.0f;
+
+    /** Most virtual memory used by the process on this leg (in MB). */
+    float PeakUsedVirtualMemory = 0.0f;
+
+    /** Most UObjects alive on this leg. */
+    int32 PeakUObjectCount = 0;
+
+    /** How expensive this leg is, for ranking legs: p90 of the slowest of game thread, render thread and GPU time (in milliseconds). */
+    float GetCost() const;
+};
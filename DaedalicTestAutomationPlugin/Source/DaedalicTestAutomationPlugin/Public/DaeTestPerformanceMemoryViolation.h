@@ -0,0 +1,32 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/** Data about a single memory budget violation. */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceMemoryViolation
+{
+public:
+    /** Last target point that we passed. */
+    FString PreviousTargetPointName;
+
+    /** Next target point we want to pass. */
+    FString NextTargetPointName;
+
+    /** World location where the budget violation occurred. */
+    FVector CurrentLocation = FVector::ZeroVector;
+
+    /** Memory counter that exceeded its budget, e.g. Physical Memory. */
+    FString Counter;
+
+    /** Whether the counter is a number of objects, instead of memory in MB. */
+    bool bIsObjectCount = false;
+
+    /** Value of the counter at the time of the budget violation (in MB, or number of objects). */
+    float Value = 0.0f;
+
+    /** Budget the counter has exceeded. */
+    float Budget = 0.0f;
+
+    /** Statistics of the memory allocator at the time of the budget violation, by name (in bytes). */
+    TMap<FString, uint64> AllocatorStats;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/** Performance counters of a single frame. */
+struct DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceSample
+{
+    /** World time of the frame, in seconds. */
+    float TimeSeconds = 0.0f;
+
+    /** Total time of the frame (in milliseconds). */
+    float FrameTime = 0.0f;
+
+    /** Time spent on the game thread during the frame (in milliseconds). */
+    float GameThreadTime = 0.0f;
+
+    /** Time spent on the render thread during the frame (in milliseconds). */
+    float RenderThreadTime = 0.0f;
+
+    /** Time spent on the GPU during the frame (in milliseconds). */
+    float GPUTime = 0.0f;
+
+    /** World location the frame has been rendered from. */
+    FVector Location = FVector::ZeroVector;
+
+    /** Index of the target point of the flight path the pawn was flying towards. */
+    int32 TargetPointIndex = 0;
+
+    /** Physical memory used by the process (in MB). */
+    float UsedPhysicalMemory = 0.0f;
+
+    /** Virtual memory used by the process (in MB). */
+    float UsedVirtualMemory = 0.0f;
+
+    /** Number of live UObjects. */
+    int32 UObjectCount = 0;
+};
+
+/**
+ * Records performance counters of every frame of a test.
+ * Samples are stored in fixed-size chunks that are allocated up front, so that adding a sample never moves previous
+ * ones, and hardly ever allocates memory.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestPerformanceSampleStore
+{
+public:
+    /** Number of samples per chunk, i.e. about one minute at 60 frames per second. */
+    static const int32 ChunkSize = 4096;
+
+    /** Discards all samples, keeping the first chunk allocated. */
+    void Reset();
+
+    /** Adds the specified sample. */
+    void Add(const FDaeTestPerformanceSample& Sample);
+
+    /** Number of samples recorded since resetting. */
+    int32 Num() const;
+
+    /** Gets the sample with the specified index. */
+    const FDaeTestPerformanceSample& Get(int32 Index) const;
+
+private:
+    /** Chunks holding all samples, each with capacity for ChunkSize samples. */
+    TArray<TArray<FDaeTestPerformanceSample>> Chunks;
+
+    /** Number of samples recorded since resetting. */
+    int32 NumSamples = 0;
+};
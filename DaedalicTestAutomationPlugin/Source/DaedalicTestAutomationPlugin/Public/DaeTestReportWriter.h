@@ -16,6 +16,16 @@ public:
     virtual void WriteReport(const TArray<FDaeTestSuiteResult>& TestSuites,
                              const FString& ReportPath) const = 0;
 
+    /** Starts writing a report incrementally. Called on a background thread. */
+    virtual void BeginReport(const FString& ReportPath);
+
+    /** Adds the specified finished test suite to the report. Called on a background thread. */
+    virtual void AppendTestSuite(const FDaeTestSuiteResult& TestSuite, const FString& ReportPath);
+
+    /** Finishes the report after all test suites have been appended. By default, writes the whole report at once. */
+    virtual void FinishReport(const TArray<FDaeTestSuiteResult>& TestSuites,
+                              const FString& ReportPath);
+
 protected:
     /** Gets the total number of tests among the passed test suites. */
     int32 NumTotalTests(const TArray<FDaeTestSuiteResult>& TestSuites) const;
@@ -4,11 +4,44 @@
 #include "DaeTestSuiteResult.h"
 #include <CoreMinimal.h>
 
+class IFileHandle;
+
 /** Writes test reports based on the Apache Ant JUnit report format (based on org.junit.platform.reporting.legacy.xml.XmlReportWriter.writeTestsuite). */
 class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestReportWriterJUnit : public FDaeTestReportWriter
 {
 public:
+    FDaeTestReportWriterJUnit();
+    virtual ~FDaeTestReportWriterJUnit();
+
     virtual FName GetReportType() const override;
     virtual void WriteReport(const TArray<FDaeTestSuiteResult>& TestSuites,
                              const FString& ReportPath) const override;
+
+    virtual void BeginReport(const FString& ReportPath) override;
+    virtual void AppendTestSuite(const FDaeTestSuiteResult& TestSuite,
+                                 const FString& ReportPath) override;
+    virtual void FinishReport(const TArray<FDaeTestSuiteResult>& TestSuites,
+                              const FString& ReportPath) override;
+
+private:
+    /** Report being written incrementally, if any. */
+    TUniquePtr<IFileHandle> ReportFile;
+
+    /** Position of the closing tag in the report being written incrementally. Overwritten by each appended test suite. */
+    int64 ClosingTagOffset;
+
+    /** Gets the path of the JUnit report to write, or an empty string if no report should be written. */
+    FString GetJUnitReportPath(const FString& ReportPath) const;
+
+    /** Creates the directory of the specified report, if necessary. */
+    void EnsureReportDirectoryExists(const FString& JUnitReportPath) const;
+
+    /** Converts the specified test suite to XML. */
+    FString TestSuiteToXml(const FDaeTestSuiteResult& TestSuite) const;
+
+    /** Escapes the specified text for use in XML attributes and elements, dropping characters that aren't allowed in XML at all. */
+    FString EscapeXml(const FString& Text) const;
+
+    /** Writes the specified string to the incrementally written report, encoded as UTF-8. */
+    void WriteToReportFile(const FString& String);
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DaeTestPerformanceCounterSummary.h"
 #include "DaeTestReportWriter.h"
 #include "DaeTestSuiteResult.h"
 #include <CoreMinimal.h>
@@ -12,10 +13,50 @@ public:
     virtual void WriteReport(const TArray<FDaeTestSuiteResult>& TestSuites,
                              const FString& ReportPath) const override;
 
+    virtual void BeginReport(const FString& ReportPath) override;
+    virtual void AppendTestSuite(const FDaeTestSuiteResult& TestSuite,
+                                 const FString& ReportPath) override;
+    virtual void FinishReport(const TArray<FDaeTestSuiteResult>& TestSuites,
+                              const FString& ReportPath) override;
+
 private:
+    /** Results of all test suites appended to the report being written incrementally, as HTML. */
+    FString AppendedMapString;
+
+    /** Creates the specified report directory, if necessary. */
+    void EnsureReportDirectoryExists(const FString& ReportPath) const;
+
+    /** Gets the full path of the specified report template file. */
+    FString GetTemplatePath(const FString& FileName) const;
+
+    /** Copies screenshots of the specified test suite, and returns its results as HTML. */
+    FString WriteTestSuite(const FDaeTestSuiteResult& TestSuiteResult,
+                           const FString& ReportPath) const;
+
+    /** Returns the distribution of the specified performance counter as HTML, or an empty string if it hasn't been measured. */
+    FString WriteCounterSummary(const FString& CounterName,
+                                const FDaeTestPerformanceCounterSummary& Summary) const;
+
+    /** Writes the HTML report with the specified test suite results to disk. */
+    void WriteReportFile(const FString& MapString, const FString& StartTime,
+                         float TotalTimeSeconds, const FString& ReportPath) const;
+
+    /** Writes the performance data of all specified test suites to disk as JSON. */
+    void WriteJsonReportFile(const TArray<FDaeTestSuiteResult>& TestSuites,
+                             const FString& ReportPath) const;
+
     /** Formats the specified time using a fixed number of fractional digits. */
     FString FormatTime(float Time) const;
 
+    /** Formats the specified amount of memory in MB, with one fractional digit and the unit. */
+    FString FormatMemory(float Megabytes) const;
+
+    /** Formats the specified number of objects, with digit grouping. */
+    FString FormatCount(int32 Count) const;
+
     /** Formats the specified location using a fixed number of fractional digits. */
     FString FormatLocation(const FVector& Location) const;
+
+    /** Formats the specified allocator statistics in MB, one per line. */
+    FString FormatAllocatorStats(const TMap<FString, uint64>& AllocatorStats) const;
 };
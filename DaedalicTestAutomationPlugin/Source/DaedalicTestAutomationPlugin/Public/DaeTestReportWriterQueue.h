@@ -0,0 +1,65 @@
+#pragma once
+
+#include "DaeTestSuiteResult.h"
+#include <CoreMinimal.h>
+#include <Containers/Queue.h>
+#include <HAL/Runnable.h>
+#include <HAL/ThreadSafeBool.h>
+#include <HAL/ThreadSafeCounter.h>
+
+class FDaeTestReportWriter;
+class FRunnableThread;
+
+/**
+ * Writes test reports incrementally on a background thread, appending each test suite as soon as it has finished.
+ * Each report writer type is only used once per queue.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestReportWriterQueue : public FRunnable
+{
+public:
+    explicit FDaeTestReportWriterQueue(const FString& InReportPath);
+    virtual ~FDaeTestReportWriterQueue();
+
+    /** Starts a report with the specified writer, including all test suites appended so far, unless there already is a writer of the same type. */
+    void AddReportWriter(TSharedPtr<FDaeTestReportWriter> ReportWriter);
+
+    /** Appends the specified test suite to all reports. */
+    void AppendTestSuite(const FDaeTestSuiteResult& TestSuite);
+
+    /** Waits for all appended test suites to be written, and finishes all reports. */
+    void FinishReports();
+
+    /** Waits for all appended test suites to be written. */
+    void Flush();
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    /** Where to write test reports to. */
+    FString ReportPath;
+
+    /** Writers of all reports. Only accessed by the background thread through queued tasks. */
+    TArray<TSharedPtr<FDaeTestReportWriter>> ReportWriters;
+
+    /** All test suites appended so far. Never changed after being appended, to be safely read by the background thread. */
+    TIndirectArray<FDaeTestSuiteResult> TestSuites;
+
+    /** Work to do on the background thread, in order. */
+    TQueue<TFunction<void()>, EQueueMode::Spsc> Tasks;
+
+    /** Number of tasks that haven't been finished yet. */
+    FThreadSafeCounter NumPendingTasks;
+
+    /** Signaled whenever new tasks have been queued. */
+    FEvent* TasksQueuedEvent;
+
+    /** Whether the background thread is supposed to exit. */
+    FThreadSafeBool bStopping;
+
+    /** Thread writing the reports. */
+    FRunnableThread* Thread;
+
+    /** Queues the specified task for the background thread. */
+    void Enqueue(TFunction<void()>&& Task);
+};
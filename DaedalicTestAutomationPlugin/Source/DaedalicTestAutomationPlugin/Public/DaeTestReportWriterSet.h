@@ -1,6 +1,7 @@
 #pragma once
 
 #include <CoreMinimal.h>
+#include <Dom/JsonValue.h>
 
 class FDaeTestReportWriter;
 
@@ -17,6 +18,12 @@ public:
     /** Gets the report writers of this set. */
     TArray<TSharedPtr<FDaeTestReportWriter>> GetReportWriters() const;
 
+    /** Serializes the types of the report writers of this set to JSON, e.g. for sending them to other processes. */
+    TArray<TSharedPtr<FJsonValue>> ToJson() const;
+
+    /** Restores report writers from the specified JSON values. Only built-in report writers can be restored. */
+    static FDaeTestReportWriterSet FromJson(const TArray<TSharedPtr<FJsonValue>>& JsonValues);
+
 private:
     TArray<TSharedPtr<FDaeTestReportWriter>> ReportWriters;
 };
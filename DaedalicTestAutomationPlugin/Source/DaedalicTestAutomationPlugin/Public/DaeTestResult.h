@@ -33,4 +33,10 @@ public:
 
     /** Whether this test has been skipped instead of being run. */
     bool WasSkipped() const;
+
+    /** Serializes this result to JSON, e.g. for sending it to other processes. */
+    TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores a result from the specified JSON object. */
+    static FDaeTestResult FromJson(const TSharedRef<FJsonObject>& JsonObject);
 };
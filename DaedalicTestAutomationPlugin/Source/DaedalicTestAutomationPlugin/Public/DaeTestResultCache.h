@@ -0,0 +1,52 @@
+#pragma once
+
+#include "DaeTestCheckpoint.h"
+#include "DaeTestPackageDependencies.h"
+#include "DaeTestReportWriterSet.h"
+#include "DaeTestSuiteResult.h"
+#include <CoreMinimal.h>
+
+/**
+ * Remembers passing results of test maps in a local folder, one file per key, so that they can be reported again
+ * without loading the test map, as long as nothing they depend on has changed.
+ * Keys are hashes of the contents of all packages the test map depends on, the engine, build and plugin versions,
+ * and the console variables and commands applied by the plugin.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestResultCache
+{
+public:
+    /** Gets the path of the cache folder to use if none is specified. */
+    static FString GetDefaultDirectory();
+
+    /** Starts looking up and storing results in the specified folder. */
+    void Open(const FString& InDirectory);
+
+    /** Whether results are being looked up and stored. */
+    bool IsOpen() const;
+
+    /** Computes the key of the specified test map, based on its current contents. */
+    FString GetKey(const FName& MapName, const FName& PackageName);
+
+    /** Looks up the cached passing result for the specified key. */
+    bool Find(const FString& Key, FDaeTestCheckpointResult& OutResult) const;
+
+    /** Stores the specified result for the specified key, if all of its tests have passed. */
+    void Store(const FString& Key, const FDaeTestSuiteResult& Result,
+               const FDaeTestReportWriterSet& ReportWriters, float LoadTimeSeconds) const;
+
+private:
+    /** Folder results are stored in. */
+    FString Directory;
+
+    /** Hash of everything affecting all test maps, e.g. the build version. */
+    FString EnvironmentHash;
+
+    /** Resolves and hashes the packages test maps depend on. */
+    TUniquePtr<FDaeTestPackageDependencies> PackageDependencies;
+
+    /** Gets the file the result for the specified key is stored in. */
+    FString GetFilePath(const FString& Key) const;
+
+    /** Computes the hash of everything affecting all test maps. */
+    static FString ComputeEnvironmentHash();
+};
@@ -8,3 +8,14 @@ FName FDaeTestResultData::GetDataType() const
 {
     return TEXT("FDaeTestResultData");
 }
+
+TSharedRef<FJsonObject> FDaeTestResultData::ToJson() const
+{
+    TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+    JsonObject->SetStringField(TEXT("DataType"), GetDataType().ToString());
+    return JsonObject;
+}
+
+void FDaeTestResultData::FromJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+}
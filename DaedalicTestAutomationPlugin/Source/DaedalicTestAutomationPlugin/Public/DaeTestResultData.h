@@ -1,6 +1,7 @@
 #pragma once
 
 #include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
 
 /** Additional result data of a single test. */
 class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestResultData
@@ -10,4 +11,10 @@ public:
 
     /** Gets the name of the type of this data. Used to ensure safe type-casting. */
     virtual FName GetDataType() const;
+
+    /** Serializes this data to JSON, e.g. for sending it to other processes. */
+    virtual TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores this data from the specified JSON object. */
+    virtual void FromJson(const TSharedRef<FJsonObject>& JsonObject);
 };
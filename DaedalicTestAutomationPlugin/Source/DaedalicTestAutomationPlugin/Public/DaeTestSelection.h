@@ -0,0 +1,96 @@
+#pragma once
+
+#include "DaeTestMapInfo.h"
+#include "Settings/DaeTestMapMetaData.h"
+#include <CoreMinimal.h>
+
+/**
+ * Compiled expression for selecting test maps to run, e.g. tag:Smoke && !name:*Slow* || priority:High..
+ *
+ * Terms:
+ * - name:<glob> matches map names (e.g. name:Physics*)
+ * - path:<glob> matches long package names, including folders (e.g. path:/Game/Tests/Physics/*)
+ * - tag:<glob> matches maps with at least one matching tag
+ * - priority:<min>..<max> matches maps within the priority range, both ends being optional (e.g. priority:High..)
+ * - priority:<priority> matches maps with exactly that priority
+ *
+ * Terms can be combined with AND (&&), OR (||), NOT (!) and parentheses. Terms without operator in between are AND-ed.
+ * Values containing whitespace or special characters can be quoted (e.g. name:"My Test").
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestSelection
+{
+public:
+    /** Compiles the specified expression. An empty expression selects all test maps. */
+    bool Compile(const FString& Expression, FString& OutError);
+
+    /** Builds an expression for the legacy TestName, TestTags (separated by semicolons) and TestPriority options. */
+    static FString FromLegacyOptions(const FString& TestName, const FString& TestTags,
+                                     const FString& TestPriority);
+
+    /** Combines the specified expressions, requiring both to match. */
+    static FString CombineAnd(const FString& First, const FString& Second);
+
+    /** Checks whether the specified test map is selected. */
+    bool Matches(const FName& MapName, const FDaeTestMapInfo& MapInfo) const;
+
+    /** Converts the specified string (e.g. High or 2) to a priority. */
+    static bool ParsePriority(const FString& PriorityString, EDaeTestPriority& OutPriority);
+
+private:
+    /** Type of a node of a compiled expression. */
+    enum class ENodeType : uint8
+    {
+        And,
+        Or,
+        Not,
+        Name,
+        Path,
+        Tag,
+        Priority
+    };
+
+    /** Node of a compiled expression. */
+    struct FNode
+    {
+        ENodeType Type = ENodeType::And;
+
+        /** Operands of AND, OR and NOT. */
+        TArray<int32> Children;
+
+        /** Glob pattern of name, path and tag terms. */
+        FString Pattern;
+
+        /** Priority range of priority terms. */
+        EDaeTestPriority MinPriority = EDaeTestPriority::DTP_LowPriority;
+        EDaeTestPriority MaxPriority = EDaeTestPriority::DTP_CriticalPriority;
+    };
+
+    /** All nodes of the compiled expression. */
+    TArray<FNode> Nodes;
+
+    /** Index of the root node, or INDEX_NONE for selecting all test maps. */
+    int32 RootIndex = INDEX_NONE;
+
+    /** Tokens of the expression currently being compiled. */
+    TArray<FString> Tokens;
+
+    /** Index of the next token to compile. */
+    int32 TokenIndex = 0;
+
+    /** Error of the expression currently being compiled. */
+    FString Error;
+
+    static bool Tokenize(const FString& Expression, TArray<FString>& OutTokens, FString& OutError);
+
+    int32 ParseOr();
+    int32 ParseAnd();
+    int32 ParseNot();
+    int32 ParsePrimary();
+    int32 ParseTerm(const FString& Token);
+
+    int32 AddNode(ENodeType Type, const TArray<int32>& Children);
+    bool IsOperator(const FString& Token, const TCHAR* Symbol, const TCHAR* Keyword) const;
+    const FString* PeekToken() const;
+
+    bool Evaluate(int32 NodeIndex, const FName& MapName, const FDaeTestMapInfo& MapInfo) const;
+};
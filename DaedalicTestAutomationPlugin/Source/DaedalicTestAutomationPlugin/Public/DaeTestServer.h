@@ -0,0 +1,42 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Dom/JsonObject.h>
+
+class FDaeTestMessageChannel;
+class FSocket;
+
+/**
+ * Keeps the game process resident between test runs, accepting test run requests from local clients.
+ * Saves engine startup and test discovery for every run after the first one.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestServer
+{
+public:
+    /** Default local port to listen for requests on. */
+    static const int32 DefaultPort;
+
+    /** Message types exchanged between server and clients. */
+    static const FString MessageTypeRunTests;
+    static const FString MessageTypeTestsFinished;
+    static const FString MessageTypeShutdown;
+
+    FDaeTestServer();
+    ~FDaeTestServer();
+
+    /** Starts listening for clients on the specified local port. */
+    bool Start(int32 Port);
+
+    /** Accepts new clients, and gets their next request, if any, without blocking. */
+    TSharedPtr<FJsonObject> ReceiveRequest();
+
+    /** Sends the specified response to the client of the last request. */
+    void SendResponse(const TSharedRef<FJsonObject>& Response);
+
+private:
+    /** Socket to accept new clients with. */
+    FSocket* ListenSocket;
+
+    /** Client that has sent the last request. */
+    TSharedPtr<FDaeTestMessageChannel> Client;
+};
@@ -2,6 +2,7 @@
 
 #include "DaeTestReportWriterSet.h"
 #include "DaeTestSuiteResult.h"
+#include "DaeTestWorldSnapshot.h"
 #include <CoreMinimal.h>
 #include <GameFramework/Actor.h>
 #include "DaeTestSuiteActor.generated.h"
@@ -12,6 +13,21 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDaeTestSuiteActorTestSuiteSuccessfu
                                             ADaeTestSuiteActor*, TestSuite);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDaeTestSuiteActorTestSuiteFailedSignature,
                                             ADaeTestSuiteActor*, TestSuite);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FDaeTestSuiteActorTestStartedSignature,
+                                             ADaeTestSuiteActor*, TestSuite, ADaeTestActor*, Test);
+
+/** Single run of a test with one of its parameters. */
+struct FDaeTestSuiteActorTestRun
+{
+    /** Test being run. */
+    ADaeTestActor* Test = nullptr;
+
+    /** Index of the parameter the test is run with. */
+    int32 ParameterIndex = 0;
+
+    /** Time the test has been running, in seconds. */
+    float TimeSeconds = 0.0f;
+};
 
 /** Collection of automated tests. */
 UCLASS()
@@ -25,13 +41,13 @@ public:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaSeconds) override;
 
-    /** Runs all tests of this suite, in order. */
+    /** Runs all tests of this suite, in order. Independent tests may run at the same time. */
     void RunAllTests();
 
     /** Whether this test suite is currently running. */
     bool IsRunning() const;
 
-    /** Gets the test that is currently running. */
+    /** Gets the test that has most recently been started or finished, e.g. while notifying BeforeEach or AfterEach. */
     ADaeTestActor* GetCurrentTest() const;
 
     /** Gets the parameter for the current test run. */
@@ -40,12 +56,21 @@ public:
     /** Gets the name of the current test. */
     FString GetCurrentTestName() const;
 
+    /** Gets the longest time any running test is still allowed to run before it times out, in seconds. */
+    float GetRemainingTimeoutSeconds() const;
+
     /** Results of the whole test suite. */
     const FDaeTestSuiteResult& GetResult() const;
 
     /** Gets report writers for all tests of this suite. */
     FDaeTestReportWriterSet GetReportWriters() const;
 
+    /** Gets all tests to run in this level. */
+    const TArray<ADaeTestActor*>& GetTests() const;
+
+    /** Adds the specified test to run, e.g. for test suites spawned at runtime. */
+    void AddTest(ADaeTestActor* Test);
+
     /** Event when this test suite should set up. */
     virtual void NotifyOnBeforeAll();
 
@@ -80,6 +105,9 @@ public:
     /** Event when any tests of this test suite have failed. */
     FDaeTestSuiteActorTestSuiteFailedSignature OnTestSuiteFailed;
 
+    /** Event when the next test (or test parameter) of this test suite is about to run. */
+    FDaeTestSuiteActorTestStartedSignature OnTestStarted;
+
 private:
     /** Tests to run in this level. */
     UPROPERTY(EditInstanceOnly)
@@ -89,21 +117,58 @@ private:
     UPROPERTY(EditInstanceOnly)
     bool bRunInPIE;
 
-    /** Index of the current test. */
+    /** How many independent tests are allowed to run at the same time. Tests that aren't independent always run on their own. */
+    UPROPERTY(EditInstanceOnly, meta = (ClampMin = 1))
+    int32 MaxConcurrentTests;
+
+    /** Whether to capture the state of all actors before each test, and restore it after each test, allowing tests to modify
+     * the level (e.g. move or destroy actors) without affecting other tests. Independent tests running at the same time share
+     * the same snapshot, captured before the first of them and restored after the last of them. */
+    UPROPERTY(EditInstanceOnly)
+    bool bRestoreWorldStateAfterEachTest;
+
+    /** Index of the test that has been started last. */
     int32 TestIndex;
 
-    /** Index of the current parameter the current test is run with. */
+    /** Index of the parameter the test that has been started last is run with. */
     int32 TestParameterIndex;
 
-    /** Time the current test has been running, in seconds. */
-    float TestTimeSeconds;
+    /** Tests that are currently running. */
+    TArray<FDaeTestSuiteActorTestRun> RunningTests;
+
+    /** Test run that has most recently been started or finished. */
+    FDaeTestSuiteActorTestRun CurrentTestRun;
+
+    /** Whether tests are currently being started, to prevent tests that finish immediately from starting further tests. */
+    bool bIsStartingTests;
+
+    /** State of the world before the running tests have started, if restoring world state after each test. */
+    FDaeTestWorldSnapshot WorldSnapshot;
 
     /** Results of the whole test suite. */
     FDaeTestSuiteResult Result;
 
-    /** Runs the next test in this test suite. */
+    /** Restores the world state captured before the running tests, if enabled and all of them have finished. */
+    void RestoreWorldState();
+
+    /** Starts as many of the next tests in this test suite as allowed, and checks whether all tests have finished. */
     void RunNextTest();
 
+    /** Whether the next test can be started right now, considering the tests that are already running. */
+    bool CanStartNextTest() const;
+
+    /** Starts the specified test with the specified parameter. */
+    void StartTest(ADaeTestActor* Test, int32 ParameterIndex);
+
+    /** Stops tracking the specified running test and stores its result. Returns false if the test isn't running. */
+    bool FinishTest(ADaeTestActor* Test, FDaeTestResult& OutTestResult);
+
+    /** Gets the parameter for the specified test run. */
+    UObject* GetTestParameter(const ADaeTestActor* Test, int32 ParameterIndex) const;
+
+    /** Gets the name of the specified test run. */
+    FString GetTestName(const ADaeTestActor* Test, int32 ParameterIndex) const;
+
     UFUNCTION()
     void OnTestSuccessful(ADaeTestActor* Test, UObject* Parameter);
 
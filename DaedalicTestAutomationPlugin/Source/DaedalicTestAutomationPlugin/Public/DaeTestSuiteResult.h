@@ -18,6 +18,9 @@ public:
     /** Results of all individual tests of the test suite. */
     TArray<FDaeTestResult> TestResults;
 
+    /** Whether this result has been restored from the result cache, instead of running the tests again. */
+    bool bFromCache = false;
+
     /** How many tests of the test suite have been run. */
     int32 NumTotalTests() const;
 
@@ -32,4 +35,10 @@ public:
 
     /** Combined time all tests ran, in seconds. */
     float GetTotalTimeSeconds() const;
+
+    /** Serializes this result to JSON, e.g. for sending it to other processes. */
+    TSharedRef<FJsonObject> ToJson() const;
+
+    /** Restores a result from the specified JSON object. */
+    static FDaeTestSuiteResult FromJson(const TSharedRef<FJsonObject>& JsonObject);
 };
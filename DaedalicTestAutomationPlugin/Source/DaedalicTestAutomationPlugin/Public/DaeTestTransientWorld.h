@@ -0,0 +1,52 @@
+#pragma once
+
+#include "DaeTestMapInfo.h"
+#include "DaeTestReportWriterSet.h"
+#include "DaeTestSuiteResult.h"
+#include <CoreMinimal.h>
+
+class ADaeTestActor;
+class UWorld;
+
+/**
+ * Runs tests that don't need any map in a minimal transient world, instead of traveling to a test map.
+ * Spawns one instance of each of the Transient World Tests of the plugin settings, runs them as a single test suite
+ * by ticking the world as fast as possible, and tears the world down afterwards.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestTransientWorld
+{
+public:
+    /** Name the tests of the transient world are selected and reported by, just like a test map. */
+    static const FName MapName;
+
+    /** Whether any tests to run in a transient world have been set up. */
+    static bool HasTests();
+
+    /** Gets information about the tests of the transient world, e.g. their combined tags, for selecting them. */
+    static FDaeTestMapInfo GetMapInfo();
+
+    /** Creates the transient world, runs all of its tests and destroys it again. */
+    void Run();
+
+    /** Gets the results of all tests of the transient world, after running them. */
+    const FDaeTestSuiteResult& GetResult() const;
+
+    /** Gets report writers for all tests of the transient world, after running them. */
+    const FDaeTestReportWriterSet& GetReportWriters() const;
+
+private:
+    /** Results of all tests of the transient world. */
+    FDaeTestSuiteResult Result;
+
+    /** Report writers for all tests of the transient world. */
+    FDaeTestReportWriterSet ReportWriters;
+
+    /** Loads the classes of all tests to run in the transient world. */
+    static TArray<UClass*> LoadTestClasses();
+
+    /** Creates a transient world and begins play in it. */
+    static UWorld* CreateWorld();
+
+    /** Destroys the specified transient world. */
+    static void DestroyWorld(UWorld* World);
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <HAL/Runnable.h>
+#include <HAL/ThreadSafeBool.h>
+#include <HAL/ThreadSafeCounter64.h>
+
+class FRunnableThread;
+
+/**
+ * Watches the progress of tests on a background thread, exiting the process if any test doesn't finish
+ * in time, even if the game thread doesn't respond at all anymore.
+ * Only checks wall-clock deadlines set whenever a test or map starts, or a heartbeat timestamp updated without any locks,
+ * so it adds hardly any per-frame overhead.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestWatchdog : public FRunnable
+{
+public:
+    /** Exit code of the process if the watchdog has tripped. */
+    static const uint8 ExitCode;
+
+    explicit FDaeTestWatchdog(float InGraceSeconds);
+    virtual ~FDaeTestWatchdog();
+
+    /** Trips the watchdog if it isn't armed again or disarmed within the specified time, plus grace period. */
+    void Arm(const FString& InDescription, float TimeoutSeconds);
+
+    /** Trips the watchdog if Heartbeat isn't called for longer than the grace period, until armed again or disarmed. */
+    void ArmHeartbeat(const FString& InDescription);
+
+    /** Tells the watchdog that frames are still being processed. Doesn't lock, so it can be called every frame. */
+    void Heartbeat();
+
+    /** Stops watching until armed again. */
+    void Disarm();
+
+    /** Sets the record to write to the specified file if the watchdog trips. Has to be serialized in advance, as the game thread might be blocked by then. */
+    void SetFailureRecord(const FString& InFailureRecordPath, const FString& InFailureRecord);
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    /** Additional time to wait after each deadline, in seconds. */
+    float GraceSeconds;
+
+    /** Real time the watchdog trips at, in seconds. Zero if disarmed. */
+    double DeadlineSeconds;
+
+    /** Whether to trip if there hasn't been any heartbeat for longer than the grace period, instead of at the deadline. */
+    bool bWatchHeartbeat;
+
+    /** Time of the last heartbeat, in platform cycles. */
+    FThreadSafeCounter64 HeartbeatCycles;
+
+    /** What's currently being watched, e.g. map and test name. */
+    FString Description;
+
+    /** Where to write the failure record to if the watchdog trips. */
+    FString FailureRecordPath;
+
+    /** Serialized failure record to write if the watchdog trips. */
+    FString FailureRecord;
+
+    /** Guards deadline, description and failure record. */
+    FCriticalSection CriticalSection;
+
+    /** Signaled to wake up the watchdog thread for exiting. */
+    FEvent* StopEvent;
+
+    /** Whether the watchdog thread is supposed to exit. */
+    FThreadSafeBool bStopping;
+
+    /** Thread checking the deadline. */
+    FRunnableThread* Thread;
+
+    /** Dumps callstacks, writes the failure record and exits. */
+    void Trip(const FString& TrippedDescription, const FString& TrippedFailureRecordPath,
+              const FString& TrippedFailureRecord);
+
+    /** Writes the callstacks of all known threads to the log. */
+    void LogThreadCallstacks() const;
+};
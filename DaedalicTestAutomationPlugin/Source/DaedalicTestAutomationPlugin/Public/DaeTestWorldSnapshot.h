@@ -0,0 +1,76 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/WeakObjectPtr.h>
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/** Serialized state of a single actor of a world snapshot. */
+struct DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestWorldSnapshotActor
+{
+    /** Actor the state has been captured from. */
+    TWeakObjectPtr<AActor> Actor;
+
+    /** Class of the actor, for respawning it after it has been destroyed. */
+    TWeakObjectPtr<UClass> Class;
+
+    /** Name of the actor, for respawning it under the same name, keeping references to it intact. */
+    FName Name;
+
+    /** Level the actor has been placed in. */
+    TWeakObjectPtr<ULevel> Level;
+
+    /** Transform of the actor. */
+    FTransform Transform;
+
+    /** Serialized properties of the actor. */
+    TArray<uint8> Data;
+
+    /** Serialized properties of the components of the actor, by component name. */
+    TMap<FName, TArray<uint8>> ComponentData;
+};
+
+/**
+ * Serialized state of the actors of a world, for restoring it after a test has modified it (e.g. moved or destroyed actors),
+ * without reloading the whole map. Tests, test suites, players and world info actors (e.g. game mode) are left untouched.
+ * Components added to single actor instances are not restored when respawning destroyed actors.
+ */
+class DAEDALICTESTAUTOMATIONPLUGIN_API FDaeTestWorldSnapshot
+{
+public:
+    /** Captures the state of all relevant actors of the specified world. */
+    void Capture(UWorld* World);
+
+    /** Destroys all relevant actors spawned since capturing, respawns destroyed ones and restores the state of all captured actors. */
+    void Restore();
+
+    /** Whether any state has been captured. */
+    bool IsValid() const;
+
+    /** Discards the captured state. */
+    void Reset();
+
+private:
+    /** World the state has been captured from. */
+    TWeakObjectPtr<UWorld> World;
+
+    /** State of all relevant actors at the time of capturing. */
+    TArray<FDaeTestWorldSnapshotActor> Actors;
+
+    /** All actors that existed at the time of capturing, relevant or not. */
+    TSet<TWeakObjectPtr<AActor>> ExistingActors;
+
+    /** Whether the specified actor is affected by capturing and restoring world state. */
+    static bool IsRelevantActor(const AActor* Actor);
+
+    /** Serializes all properties of the specified object. */
+    static void SerializeObject(UObject* Object, TArray<uint8>& OutData);
+
+    /** Restores all properties of the specified object. */
+    static void DeserializeObject(UObject* Object, const TArray<uint8>& Data);
+
+    /** Spawns a new actor for the specified snapshot of an actor that has been destroyed. */
+    static AActor* RespawnActor(UWorld* World, const FDaeTestWorldSnapshotActor& SnapshotActor);
+};
@@ -6,6 +6,8 @@
 #include <UObject/Object.h>
 #include "DaeTestAutomationPluginSettings.generated.h"
 
+class ADaeTestActor;
+
 DECLARE_MULTICAST_DELEGATE(FDaeTestAutomationPluginSettingsTestMapsChangedSignature);
 
 /** Custom settings for this plugin. */
@@ -39,6 +41,10 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "General")
     TArray<FString> ConsoleCommands = {"Log LogLinker Off", "Log LogUObjectGlobals Off"};
 
+    /** Tests that don't need any map, run in a minimal transient world instead (e.g. for testing game logic with a few spawned actors). */
+    UPROPERTY(config, EditAnywhere, Category = "General")
+    TArray<TSoftClassPtr<ADaeTestActor>> TransientWorldTests;
+
 	/** Additional information about test maps. */
 	UPROPERTY(config)
 	TMap<FString, FDaeTestMapMetaData> TestMapsMetaData;
@@ -51,9 +57,35 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Global Settings")
 	FDaeTestMapSettings GlobalTestMapSettings;
 
+    /** Expected duration of test maps that have never been run before, in seconds. Used for balancing shards in Gauntlet. */
+    UPROPERTY(config, EditAnywhere, Category = "Gauntlet", meta = (ClampMin = 0))
+    float DefaultMapDurationSeconds = 30.0f;
+
+    /** Test maps are allowed to run this many times longer than their last run before failing in Gauntlet. Zero disables map timeouts. */
+    UPROPERTY(config, EditAnywhere, Category = "Gauntlet", meta = (ClampMin = 0))
+    float MapTimeoutFactor = 3.0f;
+
+    /** Minimum time test maps are allowed to run before failing in Gauntlet, in seconds. */
+    UPROPERTY(config, EditAnywhere, Category = "Gauntlet", meta = (ClampMin = 0))
+    float MinMapTimeoutSeconds = 300.0f;
+
+    /** Time tests are allowed to exceed their timeout in Gauntlet before assuming the game thread to be hung and exiting the process, in seconds. Zero disables this watchdog. */
+    UPROPERTY(config, EditAnywhere, Category = "Gauntlet", meta = (ClampMin = 0))
+    float WatchdogGraceSeconds = 60.0f;
+
+    /** Fixed timestep to simulate test maps with accelerated simulation with in Gauntlet, in seconds. */
+    UPROPERTY(config, EditAnywhere, Category = "Gauntlet", meta = (ClampMin = 0.001))
+    float AcceleratedSimulationDeltaSeconds = 1.0f / 30.0f;
+
+    /** Maximum additional memory to use for loading the next test map in the background while the current one is running in Gauntlet, in MB. Zero disables prefetching. */
+    UPROPERTY(config, EditAnywhere, Category = "Gauntlet", meta = (ClampMin = 0))
+    int32 PrefetchMemoryBudgetMB = 1024;
+
+    /** Maximum number of performance capture files to keep in Saved/DaedalicTestAutomationPlugin/PerformanceCaptures, deleting the oldest ones first. Zero keeps all of them. */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = 0))
+    int32 MaxPerformanceCaptures = 20;
+
     UDaeTestAutomationPluginSettings();
-	
-	static void SetTestMetaData(const AActor* TestActor, const FDaeTestMapMetaData& TestMetaData);
 
     virtual void PostInitProperties() override;
 
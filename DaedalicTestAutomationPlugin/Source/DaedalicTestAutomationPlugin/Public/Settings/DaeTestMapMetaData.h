@@ -59,4 +59,18 @@ struct FDaeTestMapMetaData
 	/** Errors to be expected while processing this test. */
 	UPROPERTY(EditAnywhere)
 	TArray<FDaeTestExpectedError> ExpectedErrors;
+
+	/** Whether the map of this test always has to be loaded as its own world (e.g. because it relies on its game mode or world settings),
+	 * instead of being streamed into a shared persistent world when running tests in batches. */
+	UPROPERTY(EditAnywhere)
+	bool bRequiresFullTravel = false;
+
+	/** Whether to run the tests of this map in Gauntlet with a fixed timestep and an uncapped frame rate, advancing game time as fast as
+	 * possible instead of in real time. Tests and their timeouts measure game time in that case. */
+	UPROPERTY(EditAnywhere)
+	bool bAcceleratedSimulation = false;
+
+	/** Global time dilation to apply while running the tests of this map with accelerated simulation. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "bAcceleratedSimulation", ClampMin = 0.0001, ClampMax = 20))
+	float SimulationTimeDilation = 1.0f;
 };
@@ -1,43 +1,30 @@
 #include "AutomationTestFramework/DaeTestAutomationPluginAutomationTestFrameworkIntegration.h"
 #include "DaeTestEditorLogCategory.h"
-#include "Settings/DaeTestAutomationPluginSettings.h"
-#include <FileHelpers.h>
+#include "DaeTestMapDiscovery.h"
 #include <Misc/PackageName.h>
 #include <Misc/Paths.h>
 
 void FDaeTestAutomationPluginAutomationTestFrameworkIntegration::DiscoverTests()
 {
-    const UDaeTestAutomationPluginSettings* TestAutomationPluginSettings =
-        GetDefault<UDaeTestAutomationPluginSettings>();
-
-    for (const FString& TestMapFolder : TestAutomationPluginSettings->TestMapFolders)
-    {
-        UE_LOG(LogDaeTestEditor, Log, TEXT("Discovering tests from: %s"), *TestMapFolder);
-    }
-
     // Unregister existing tests.
     Tests.Empty();
 
-    // Register new tests (based on FLoadAllMapsInEditorTest).
-    TArray<FString> PackageFiles;
-    FEditorFileUtils::FindAllPackageFiles(PackageFiles);
+    // Find test maps along with their meta data, without loading any maps. The editor keeps the
+    // asset registry up-to-date, so there's no need for a discovery manifest here.
+    FDaeTestMapDiscovery Discovery;
+    Discovery.Discover(FString());
 
-    // Iterate over all files, adding the ones with the map extension.
-    for (const FString& FileName : PackageFiles)
+    for (const FName& MapName : Discovery.GetMapNames())
     {
-        const bool bIsMap = FPaths::GetExtension(FileName, true)
-                            == FPackageName::GetMapPackageExtension();
-        FName MapName = FName(*FPaths::GetBaseFilename(FileName));
+        const FDaeTestMapInfo& MapInfo = Discovery.GetMapInfos()[MapName];
+        const FString FileName =
+            FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(
+                MapInfo.PackageName.ToString(), FPackageName::GetMapPackageExtension()));
 
-        if (bIsMap && TestAutomationPluginSettings->IsTestMap(FileName, MapName))
-        {
-            const FDaeTestMapMetaData& MapMetaData =
-                TestAutomationPluginSettings->TestMapsMetaData.FindRef(MapName.ToString());
-            TSharedPtr<FDaeTestAutomationPluginAutomationTestFrameworkTest> NewTest = MakeShareable(
-                new FDaeTestAutomationPluginAutomationTestFrameworkTest(FileName, MapMetaData));
-            Tests.Add(NewTest);
+        TSharedPtr<FDaeTestAutomationPluginAutomationTestFrameworkTest> NewTest = MakeShareable(
+            new FDaeTestAutomationPluginAutomationTestFrameworkTest(FileName, MapInfo.MetaData));
+        Tests.Add(NewTest);
 
-            UE_LOG(LogDaeTestEditor, Log, TEXT("Discovered test: %s"), *NewTest->GetMapName());
-        }
+        UE_LOG(LogDaeTestEditor, Log, TEXT("Discovered test: %s"), *NewTest->GetMapName());
     }
 }
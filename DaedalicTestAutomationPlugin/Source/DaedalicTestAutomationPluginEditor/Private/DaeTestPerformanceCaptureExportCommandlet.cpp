@@ -0,0 +1,100 @@
+#include "DaeTestPerformanceCaptureExportCommandlet.h"
+#include "DaeTestEditorLogCategory.h"
+#include "DaeTestPerformanceCapture.h"
+#include <HAL/FileManager.h>
+#include <Misc/Paths.h>
+
+int32 UDaeTestPerformanceCaptureExportCommandlet::Main(const FString& Params)
+{
+    FString CapturePath;
+    FString OutputPath;
+
+    FParse::Value(*Params, TEXT("Capture="), CapturePath);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    if (CapturePath.IsEmpty() || OutputPath.IsEmpty())
+    {
+        UE_LOG(LogDaeTestEditor, Error,
+               TEXT("Usage: -run=DaeTestPerformanceCaptureExport -Capture=<path>.daeperf "
+                    "-Output=<path>.csv|.json"));
+        return 1;
+    }
+
+    const bool bJson =
+        FPaths::GetExtension(OutputPath).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+
+    FDaeTestPerformanceCaptureReader CaptureReader;
+
+    if (!CaptureReader.Open(CapturePath))
+    {
+        return 1;
+    }
+
+    TUniquePtr<FArchive> OutputFile(IFileManager::Get().CreateFileWriter(*OutputPath));
+
+    if (!OutputFile.IsValid())
+    {
+        UE_LOG(LogDaeTestEditor, Error, TEXT("Unable to create output file %s."), *OutputPath);
+        return 1;
+    }
+
+    // Write one line per sample, so that exporting doesn't need more memory than reading.
+    auto WriteLine = [&OutputFile](const FString& Line) {
+        const FTCHARToUTF8 Utf8Line(*(Line + LINE_TERMINATOR));
+        OutputFile->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+    };
+
+    WriteLine(bJson ? TEXT("[")
+                    : TEXT("TimeSeconds,LocationX,LocationY,LocationZ,TargetPointIndex,FrameTime,"
+                           "GameThreadTime,RenderThreadTime,GPUTime,UsedPhysicalMemory,"
+                           "UsedVirtualMemory,UObjectCount"));
+
+    int32 SampleCount = 0;
+
+    const bool bSuccess =
+        CaptureReader.ForEachSample([&](const FDaeTestPerformanceSample& Sample) {
+            if (bJson)
+            {
+                WriteLine(FString::Printf(
+                    TEXT("%s{\"TimeSeconds\":%f,\"Location\":[%.0f,%.0f,%.0f],"
+                         "\"TargetPointIndex\":%i,\"FrameTime\":%f,\"GameThreadTime\":%f,"
+                         "\"RenderThreadTime\":%f,\"GPUTime\":%f,\"UsedPhysicalMemory\":%f,"
+                         "\"UsedVirtualMemory\":%f,\"UObjectCount\":%i}"),
+                    SampleCount > 0 ? TEXT(",") : TEXT(""), Sample.TimeSeconds, Sample.Location.X,
+                    Sample.Location.Y, Sample.Location.Z, Sample.TargetPointIndex,
+                    Sample.FrameTime, Sample.GameThreadTime, Sample.RenderThreadTime,
+                    Sample.GPUTime, Sample.UsedPhysicalMemory, Sample.UsedVirtualMemory,
+                    Sample.UObjectCount));
+            }
+            else
+            {
+                WriteLine(FString::Printf(
+                    TEXT("%f,%.0f,%.0f,%.0f,%i,%f,%f,%f,%f,%f,%f,%i"), Sample.TimeSeconds,
+                    Sample.Location.X, Sample.Location.Y, Sample.Location.Z,
+                    Sample.TargetPointIndex, Sample.FrameTime, Sample.GameThreadTime,
+                    Sample.RenderThreadTime, Sample.GPUTime, Sample.UsedPhysicalMemory,
+                    Sample.UsedVirtualMemory, Sample.UObjectCount));
+            }
+
+            ++SampleCount;
+        });
+
+    if (bJson)
+    {
+        WriteLine(TEXT("]"));
+    }
+
+    OutputFile->Close();
+
+    if (!bSuccess)
+    {
+        UE_LOG(LogDaeTestEditor, Error, TEXT("Capture file %s is corrupt, exported %i samples."),
+               *CapturePath, SampleCount);
+        return 1;
+    }
+
+    UE_LOG(LogDaeTestEditor, Display, TEXT("Exported %i samples of %s to %s."), SampleCount,
+           *CapturePath, *OutputPath);
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include "AssetTypeActions_DaeTestActorBlueprint.h"
 #include "AssetTypeActions_DaeTestParameterProviderActorBlueprint.h"
 #include "AssetTypeActions_DaeTestSuiteActorBlueprint.h"
+#include "DaeTestMapInfo.h"
 #include "DaedalicTestAutomationPluginEditorClasses.h"
 #include "IDaedalicTestAutomationPluginEditor.h"
 #include "Settings/DaeTestAutomationPluginSettings.h"
@@ -33,6 +34,9 @@ private:
     /** Integration with the Unreal Automation Test Framework. */
     FDaeTestAutomationPluginAutomationTestFrameworkIntegration AutomationTestFrameworkIntegration;
 
+    /** Handle for adding test meta data to the asset registry tags of test maps. */
+    FDelegateHandle GetExtraObjectTagsHandle;
+
     void RegisterAssetTypeAction(class IAssetTools& AssetTools,
                                  TSharedRef<IAssetTypeActions> Action);
 
@@ -66,6 +70,10 @@ void FDaedalicTestAutomationPluginEditor::StartupModule()
             DaedalicTestAutomationAssetCategory));
     RegisterAssetTypeAction(AssetTools, TestParameterProviderActorBlueprintAction);
 
+    // Store test meta data with test maps, allowing to read it without loading the maps.
+    GetExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(
+        &FDaeTestMapInfo::GetWorldAssetRegistryTags);
+
     // Register settings.
     if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
     {
@@ -105,6 +113,9 @@ void FDaedalicTestAutomationPluginEditor::ShutdownModule()
 
     AssetTypeActions.Empty();
 
+    // Unregister asset registry tags.
+    UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(GetExtraObjectTagsHandle);
+
     // Unregister settings.
     if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
     {
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Commandlets/Commandlet.h>
+#include "DaeTestPerformanceCaptureExportCommandlet.generated.h"
+
+/**
+ * Exports the samples of a performance capture file to CSV or JSON, streaming them chunk by chunk.
+ * Usage: -run=DaeTestPerformanceCaptureExport -Capture=<path>.daeperf -Output=<path>.csv|.json
+ */
+UCLASS()
+class UDaeTestPerformanceCaptureExportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};